@@ -18,6 +18,11 @@ func play_explosion(pos: Vector3, pitch: float, vol: float):
 	players[player_id] = player
 	player_started_at[player_id] = Time.get_ticks_usec()
 
+## Batched play_explosion, one call per frame from the projectile manager
+func play_explosions(positions: PackedVector3Array, pitches: PackedFloat32Array, vols: PackedFloat32Array):
+	for i in positions.size():
+		play_explosion(positions[i], pitches[i], vols[i])
+
 func play_splash(pos: Vector3, pitch: float, vol: float):
 	var player: AudioStreamPlayer3D = _get_free_player()
 	player.stream = splash
@@ -0,0 +1,597 @@
+#ifndef BALLISTICS_CORE_H
+#define BALLISTICS_CORE_H
+
+#include <godot_cpp/core/math.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+#include <cmath>
+
+namespace godot {
+
+// Shared ballistics core used by ProjectilePhysics, ProjectilePhysicsWithDrag
+// and ProjectilePhysicsWithDragV2.
+//
+// A drag model describes the 2D trajectory in the firing plane (x = horizontal
+// distance along the azimuth, y = height relative to the muzzle) of a shell
+// launched at speed v0 with elevation theta (c = cos theta, s = sin theta).
+// Every model provides:
+//   x(c, t, v0), vx(c, t, v0), y(s, t, v0), vy(s, t, v0)
+//   time_from_x(x, c, v0)        time to cover horizontal distance x (NAN if unreachable)
+//   time_to_y(s, v0, target_y)   time the shell reaches target_y (NAN if never)
+//   dy_dtheta(theta, x, t, v0)   d/dtheta of y(time_from_x(x)) for Newton refinement
+//   g                            gravity magnitude used for the vacuum initial guess
+// BallisticSolver<Model> builds the inverse problems and the 3D API on top.
+
+// Drag-free ballistics (closed form everywhere)
+struct VacuumDrag {
+	double g;
+
+	explicit VacuumDrag(double p_g) : g(p_g) {}
+
+	double x(double c, double t, double v0) const { return v0 * c * t; }
+	double vx(double c, double /*t*/, double v0) const { return v0 * c; }
+	double y(double s, double t, double v0) const { return v0 * s * t - 0.5 * g * t * t; }
+	double vy(double s, double t, double v0) const { return v0 * s - g * t; }
+
+	double time_from_x(double p_x, double c, double v0) const {
+		double vx0 = v0 * c;
+		return vx0 > 0.0 ? p_x / vx0 : NAN;
+	}
+
+	double time_to_y(double s, double v0, double target_y) const {
+		double vy0 = v0 * s;
+		double disc = vy0 * vy0 - 2.0 * g * target_y;
+		if (disc < 0.0) {
+			return NAN;
+		}
+		return (vy0 + std::sqrt(disc)) / g;
+	}
+
+	double dy_dtheta(double theta, double p_x, double /*t*/, double v0) const {
+		// y(θ) = x·tan(θ) - g·x²/(2·v0²·cos²(θ))
+		double c = std::cos(theta);
+		double s = std::sin(theta);
+		return p_x / (c * c) - g * p_x * p_x * s / (v0 * v0 * c * c * c);
+	}
+};
+
+// Linear (Stokes) drag: dv/dt = -β·v - g·ŷ (legacy ProjectilePhysicsWithDrag model)
+struct LinearDrag {
+	double g;
+	double beta;
+
+	// Fraction of the asymptotic horizontal range beyond which the
+	// shell is considered to have stalled (matches the legacy solver)
+	static constexpr double MAX_DRAG_FACTOR = 0.99;
+
+	LinearDrag(double p_g, double p_beta) : g(p_g), beta(p_beta) {}
+
+	double x(double c, double t, double v0) const {
+		return v0 * c * (1.0 - std::exp(-beta * t)) / beta;
+	}
+
+	double vx(double c, double t, double v0) const {
+		return v0 * c * std::exp(-beta * t);
+	}
+
+	double y(double s, double t, double v0) const {
+		// y = (v0y + g/β)(1 - e^(-βt))/β - (g/β)t
+		double decay = 1.0 - std::exp(-beta * t);
+		return (v0 * s + g / beta) * decay / beta - (g / beta) * t;
+	}
+
+	double vy(double s, double t, double v0) const {
+		return (v0 * s + g / beta) * std::exp(-beta * t) - g / beta;
+	}
+
+	double time_from_x(double p_x, double c, double v0) const {
+		double vx0 = v0 * c;
+		if (vx0 <= 0.0) {
+			return NAN;
+		}
+		double drag_factor = beta * p_x / vx0;
+		if (drag_factor >= MAX_DRAG_FACTOR) {
+			return NAN;
+		}
+		return -std::log(1.0 - drag_factor) / beta;
+	}
+
+	double time_to_y(double s, double v0, double target_y) const {
+		// Drag only lowers the trajectory, so the vacuum crossing is an upper
+		// bound; y(t) is concave, so Newton from there converges monotonically.
+		double vy0 = v0 * s;
+		double disc = vy0 * vy0 - 2.0 * g * target_y;
+		if (disc < 0.0) {
+			return NAN;
+		}
+		double t = (vy0 + std::sqrt(disc)) / g;
+		for (int i = 0; i < 8; i++) {
+			double f_val = y(s, t, v0) - target_y;
+			double f_prime = vy(s, t, v0);
+			if (std::abs(f_prime) < 1e-10) {
+				break;
+			}
+			double step = f_val / f_prime;
+			t -= step;
+			if (std::abs(step) < 1e-7) {
+				break;
+			}
+		}
+		return t > 0.0 ? t : NAN;
+	}
+
+	double dy_dtheta(double theta, double p_x, double t, double v0) const {
+		double c = std::cos(theta);
+		double s = std::sin(theta);
+		double drag_factor = beta * p_x / (v0 * c);
+
+		// dt/dθ from t = -ln(1 - βx/(v0·cos θ))/β
+		double dt_dtheta = p_x * s / (v0 * c * c * (1.0 - drag_factor));
+		// ∂y/∂θ at fixed t
+		double dy_dtheta_t = v0 * c * (1.0 - std::exp(-beta * t)) / beta;
+
+		return dy_dtheta_t + vy(s, t, v0) * dt_dtheta;
+	}
+};
+
+// Analytical quadratic drag (ProjectilePhysicsWithDragV2 model).
+// Horizontal motion uses an effective drag of β/√cos θ, vertical motion the
+// tan/atan (ascending) and tanh/atanh (descending) closed forms.
+struct QuadraticDrag {
+	double g;
+	double beta;
+	double vt;
+	double tau;
+
+	QuadraticDrag(double p_g, double p_beta, double p_vt, double p_tau)
+		: g(p_g), beta(p_beta), vt(p_vt), tau(p_tau) {}
+
+	static double acosh(double p_x) {
+		return std::log(p_x + std::sqrt(p_x * p_x - 1.0));
+	}
+
+	double x(double c, double t, double v0) const {
+		double vx0 = v0 * c;
+		double beta_eff = beta / std::sqrt(c);
+		return std::log(1.0 + beta_eff * vx0 * t) / beta_eff;
+	}
+
+	double vx(double c, double t, double v0) const {
+		double vx0 = v0 * c;
+		double beta_eff = beta / std::sqrt(c);
+		return vx0 / (1.0 + beta_eff * vx0 * t);
+	}
+
+	double y(double s, double t, double v0) const {
+		double vy0 = v0 * s;
+
+		if (vy0 >= 0.0) {
+			// Upward or horizontal: tan/atan formulation
+			double phi0 = std::atan(vy0 / vt);
+			double t_apex = tau * phi0;
+
+			if (t <= t_apex) {
+				double phi = phi0 - t / tau;
+				return tau * vt * std::log(std::cos(phi) / std::cos(phi0));
+			}
+			double y_apex = tau * vt * std::log(1.0 / std::cos(phi0));
+			double dt = t - t_apex;
+			return y_apex - tau * vt * std::log(std::cosh(dt / tau));
+		}
+
+		// Downward: tanh/atanh formulation
+		double ratio = vy0 / vt; // Negative, |ratio| < 1 for subsonic
+		if (ratio > -1.0) {
+			double psi0 = std::atanh(ratio);
+			double psi = psi0 - t / tau;
+			return tau * vt * std::log(std::cosh(psi0) / std::cosh(psi));
+		}
+		// Supersonic downward - quickly approaches terminal velocity
+		double v_avg = (vy0 - vt) * 0.5;
+		return v_avg * t;
+	}
+
+	double vy(double s, double t, double v0) const {
+		double vy0 = v0 * s;
+
+		if (vy0 >= 0.0) {
+			double phi0 = std::atan(vy0 / vt);
+			double t_apex = tau * phi0;
+
+			if (t <= t_apex) {
+				return vt * std::tan(phi0 - t / tau);
+			}
+			double dt = t - t_apex;
+			return -vt * std::tanh(dt / tau);
+		}
+
+		double ratio = vy0 / vt;
+		if (ratio > -1.0) {
+			double psi0 = std::atanh(ratio);
+			return vt * std::tanh(psi0 - t / tau);
+		}
+		return -vt;
+	}
+
+	double time_from_x(double p_x, double c, double v0) const {
+		double vx0 = v0 * c;
+		double beta_eff = beta / std::sqrt(c);
+		return (std::exp(beta_eff * p_x) - 1.0) / (beta_eff * vx0);
+	}
+
+	double time_to_y(double s, double v0, double target_y) const {
+		double vy0 = v0 * s;
+
+		if (vy0 >= 0.0) {
+			double phi0 = std::atan(vy0 / vt);
+			double t_apex = tau * phi0;
+			double y_apex = tau * vt * std::log(1.0 / std::cos(phi0));
+
+			if (target_y >= y_apex) {
+				double cos_phi = std::cos(phi0) * std::exp(target_y / (tau * vt));
+				if (cos_phi > 1.0) {
+					return NAN;
+				}
+				return tau * (phi0 - std::acos(cos_phi));
+			}
+
+			double arg = std::exp((y_apex - target_y) / (tau * vt));
+			return t_apex + tau * acosh(arg);
+		}
+
+		if (target_y > 0.0) {
+			return NAN;
+		}
+
+		double ratio = vy0 / vt;
+		if (ratio > -1.0) {
+			double psi0 = std::atanh(ratio);
+			double arg = std::cosh(psi0) * std::exp(-target_y / (tau * vt));
+			return tau * (psi0 + acosh(arg));
+		}
+		return -target_y / vt;
+	}
+
+	double dy_dtheta(double theta, double p_x, double t, double v0) const {
+		double c = std::cos(theta);
+		double s = std::sin(theta);
+
+		// dy/dθ = ∂y/∂s · cos(θ) + ∂y/∂t · dt/dθ
+		return dy_ds(s, t, v0) * c + vy(s, t, v0) * dt_dtheta(p_x, theta, v0);
+	}
+
+private:
+	double dt_dtheta(double p_x, double theta, double v0) const {
+		double c = std::cos(theta);
+		double s = std::sin(theta);
+		double sqrt_c = std::sqrt(c);
+		double beta_eff = beta / sqrt_c;
+		double vx0 = v0 * c;
+
+		double u = beta_eff * p_x;
+		double exp_u = std::exp(u);
+		double w = beta_eff * vx0;
+
+		// du/dθ = β·x·tan(θ) / (2c)
+		double du_dtheta = beta * p_x * s / (2.0 * c * sqrt_c);
+
+		// dw/dθ = -β·v0·tan(θ) / (2√c)
+		double dw_dtheta = -beta * v0 * s / (2.0 * sqrt_c);
+
+		return (exp_u * du_dtheta * w - (exp_u - 1.0) * dw_dtheta) / (w * w);
+	}
+
+	double dy_ds(double s, double t, double v0) const {
+		double vy0 = v0 * s;
+
+		if (vy0 >= 0.0) {
+			double phi0 = std::atan(vy0 / vt);
+			double t_apex = tau * phi0;
+			double dphi0_ds = v0 * vt / (vt * vt + vy0 * vy0);
+
+			if (t <= t_apex) {
+				double phi = phi0 - t / tau;
+				return tau * vt * dphi0_ds * (std::tan(phi0) - std::tan(phi));
+			}
+			double dt = t - t_apex;
+			double dy_apex_ds = tau * vt * std::tan(phi0) * dphi0_ds;
+			double dcosh_term_ds = std::tanh(dt / tau) * (-dphi0_ds);
+			return dy_apex_ds - tau * vt * dcosh_term_ds;
+		}
+
+		double ratio = vy0 / vt;
+		if (ratio > -1.0) {
+			double psi0 = std::atanh(ratio);
+			double dpsi0_ds = v0 / vt / (1.0 - ratio * ratio);
+			double psi = psi0 - t / tau;
+			return tau * vt * dpsi0_ds * (std::tanh(psi0) - std::tanh(psi));
+		}
+		return t * 0.5;
+	}
+};
+
+// Solver framework shared by every drag model. All methods are static and
+// allocation-free; the Godot-facing classes only unpack ShellParams and
+// pack the results into Variants.
+template <typename Model>
+class BallisticSolver {
+public:
+	static constexpr double PI = 3.14159265358979323846;
+	static constexpr double MAX_ELEVATION = PI / 2.0 - 0.001;
+
+	//==========================================================================
+	// 2D inverse problem
+	//==========================================================================
+
+	/// Drag-free elevation to hit (x, y); seeds the Newton refinement
+	static double vacuum_angle(const Model &model, double p_x, double p_y, double v0, bool high_arc) {
+		double A = model.g * p_x * p_x / (2.0 * v0 * v0);
+		double disc = p_x * p_x - 4.0 * A * (A + p_y);
+
+		if (disc < 0.0) {
+			return NAN;
+		}
+
+		double sqrt_disc = std::sqrt(disc);
+		double tan_theta = high_arc ? (p_x + sqrt_disc) / (2.0 * A) : (p_x - sqrt_disc) / (2.0 * A);
+		return std::atan(tan_theta);
+	}
+
+	/// Newton iteration on y(theta) at fixed horizontal distance
+	static double refine_angle(const Model &model, double theta, double target_x, double target_y,
+			double v0, int max_iter) {
+		for (int i = 0; i < max_iter; i++) {
+			double c = std::cos(theta);
+			double s = std::sin(theta);
+
+			double t = model.time_from_x(target_x, c, v0);
+			if (std::isnan(t)) {
+				break;
+			}
+			double error = model.y(s, t, v0) - target_y;
+			if (std::abs(error) < 1e-6) {
+				break;
+			}
+
+			double dy_dtheta = model.dy_dtheta(theta, target_x, t, v0);
+			if (std::abs(dy_dtheta) < 1e-10) {
+				break;
+			}
+
+			theta -= error / dy_dtheta;
+			theta = Math::clamp(theta, -MAX_ELEVATION, MAX_ELEVATION);
+		}
+		return theta;
+	}
+
+	/// Elevation and flight time to hit (target_x, target_y).
+	/// Returns false if the target is out of reach.
+	static bool firing_solution(const Model &model, double target_x, double target_y, double v0,
+			bool high_arc, int refine_iterations, double &out_theta, double &out_time) {
+		if (target_x <= 0.0) {
+			return false;
+		}
+
+		double theta = vacuum_angle(model, target_x, target_y, v0, high_arc);
+		if (std::isnan(theta)) {
+			return false;
+		}
+
+		theta = refine_angle(model, theta, target_x, target_y, v0, refine_iterations);
+
+		double t = model.time_from_x(target_x, std::cos(theta), v0);
+		if (std::isnan(t)) {
+			return false;
+		}
+
+		out_theta = theta;
+		out_time = t;
+		return true;
+	}
+
+	/// Horizontal distance covered when the shell returns to muzzle height.
+	/// Elevations at or past vertical come straight back: 0.
+	static double range_at_angle(const Model &model, double theta, double v0) {
+		if (theta >= PI / 2.0) {
+			return 0.0;
+		}
+		double t = model.time_to_y(std::sin(theta), v0, 0.0);
+		if (std::isnan(t)) {
+			return NAN;
+		}
+		return model.x(std::cos(theta), t, v0);
+	}
+
+	/// Ternary search for the elevation of maximum range in [0, PI/2)
+	static double optimal_angle(const Model &model, double v0, int iterations, double &out_range) {
+		double min_angle = 0.0;
+		double max_angle = PI / 2.0 - 0.01;
+		double best_range = 0.0;
+		double best_angle = 0.0;
+
+		for (int i = 0; i < iterations; i++) {
+			double mid1 = min_angle + (max_angle - min_angle) / 3.0;
+			double mid2 = max_angle - (max_angle - min_angle) / 3.0;
+
+			double range1 = range_at_angle(model, mid1, v0);
+			double range2 = range_at_angle(model, mid2, v0);
+
+			if (std::isnan(range1)) range1 = 0.0;
+			if (std::isnan(range2)) range2 = 0.0;
+
+			if (range1 < range2) {
+				min_angle = mid1;
+				if (range2 > best_range) {
+					best_range = range2;
+					best_angle = mid2;
+				}
+			} else {
+				max_angle = mid2;
+				if (range1 > best_range) {
+					best_range = range1;
+					best_angle = mid1;
+				}
+			}
+		}
+
+		out_range = best_range;
+		return best_angle;
+	}
+
+	/// Bisection for the elevation in [min_angle, max_angle] that lands at range
+	/// (range must be increasing over the bracket). Stops within 10cm.
+	static double angle_for_range(const Model &model, double range, double v0,
+			double min_angle, double max_angle, int iterations) {
+		for (int i = 0; i < iterations; i++) {
+			double mid_angle = (min_angle + max_angle) / 2.0;
+			double test_range = range_at_angle(model, mid_angle, v0);
+
+			if (std::isnan(test_range)) {
+				max_angle = mid_angle;
+				continue;
+			}
+
+			double error = test_range - range;
+			if (std::abs(error) < 0.1) {
+				return mid_angle;
+			}
+
+			if (error < 0) {
+				min_angle = mid_angle;
+			} else {
+				max_angle = mid_angle;
+			}
+		}
+		return (min_angle + max_angle) / 2.0;
+	}
+
+	//==========================================================================
+	// 3D API
+	//==========================================================================
+
+	static Vector3 position_at_time(const Model &model, const Vector3 &start_pos, const Vector3 &launch_vector, double time) {
+		double vx = launch_vector.x;
+		double vz = launch_vector.z;
+		double vy0 = launch_vector.y;
+		double v_horiz = std::sqrt(vx * vx + vz * vz);
+
+		if (v_horiz < 1e-10) {
+			// Purely vertical shot
+			double sin_theta = (vy0 >= 0) ? 1.0 : -1.0;
+			double y_offset = model.y(sin_theta, time, std::abs(vy0));
+			return Vector3(start_pos.x, start_pos.y + y_offset, start_pos.z);
+		}
+
+		double speed = std::sqrt(vx * vx + vy0 * vy0 + vz * vz);
+		double cos_theta = v_horiz / speed;
+		double sin_theta = vy0 / speed;
+
+		double x_dist = model.x(cos_theta, time, speed);
+		double y_offset = model.y(sin_theta, time, speed);
+
+		// Distribute horizontal distance along the launch azimuth
+		double horiz_scale = x_dist / v_horiz;
+		return Vector3(
+			start_pos.x + vx * horiz_scale,
+			start_pos.y + y_offset,
+			start_pos.z + vz * horiz_scale
+		);
+	}
+
+	static Vector3 velocity_at_time(const Model &model, const Vector3 &launch_vector, double time) {
+		double vx = launch_vector.x;
+		double vz = launch_vector.z;
+		double vy0 = launch_vector.y;
+		double v_horiz = std::sqrt(vx * vx + vz * vz);
+
+		if (v_horiz < 1e-10) {
+			double sin_theta = (vy0 >= 0) ? 1.0 : -1.0;
+			return Vector3(0, model.vy(sin_theta, time, std::abs(vy0)), 0);
+		}
+
+		double speed = std::sqrt(vx * vx + vy0 * vy0 + vz * vz);
+		double cos_theta = v_horiz / speed;
+		double sin_theta = vy0 / speed;
+
+		double horiz_scale = model.vx(cos_theta, time, speed) / v_horiz;
+		return Vector3(
+			vx * horiz_scale,
+			model.vy(sin_theta, time, speed),
+			vz * horiz_scale
+		);
+	}
+
+	/// Low-arc launch vector from start_pos to target_pos.
+	/// tolerance > 0 rejects solutions whose vertical miss exceeds it.
+	static bool launch_vector(const Model &model, const Vector3 &start_pos, const Vector3 &target_pos,
+			double v0, int refine_iterations, double tolerance, Vector3 &out_launch, double &out_time) {
+		Vector3 disp = target_pos - start_pos;
+		double horiz_dist = std::sqrt(disp.x * disp.x + disp.z * disp.z);
+
+		if (horiz_dist < 1e-6) {
+			// Target is directly above/below - can't solve with this method
+			return false;
+		}
+
+		double theta, flight_time;
+		if (!firing_solution(model, horiz_dist, disp.y, v0, false, refine_iterations, theta, flight_time)) {
+			return false;
+		}
+
+		double cos_theta = std::cos(theta);
+		double sin_theta = std::sin(theta);
+
+		if (tolerance > 0.0 && std::abs(model.y(sin_theta, flight_time, v0) - disp.y) > tolerance) {
+			return false;
+		}
+
+		out_launch = Vector3(
+			v0 * cos_theta * disp.x / horiz_dist,
+			v0 * sin_theta,
+			v0 * cos_theta * disp.z / horiz_dist
+		);
+		out_time = flight_time;
+		return true;
+	}
+
+	/// Fixed-point iteration on time of flight to lead a target moving at
+	/// constant velocity, starting from initial_time.
+	static bool leading_launch_vector(const Model &model, const Vector3 &start_pos, const Vector3 &target_pos,
+			const Vector3 &target_velocity, double v0, int refine_iterations, double tolerance,
+			double initial_time, int lead_iterations,
+			Vector3 &out_launch, double &out_time, Vector3 &out_aim) {
+		double time_estimate = initial_time;
+		Vector3 launch;
+
+		for (int i = 0; i < lead_iterations; i++) {
+			Vector3 predicted_pos = target_pos + target_velocity * time_estimate;
+			if (!launch_vector(model, start_pos, predicted_pos, v0, refine_iterations, tolerance, launch, time_estimate)) {
+				return false;
+			}
+		}
+
+		Vector3 final_target_pos = target_pos + target_velocity * time_estimate;
+		if (!launch_vector(model, start_pos, final_target_pos, v0, refine_iterations, tolerance, out_launch, out_time)) {
+			return false;
+		}
+		out_aim = final_target_pos;
+		return true;
+	}
+
+	/// Time at which the shell crosses world height y = 0 on the way down
+	static double impact_time(const Model &model, const Vector3 &start_pos, const Vector3 &launch_vector) {
+		double vx = launch_vector.x;
+		double vz = launch_vector.z;
+		double vy0 = launch_vector.y;
+		double speed = std::sqrt(vx * vx + vy0 * vy0 + vz * vz);
+		if (speed < 1e-10) {
+			return NAN;
+		}
+		double t = model.time_to_y(vy0 / speed, speed, -start_pos.y);
+		return (std::isnan(t) || t < 0.0) ? NAN : t;
+	}
+};
+
+} // namespace godot
+
+#endif // BALLISTICS_CORE_H
@@ -0,0 +1,351 @@
+#include "dispersion_sampler.h"
+#include "ballistics_core.h"
+#include "projectile_physics_with_drag_v2.h"
+
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace godot;
+
+void DispersionSampler::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_seed", "seed"), &DispersionSampler::set_seed);
+	ClassDB::bind_method(D_METHOD("set_sigma", "sigma"), &DispersionSampler::set_sigma);
+	ClassDB::bind_method(D_METHOD("get_sigma"), &DispersionSampler::get_sigma);
+	ClassDB::bind_method(D_METHOD("set_citadel_fractions", "h_frac", "v_frac"), &DispersionSampler::set_citadel_fractions);
+	ClassDB::bind_method(D_METHOD("set_citadel_guarantee_enabled", "enabled"), &DispersionSampler::set_citadel_guarantee_enabled);
+	ClassDB::bind_method(D_METHOD("is_citadel_guarantee_enabled"), &DispersionSampler::is_citadel_guarantee_enabled);
+	ClassDB::bind_method(D_METHOD("get_inner_shell_count"), &DispersionSampler::get_inner_shell_count);
+
+	ClassDB::bind_method(D_METHOD("next_offset", "sigma"), &DispersionSampler::next_offset);
+	ClassDB::bind_method(D_METHOD("calculate_dispersed_launch", "aim_point", "gun_position", "shell_params",
+		"sigma_h", "sigma_v", "max_range", "h_dispersion_curve", "v_dispersion_curve", "max_h_disp", "max_v_disp"),
+		&DispersionSampler::calculate_dispersed_launch);
+	ClassDB::bind_method(D_METHOD("sample_salvo", "n", "sigma", "aim_point", "gun_position", "shell_params",
+		"max_range", "h_dispersion_curve", "v_dispersion_curve", "max_h_disp", "max_v_disp"),
+		&DispersionSampler::sample_salvo);
+	ClassDB::bind_method(D_METHOD("sample_offsets", "n", "sigma"), &DispersionSampler::sample_offsets);
+
+	ClassDB::bind_static_method("DispersionSampler", D_METHOD("sample_dispersion", "curve", "t", "max_disp"), &DispersionSampler::sample_dispersion);
+	ClassDB::bind_static_method("DispersionSampler", D_METHOD("erf", "x"), &DispersionSampler::erf);
+	ClassDB::bind_static_method("DispersionSampler", D_METHOD("erfinv", "x"), &DispersionSampler::erfinv);
+
+	BIND_CONSTANT(SHELL_COUNT);
+	BIND_CONSTANT(CITADEL_GUARANTEE_NUM);
+}
+
+DispersionSampler::DispersionSampler()
+	: shell_index_(SHELL_COUNT),
+	  citadel_guarantee_counter_(0),
+	  sigma_(1.0),
+	  citadel_h_frac_(0.5),
+	  citadel_v_frac_(0.2),
+	  citadel_guarantee_enabled_(true) {
+	h_offsets_.fill(0.0);
+	v_offsets_.fill(0.0);
+	// Follow Godot's global RNG so randomize()/seed() keep working for scripts.
+	// shell_index_ starts exhausted so the first shot opens a salvo with the
+	// gun's real sigma instead of a placeholder.
+	set_seed((int64_t)UtilityFunctions::randi() << 32 | (int64_t)UtilityFunctions::randi());
+}
+
+DispersionSampler::~DispersionSampler() {
+}
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+void DispersionSampler::set_seed(int64_t seed) {
+	// splitmix64 expansion of the seed into the xoshiro state
+	uint64_t x = (uint64_t)seed;
+	for (int i = 0; i < 4; i++) {
+		x += 0x9E3779B97F4A7C15ULL;
+		uint64_t z = x;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		rng_state_[i] = z ^ (z >> 31);
+	}
+}
+
+void DispersionSampler::set_sigma(double sigma) {
+	sigma_ = std::max(sigma, 1.0);
+}
+
+double DispersionSampler::get_sigma() const {
+	return sigma_;
+}
+
+void DispersionSampler::set_citadel_fractions(double h_frac, double v_frac) {
+	citadel_h_frac_ = std::max(h_frac, 0.01);
+	citadel_v_frac_ = std::max(v_frac, 0.01);
+}
+
+void DispersionSampler::set_citadel_guarantee_enabled(bool enabled) {
+	citadel_guarantee_enabled_ = enabled;
+}
+
+bool DispersionSampler::is_citadel_guarantee_enabled() const {
+	return citadel_guarantee_enabled_;
+}
+
+int DispersionSampler::get_inner_shell_count() const {
+	return shell_index_;
+}
+
+// ============================================================================
+// RNG (xoshiro256**)
+// ============================================================================
+
+uint64_t DispersionSampler::next_u64() {
+	auto rotl = [](uint64_t x, int k) { return (x << k) | (x >> (64 - k)); };
+
+	const uint64_t result = rotl(rng_state_[1] * 5, 7) * 9;
+	const uint64_t t = rng_state_[1] << 17;
+
+	rng_state_[2] ^= rng_state_[0];
+	rng_state_[3] ^= rng_state_[1];
+	rng_state_[1] ^= rng_state_[2];
+	rng_state_[0] ^= rng_state_[3];
+	rng_state_[2] ^= t;
+	rng_state_[3] = rotl(rng_state_[3], 45);
+
+	return result;
+}
+
+double DispersionSampler::randf() {
+	// 53 random mantissa bits -> [0, 1)
+	return (double)(next_u64() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+int DispersionSampler::randi_range(int lo, int hi) {
+	return lo + (int)(randf() * (double)(hi - lo + 1));
+}
+
+// ============================================================================
+// erf / erfinv
+// ============================================================================
+
+double DispersionSampler::erf(double x) {
+	return std::erf(x);
+}
+
+double DispersionSampler::erfinv_direct(double x) {
+	if (x <= -1.0) return -INFINITY;
+	if (x >= 1.0) return INFINITY;
+
+	// Winitzki (2008) initial guess, then Newton on erf(y) - x
+	const double A = 0.147;
+	const double two_over_pi_a = 2.0 / (Math_PI * A);
+	double w = std::log(1.0 - x * x);
+	double inner = two_over_pi_a + w * 0.5;
+	double y = std::copysign(std::sqrt(std::sqrt(inner * inner - w / A) - inner), x);
+
+	const double two_over_sqrt_pi = 1.1283791670955126;
+	for (int i = 0; i < 2; i++) {
+		double err = std::erf(y) - x;
+		y -= err / (two_over_sqrt_pi * std::exp(-y * y));
+	}
+	return y;
+}
+
+const std::array<float, DispersionSampler::ERFINV_TABLE_SIZE + 1> &DispersionSampler::erfinv_table() {
+	static const std::array<float, ERFINV_TABLE_SIZE + 1> table = [] {
+		std::array<float, ERFINV_TABLE_SIZE + 1> t;
+		for (int i = 0; i <= ERFINV_TABLE_SIZE; i++) {
+			t[i] = (float)erfinv_direct(ERFINV_TABLE_MAX * (double)i / ERFINV_TABLE_SIZE);
+		}
+		return t;
+	}();
+	return table;
+}
+
+double DispersionSampler::erfinv(double x) {
+	double ax = std::abs(x);
+	if (ax >= ERFINV_TABLE_MAX) {
+		return erfinv_direct(x);
+	}
+
+	// erfinv is odd: look up |x| and restore the sign
+	const auto &table = erfinv_table();
+	double pos = ax * (ERFINV_TABLE_SIZE / ERFINV_TABLE_MAX);
+	int i = std::min((int)pos, ERFINV_TABLE_SIZE - 1);
+	double frac = pos - i;
+	double y = table[i] + (table[i + 1] - table[i]) * frac;
+	return x < 0.0 ? -y : y;
+}
+
+// ============================================================================
+// Salvo generation
+// ============================================================================
+
+void DispersionSampler::generate_axis(double s, double erf_bound, std::array<double, SHELL_COUNT> &out) {
+	// SHELL_COUNT samples from N(0, 1/s²) truncated to [-1, 1], stratified
+	// across equal CDF bins then Fisher-Yates shuffled. Inverting the CDF of
+	// the truncated Gaussian F(x) = 0.5 + 0.5 * erf(x * s / sqrt(2)) / erf_bound:
+	//   x = sqrt(2)/s * erfinv(erf_bound * (2u - 1))
+	const double inv_s_sqrt2 = std::sqrt(2.0) / s;
+	for (int i = 0; i < SHELL_COUNT; i++) {
+		double u_low = (double)i / SHELL_COUNT;
+		double u_high = (double)(i + 1) / SHELL_COUNT;
+		double u = u_low + randf() * (u_high - u_low);
+		out[i] = inv_s_sqrt2 * erfinv(erf_bound * (2.0 * u - 1.0));
+	}
+	for (int i = SHELL_COUNT - 1; i > 0; i--) {
+		int j = randi_range(0, i);
+		std::swap(out[i], out[j]);
+	}
+}
+
+void DispersionSampler::new_salvo(double sigma) {
+	shell_index_ = 0;
+	double s = std::max(sigma, 0.01);
+	// erf(s / sqrt(2)) = mass of the full Gaussian inside the truncation
+	// bounds; the CDF normalisation constant for each axis.
+	double erf_bound = std::erf(s / std::sqrt(2.0));
+	generate_axis(s, erf_bound, h_offsets_);
+	generate_axis(s, erf_bound, v_offsets_);
+	citadel_guarantee_counter_ += SHELL_COUNT;
+
+	if (citadel_guarantee_enabled_ && citadel_guarantee_counter_ >= CITADEL_GUARANTEE_NUM) {
+		apply_citadel_guarantee();
+		citadel_guarantee_counter_ -= CITADEL_GUARANTEE_NUM;
+	}
+}
+
+void DispersionSampler::apply_citadel_guarantee() {
+	// Only nudge a shell inward if none of the salvo already lands inside
+	// the citadel ellipse (offsets are in normalised [-1, 1] space).
+	const double ea = citadel_h_frac_;
+	const double eb = citadel_v_frac_;
+	if (ea <= 0.0 || eb <= 0.0) {
+		return;
+	}
+
+	int closest_idx = 0;
+	double closest_d = INFINITY;
+
+	for (int i = 0; i < SHELL_COUNT; i++) {
+		double h_frac = h_offsets_[i];
+		double v_frac = v_offsets_[i];
+		double d = (h_frac * h_frac) / (ea * ea) + (v_frac * v_frac) / (eb * eb);
+		if (d <= 1.0) {
+			return;
+		}
+		if (d < closest_d) {
+			closest_d = d;
+			closest_idx = i;
+		}
+	}
+
+	double h_frac = h_offsets_[closest_idx];
+	double new_h = std::abs(h_frac) > ea ? std::copysign(ea * randf(), h_frac) : h_frac;
+	double v_max = eb * std::sqrt(1.0 - (new_h / ea) * (new_h / ea));
+	double v_sign = randf() < 0.5 ? 1.0 : -1.0;
+	double new_v = v_sign * std::pow(randf(), 1.6) * v_max;
+	h_offsets_[closest_idx] = new_h;
+	v_offsets_[closest_idx] = new_v;
+}
+
+Vector2 DispersionSampler::next_offset(double sigma) {
+	if (shell_index_ >= SHELL_COUNT) {
+		new_salvo(sigma);
+	}
+	Vector2 offset(h_offsets_[shell_index_], v_offsets_[shell_index_]);
+	shell_index_++;
+	return offset;
+}
+
+PackedVector2Array DispersionSampler::sample_offsets(int n, double sigma) {
+	PackedVector2Array out;
+	if (n <= 0) {
+		return out;
+	}
+	out.resize(n);
+	Vector2 *dst = out.ptrw();
+	for (int i = 0; i < n; i++) {
+		dst[i] = next_offset(sigma);
+	}
+	return out;
+}
+
+double DispersionSampler::sample_dispersion(const Ref<Curve> &curve, double t, double max_disp) {
+	if (curve.is_null()) {
+		return 0.0;
+	}
+	if (t <= 1.0) {
+		return curve->sample(t) * max_disp;
+	}
+	double slope = curve->get_point_left_tangent(curve->get_point_count() - 1);
+	return (curve->sample(1.0) + slope * (t - 1.0)) * max_disp;
+}
+
+// ============================================================================
+// Launch vectors
+// ============================================================================
+
+Variant DispersionSampler::calculate_dispersed_launch(const Vector3 &aim_point, const Vector3 &gun_position,
+	const Ref<Resource> &shell_params, double sigma_h, double sigma_v, double max_range,
+	const Ref<Curve> &h_dispersion_curve, const Ref<Curve> &v_dispersion_curve,
+	double max_h_disp, double max_v_disp) {
+
+	// sigma_v is reserved for per-axis sigma asymmetry; unused for now
+	(void)sigma_v;
+
+	PackedVector3Array launch = sample_salvo(1, sigma_h, aim_point, gun_position, shell_params, max_range,
+		h_dispersion_curve, v_dispersion_curve, max_h_disp, max_v_disp);
+	if (launch.is_empty() || launch[0] == Vector3()) {
+		return Variant();
+	}
+	return launch[0];
+}
+
+PackedVector3Array DispersionSampler::sample_salvo(int n, double sigma, const Vector3 &aim_point, const Vector3 &gun_position,
+	const Ref<Resource> &shell_params, double max_range,
+	const Ref<Curve> &h_dispersion_curve, const Ref<Curve> &v_dispersion_curve,
+	double max_h_disp, double max_v_disp) {
+
+	PackedVector3Array out;
+	if (n <= 0) {
+		return out;
+	}
+
+	double v0;
+	QuadraticDrag model = ProjectilePhysicsWithDragV2::_default_model();
+	if (!ProjectilePhysicsWithDragV2::_extract_params(shell_params, v0, model)) {
+		UtilityFunctions::push_error("[DispersionSampler] sample_salvo: invalid shell_params");
+		return out;
+	}
+
+	Vector3 to_aim = aim_point - gun_position;
+	double t = max_range > 0.0 ? std::max((double)to_aim.length() / max_range, 0.0) : 0.0;
+	double half_h = sample_dispersion(h_dispersion_curve, t, max_h_disp) * 0.5;
+	double half_v = sample_dispersion(v_dispersion_curve, t, max_v_disp) * 0.5;
+
+	// Aim frame. Shots straight up/down have no horizontal aim direction to
+	// build a lateral axis from, so fall back to an arbitrary perpendicular.
+	Vector3 forward = to_aim.normalized();
+	Vector3 right = forward.cross(Vector3(0, 1, 0));
+	if (right.length_squared() < 0.0001f) {
+		right = forward.cross(Vector3(1, 0, 0));
+	}
+	right = right.normalized();
+	Vector3 up = right.cross(forward).normalized();
+
+	out.resize(n);
+	Vector3 *dst = out.ptrw();
+	for (int i = 0; i < n; i++) {
+		Vector2 offset = next_offset(sigma);
+		Vector3 dispersed_aim = aim_point + right * (offset.x * half_h) + up * (offset.y * half_v);
+
+		Vector3 launch;
+		double flight_time;
+		if (!BallisticSolver<QuadraticDrag>::launch_vector(model, gun_position, dispersed_aim, v0,
+				ProjectilePhysicsWithDragV2::MAX_ITERATIONS, 0.0, launch, flight_time)) {
+			launch = Vector3();
+		}
+		dst[i] = launch;
+	}
+	return out;
+}
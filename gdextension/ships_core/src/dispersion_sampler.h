@@ -0,0 +1,125 @@
+#ifndef DISPERSION_SAMPLER_H
+#define DISPERSION_SAMPLER_H
+
+#include <godot_cpp/classes/curve.hpp>
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/classes/resource.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace godot {
+
+/// Per-gun-group salvo dispersion (native port of dispersion_calculator.gd).
+///
+/// Each salvo draws SHELL_COUNT lateral and vertical offsets from a normal
+/// distribution with std-dev 1/sigma truncated to [-1, 1], stratified over
+/// equal CDF bins and shuffled, with an optional citadel guarantee every
+/// CITADEL_GUARANTEE_NUM shells. Offsets are scaled by the range-dependent
+/// dispersion curves and turned into launch vectors with the V2 solver.
+///
+/// Uses its own xoshiro256** stream (seeded from Godot's global RNG, or
+/// set_seed() for reproducible salvos) and a precomputed erfinv table.
+class DispersionSampler : public RefCounted {
+	GDCLASS(DispersionSampler, RefCounted)
+
+public:
+	static constexpr int SHELL_COUNT = 3;
+	static constexpr int CITADEL_GUARANTEE_NUM = 4;
+
+	// erfinv lookup covers |x| <= ERFINV_TABLE_MAX (erf(sigma/sqrt(2)) for
+	// sigma up to ~2.57); larger arguments fall back to direct evaluation.
+	static constexpr int ERFINV_TABLE_SIZE = 4096;
+	static constexpr double ERFINV_TABLE_MAX = 0.99;
+
+protected:
+	static void _bind_methods();
+
+public:
+	DispersionSampler();
+	~DispersionSampler();
+
+	// --- Configuration ---
+
+	void set_seed(int64_t seed);
+	void set_sigma(double sigma);
+	double get_sigma() const;
+
+	/// Citadel ellipse size as fractions of the dispersion ellipse,
+	/// e.g. set_citadel_fractions(0.5, 0.1)
+	void set_citadel_fractions(double h_frac, double v_frac);
+	void set_citadel_guarantee_enabled(bool enabled);
+	bool is_citadel_guarantee_enabled() const;
+
+	/// Shells already consumed from the current salvo
+	int get_inner_shell_count() const;
+
+	// --- Sampling ---
+
+	/// Next normalised (h, v) offset in [-1, 1]², starting a new salvo with
+	/// the given sigma when the current one is exhausted
+	Vector2 next_offset(double sigma);
+
+	/// Dispersed launch vector for one shell, or null if the dispersed aim
+	/// point has no firing solution (drop-in for DispersionCalculator)
+	Variant calculate_dispersed_launch(const Vector3 &aim_point, const Vector3 &gun_position,
+		const Ref<Resource> &shell_params, double sigma_h, double sigma_v, double max_range,
+		const Ref<Curve> &h_dispersion_curve, const Ref<Curve> &v_dispersion_curve,
+		double max_h_disp, double max_v_disp);
+
+	/// Dispersed launch vectors for n shells fired at the same aim point.
+	/// Dispersion curves, shell params and the aim frame are evaluated once.
+	/// Entries without a firing solution are Vector3.ZERO.
+	PackedVector3Array sample_salvo(int n, double sigma, const Vector3 &aim_point, const Vector3 &gun_position,
+		const Ref<Resource> &shell_params, double max_range,
+		const Ref<Curve> &h_dispersion_curve, const Ref<Curve> &v_dispersion_curve,
+		double max_h_disp, double max_v_disp);
+
+	/// n normalised offsets (see next_offset), e.g. for histogramming
+	PackedVector2Array sample_offsets(int n, double sigma);
+
+	/// Dispersion in metres at normalised range t; extrapolates past t = 1
+	/// along the curve's last left tangent
+	static double sample_dispersion(const Ref<Curve> &curve, double t, double max_disp);
+
+	// --- Math helpers (C++ and GDScript) ---
+
+	/// erf(x), std::erf
+	static double erf(double x);
+	/// erfinv(x) for |x| < 1 via lookup table + linear interpolation
+	static double erfinv(double x);
+
+private:
+	// xoshiro256** state
+	uint64_t rng_state_[4];
+
+	int shell_index_;
+	int citadel_guarantee_counter_;
+	std::array<double, SHELL_COUNT> h_offsets_;
+	std::array<double, SHELL_COUNT> v_offsets_;
+	double sigma_;
+
+	double citadel_h_frac_;
+	double citadel_v_frac_;
+	bool citadel_guarantee_enabled_;
+
+	uint64_t next_u64();
+	double randf();
+	int randi_range(int lo, int hi);
+
+	void new_salvo(double sigma);
+	void generate_axis(double s, double erf_bound, std::array<double, SHELL_COUNT> &out);
+	void apply_citadel_guarantee();
+
+	static double erfinv_direct(double x);
+	static const std::array<float, ERFINV_TABLE_SIZE + 1> &erfinv_table();
+};
+
+} // namespace godot
+
+#endif // DISPERSION_SAMPLER_H
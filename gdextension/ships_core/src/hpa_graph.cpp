@@ -1,5 +1,7 @@
 #include "hpa_graph.h"
 
+#include "nav_parallel.h"
+
 #include <godot_cpp/variant/utility_functions.hpp>
 
 #include <chrono>
@@ -40,14 +42,37 @@ void HpaGraph::_bind_methods() {
 		D_METHOD("find_path_packed", "from", "to", "query_clearance"),
 		&HpaGraph::find_path_packed, DEFVAL(-1.0f));
 	ClassDB::bind_method(
-		D_METHOD("add_obstacle", "id", "pos", "radius"),
-		&HpaGraph::add_obstacle);
+		D_METHOD("estimate_path_costs", "from", "targets", "query_clearance"),
+		&HpaGraph::estimate_path_costs_packed, DEFVAL(-1.0f));
+	ClassDB::bind_method(
+		D_METHOD("set_distance_field", "field_id", "goals", "goal_radius", "clearance"),
+		&HpaGraph::set_distance_field);
+	ClassDB::bind_method(D_METHOD("remove_distance_field", "field_id"), &HpaGraph::remove_distance_field);
+	ClassDB::bind_method(D_METHOD("clear_distance_fields"), &HpaGraph::clear_distance_fields);
+	ClassDB::bind_method(D_METHOD("has_distance_field", "field_id"), &HpaGraph::has_distance_field);
+	ClassDB::bind_method(D_METHOD("get_field_distance", "field_id", "pos"), &HpaGraph::get_field_distance);
+	ClassDB::bind_method(D_METHOD("get_field_direction", "field_id", "pos"), &HpaGraph::get_field_direction);
+	ClassDB::bind_method(
+		D_METHOD("add_obstacle", "id", "pos", "radius", "velocity"),
+		&HpaGraph::add_obstacle, DEFVAL(Vector2()));
+	ClassDB::bind_method(D_METHOD("move_obstacle", "id", "pos", "velocity"), &HpaGraph::move_obstacle);
 	ClassDB::bind_method(D_METHOD("remove_obstacle", "id"), &HpaGraph::remove_obstacle);
 	ClassDB::bind_method(D_METHOD("clear_obstacles"), &HpaGraph::clear_obstacles);
+	ClassDB::bind_method(D_METHOD("set_obstacle_horizon", "seconds"), &HpaGraph::set_obstacle_horizon);
+	ClassDB::bind_method(D_METHOD("get_obstacle_horizon"), &HpaGraph::get_obstacle_horizon);
+	ClassDB::bind_method(D_METHOD("set_obstacle_soft_cost", "metres"), &HpaGraph::set_obstacle_soft_cost);
+	ClassDB::bind_method(D_METHOD("get_obstacle_soft_cost"), &HpaGraph::get_obstacle_soft_cost);
+	ClassDB::bind_method(D_METHOD("sync_with_map"), &HpaGraph::sync_with_map);
+	ClassDB::bind_method(D_METHOD("set_route_cache_capacity", "capacity"), &HpaGraph::set_route_cache_capacity);
+	ClassDB::bind_method(D_METHOD("get_route_cache_capacity"), &HpaGraph::get_route_cache_capacity);
+	ClassDB::bind_method(D_METHOD("clear_route_cache"), &HpaGraph::clear_route_cache);
 	ClassDB::bind_method(D_METHOD("get_node_count"), &HpaGraph::get_node_count);
 	ClassDB::bind_method(D_METHOD("get_cluster_count"), &HpaGraph::get_cluster_count);
 	ClassDB::bind_method(D_METHOD("get_sub_cluster_count"), &HpaGraph::get_sub_cluster_count);
+	ClassDB::bind_method(D_METHOD("get_portal_count"), &HpaGraph::get_portal_count);
+	ClassDB::bind_method(D_METHOD("get_portal_clearance_buckets"), &HpaGraph::get_portal_clearance_buckets);
 	ClassDB::bind_method(D_METHOD("get_debug_nodes"), &HpaGraph::get_debug_nodes);
+	ClassDB::bind_method(D_METHOD("get_debug_portals"), &HpaGraph::get_debug_portals);
 	ClassDB::bind_method(D_METHOD("get_debug_edges"), &HpaGraph::get_debug_edges);
 	ClassDB::bind_method(D_METHOD("get_debug_clusters"), &HpaGraph::get_debug_clusters);
 	ClassDB::bind_method(D_METHOD("get_debug_sub_clusters"), &HpaGraph::get_debug_sub_clusters);
@@ -58,6 +83,7 @@ void HpaGraph::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_perf_spike_threshold_us"), &HpaGraph::get_perf_spike_threshold_us);
 	ClassDB::bind_method(D_METHOD("set_perf_tracking_enabled", "enabled"), &HpaGraph::set_perf_tracking_enabled);
 	ClassDB::bind_method(D_METHOD("is_perf_tracking_enabled"), &HpaGraph::is_perf_tracking_enabled);
+	ClassDB::bind_method(D_METHOD("benchmark_cluster_storage", "queries", "clearance"), &HpaGraph::benchmark_cluster_storage, DEFVAL(200), DEFVAL(150.0f));
 }
 
 HpaGraph::HpaGraph() = default;
@@ -68,14 +94,24 @@ HpaGraph::~HpaGraph() = default;
 // ============================================================================
 
 void HpaGraph::build(Ref<NavigationMap> map, float clearance, int cluster_size) {
+	std::unique_lock<std::shared_mutex> lock(structure_mutex_);
 	built_ = false;
+	portals_built_ = false;
 	clusters_.clear();
 	sub_clusters_.clear();
+	cluster_max_sdf_.clear();
+	cluster_min_sdf_.clear();
+	sub_max_sdf_.clear();
+	sub_min_sdf_.clear();
 	cluster_block_count_.clear();
-	cluster_threat_blocked_.clear();
-	threat_blocked_cids_.clear();
-	threat_blocked_count_ = 0;
 	obstacles_.clear();
+	obstacle_version_++;
+	structure_gen_++;
+	{
+		std::lock_guard<std::mutex> cache_lock(threat_cache_mutex_);
+		threat_cache_.clear();
+	}
+	clear_route_cache();
 
 	if (!map.is_valid() || !map->is_built()) {
 		UtilityFunctions::print("[HpaGraph] build: NavigationMap is not built");
@@ -123,14 +159,15 @@ void HpaGraph::build(Ref<NavigationMap> map, float clearance, int cluster_size)
 
 	build_clusters();
 	build_sub_clusters();
+	build_portals();
 
 	int navigable_count = 0;
-	for (const Cluster &c : clusters_)
-		if (c.navigable) ++navigable_count;
+	for (float max_sdf : cluster_max_sdf_)
+		if (max_sdf >= clearance_) ++navigable_count;
 
 	int sub_navigable_count = 0;
-	for (const SubCluster &s : sub_clusters_)
-		if (s.navigable) ++sub_navigable_count;
+	for (float max_sdf : sub_max_sdf_)
+		if (max_sdf >= clearance_) ++sub_navigable_count;
 
 	UtilityFunctions::print(
 		"[HpaGraph] built: ", (int)clusters_.size(), " clusters (",
@@ -138,7 +175,160 @@ void HpaGraph::build(Ref<NavigationMap> map, float clearance, int cluster_size)
 		(int)sub_clusters_.size(), " sub-clusters (",
 		sub_navigable_count, " navigable)");
 
+	map_version_ = static_cast<uint64_t>(map->get_version());
+	built_ = true;
+}
+
+// ============================================================================
+// Cache serialization
+// ============================================================================
+
+void HpaGraph::write_cache(NavCacheWriter &w) const {
+	// Struct sizes guard against reading a cache written by a build with a
+	// different Cluster/SubCluster/HpaPortal layout.
+	w.write<uint32_t>(sizeof(Cluster));
+	w.write<uint32_t>(sizeof(SubCluster));
+	w.write<uint32_t>(sizeof(HpaPortal));
+
+	w.write<float>(clearance_);
+	w.write<int32_t>(cluster_size_);
+	w.write<int32_t>(sub_size_);
+	w.write<int32_t>(grid_w_);
+	w.write<int32_t>(grid_h_);
+	w.write<int32_t>(ncx_);
+	w.write<int32_t>(ncz_);
+	w.write<int32_t>(nsubx_);
+	w.write<int32_t>(nsubz_);
+
+	w.write_vector(clusters_);
+	w.write_vector(sub_clusters_);
+	w.write_vector(cluster_max_sdf_);
+	w.write_vector(cluster_min_sdf_);
+	w.write_vector(sub_max_sdf_);
+	w.write_vector(sub_min_sdf_);
+
+	w.write_vector(portal_buckets_);
+	w.write_vector(portals_);
+	w.write_vector(cluster_node_begin_);
+	w.write_vector(cluster_nodes_);
+	w.write_vector(portal_tables_);
+	w.write_vector(portal_costs_);
+	w.write_vector(portal_paths_);
+	w.write_vector(portal_points_);
+}
+
+bool HpaGraph::read_cache(NavCacheReader &r, Ref<NavigationMap> map) {
+	std::unique_lock<std::shared_mutex> lock(structure_mutex_);
+	built_ = false;
+	portals_built_ = false;
+	clusters_.clear();
+	sub_clusters_.clear();
+	cluster_max_sdf_.clear();
+	cluster_min_sdf_.clear();
+	sub_max_sdf_.clear();
+	sub_min_sdf_.clear();
+	cluster_block_count_.clear();
+	obstacles_.clear();
+	obstacle_version_++;
+	structure_gen_++;
+	{
+		std::lock_guard<std::mutex> cache_lock(threat_cache_mutex_);
+		threat_cache_.clear();
+	}
+	clear_route_cache();
+
+	if (!map.is_valid() || !map->is_built()) {
+		return false;
+	}
+
+	uint32_t cluster_bytes = 0, sub_bytes = 0, portal_bytes = 0;
+	r.read(cluster_bytes);
+	r.read(sub_bytes);
+	r.read(portal_bytes);
+	if (!r.ok || cluster_bytes != sizeof(Cluster) || sub_bytes != sizeof(SubCluster) ||
+			portal_bytes != sizeof(HpaPortal)) {
+		return false;
+	}
+
+	int32_t cluster_size = 0, sub_size = 0, gw = 0, gh = 0, ncx = 0, ncz = 0, nsubx = 0, nsubz = 0;
+	r.read(clearance_);
+	r.read(cluster_size);
+	r.read(sub_size);
+	r.read(gw);
+	r.read(gh);
+	r.read(ncx);
+	r.read(ncz);
+	r.read(nsubx);
+	r.read(nsubz);
+	if (!r.ok || cluster_size <= 0 || sub_size <= 0 || cluster_size % sub_size != 0 ||
+			gw != map->get_grid_width() || gh != map->get_grid_height()) {
+		return false;
+	}
+
+	const uint64_t nc = static_cast<uint64_t>(ncx) * static_cast<uint64_t>(ncz);
+	const uint64_t ns = static_cast<uint64_t>(nsubx) * static_cast<uint64_t>(nsubz);
+	r.read_vector(clusters_, nc);
+	r.read_vector(sub_clusters_, ns);
+	r.read_vector(cluster_max_sdf_, nc);
+	r.read_vector(cluster_min_sdf_, nc);
+	r.read_vector(sub_max_sdf_, ns);
+	r.read_vector(sub_min_sdf_, ns);
+	if (!r.ok || clusters_.size() != nc || sub_clusters_.size() != ns ||
+			cluster_max_sdf_.size() != nc || cluster_min_sdf_.size() != nc ||
+			sub_max_sdf_.size() != ns || sub_min_sdf_.size() != ns) {
+		clusters_.clear();
+		sub_clusters_.clear();
+		return false;
+	}
+
+	const uint64_t max_count = r.size;  // read_vector also bounds by the bytes left
+	r.read_vector(portal_buckets_, max_count);
+	r.read_vector(portals_, max_count);
+	r.read_vector(cluster_node_begin_, max_count);
+	r.read_vector(cluster_nodes_, max_count);
+	r.read_vector(portal_tables_, max_count);
+	r.read_vector(portal_costs_, max_count);
+	r.read_vector(portal_paths_, max_count);
+	r.read_vector(portal_points_, max_count);
+	if (!r.ok) {
+		clusters_.clear();
+		sub_clusters_.clear();
+		return false;
+	}
+
+	// Derived layout, same as build()
+	nav_map_      = map;
+	cluster_size_ = cluster_size;
+	sub_size_     = sub_size;
+	subs_per_macro_side_ = cluster_size_ / sub_size_;
+	grid_w_       = gw;
+	grid_h_       = gh;
+	ncx_          = ncx;
+	ncz_          = ncz;
+	nsubx_        = nsubx;
+	nsubz_        = nsubz;
+	cell_size_    = map->get_cell_size_value();
+	min_x_        = map->get_min_x();
+	min_z_        = map->get_min_z();
+	cardinal_step_cost_ = static_cast<float>(cluster_size_) * cell_size_;
+	diagonal_step_cost_ = cardinal_step_cost_ * 1.41421356237f;
+
+	if (!portals_consistent()) {
+		clusters_.clear();
+		sub_clusters_.clear();
+		return false;
+	}
+	cluster_block_count_.assign(clusters_.size(), 0);
+	index_portal_nodes();
+	free_portals_.clear();
+	for (int pi = 0; pi < static_cast<int>(portals_.size()); ++pi) {
+		if (portals_[pi].cid[0] < 0) free_portals_.push_back(pi);
+	}
+	portals_built_ = true;
+
+	map_version_ = static_cast<uint64_t>(map->get_version());
 	built_ = true;
+	return true;
 }
 
 // ============================================================================
@@ -148,11 +338,9 @@ void HpaGraph::build(Ref<NavigationMap> map, float clearance, int cluster_size)
 void HpaGraph::build_clusters() {
 	int total = ncx_ * ncz_;
 	clusters_.resize(total);
+	cluster_max_sdf_.resize(total);
+	cluster_min_sdf_.resize(total);
 	cluster_block_count_.assign(total, 0);
-	cluster_threat_blocked_.assign(total, 0);
-
-	const float NEG_INF = -std::numeric_limits<float>::infinity();
-	const float POS_INF =  std::numeric_limits<float>::infinity();
 
 	for (int cz = 0; cz < ncz_; ++cz) {
 		for (int cx = 0; cx < ncx_; ++cx) {
@@ -177,21 +365,22 @@ void HpaGraph::build_clusters() {
 			grid_to_world((c.x0 + c.x1) / 2, (c.z0 + c.z1) / 2,
 			              c.wx_center, c.wz_center);
 
-			// Full SDF scan to get max_sdf and min_sdf.
-			float max_sdf = NEG_INF;
-			float min_sdf = POS_INF;
-			for (int gz = c.z0; gz <= c.z1; ++gz) {
-				for (int gx = c.x0; gx <= c.x1; ++gx) {
-					float wx, wz;
-					grid_to_world(gx, gz, wx, wz);
-					float sdf = nav_map_->get_distance(wx, wz);
-					if (sdf > max_sdf) max_sdf = sdf;
-					if (sdf < min_sdf) min_sdf = sdf;
-				}
-			}
-			c.max_sdf  = max_sdf;
-			c.min_sdf  = min_sdf;
-			c.navigable = (max_sdf >= clearance_);
+			scan_sdf_range(c.x0, c.z0, c.x1, c.z1, cluster_min_sdf_[id], cluster_max_sdf_[id]);
+		}
+	}
+}
+
+// Full SDF scan of an inclusive cell range for its min and max SDF
+void HpaGraph::scan_sdf_range(int x0, int z0, int x1, int z1, float &min_sdf, float &max_sdf) const {
+	max_sdf = -std::numeric_limits<float>::infinity();
+	min_sdf =  std::numeric_limits<float>::infinity();
+	for (int gz = z0; gz <= z1; ++gz) {
+		for (int gx = x0; gx <= x1; ++gx) {
+			float wx, wz;
+			grid_to_world(gx, gz, wx, wz);
+			float sdf = nav_map_->get_distance(wx, wz);
+			if (sdf > max_sdf) max_sdf = sdf;
+			if (sdf < min_sdf) min_sdf = sdf;
 		}
 	}
 }
@@ -209,9 +398,10 @@ void HpaGraph::build_clusters() {
 void HpaGraph::build_sub_clusters() {
 	int total = nsubx_ * nsubz_;
 	sub_clusters_.assign(total, SubCluster{});
+	sub_max_sdf_.resize(total);
+	sub_min_sdf_.resize(total);
 
 	const float NEG_INF = -std::numeric_limits<float>::infinity();
-	const float POS_INF =  std::numeric_limits<float>::infinity();
 
 	for (int scz = 0; scz < nsubz_; ++scz) {
 		for (int scx = 0; scx < nsubx_; ++scx) {
@@ -235,9 +425,8 @@ void HpaGraph::build_sub_clusters() {
 			// Wholly outside the cell grid — mark impassable, no SDF scan.
 			if (x0 >= grid_w_ || z0 >= grid_h_) {
 				s.x0 = x0; s.z0 = z0; s.x1 = x1; s.z1 = z1;
-				s.max_sdf = NEG_INF;
-				s.min_sdf = NEG_INF;
-				s.navigable = false;
+				sub_max_sdf_[sid] = NEG_INF;
+				sub_min_sdf_[sid] = NEG_INF;
 				// Centre still computed for debug/visualisation.
 				grid_to_world((x0 + x1) / 2, (z0 + z1) / 2,
 				              s.wx_center, s.wz_center);
@@ -253,22 +442,487 @@ void HpaGraph::build_sub_clusters() {
 			grid_to_world((s.x0 + s.x1) / 2, (s.z0 + s.z1) / 2,
 			              s.wx_center, s.wz_center);
 
-			float max_sdf = NEG_INF;
-			float min_sdf = POS_INF;
-			for (int gz = s.z0; gz <= s.z1; ++gz) {
-				for (int gx = s.x0; gx <= s.x1; ++gx) {
-					float wx, wz;
-					grid_to_world(gx, gz, wx, wz);
-					float sdf = nav_map_->get_distance(wx, wz);
-					if (sdf > max_sdf) max_sdf = sdf;
-					if (sdf < min_sdf) min_sdf = sdf;
+			scan_sdf_range(s.x0, s.z0, s.x1, s.z1, sub_min_sdf_[sid], sub_max_sdf_[sid]);
+		}
+	}
+}
+
+// ============================================================================
+// build_portals
+// ============================================================================
+//
+// HPA* entrance graph.  Each border between 4-adjacent clusters is scanned
+// for maximal runs of cell pairs whose min SDF clears the build clearance;
+// every run becomes one portal on its widest pair, annotated with that
+// pair's clearance.  Per cluster, a cell Dijkstra from every portal node at
+// each clearance bucket the cluster is only partly passable at gives the
+// cost to every other node and a string-pulled path for refinement.
+// Buckets the whole cluster clears (open water) need neither.
+//
+void HpaGraph::build_portals() {
+	portals_built_ = false;
+	portals_.clear();
+	free_portals_.clear();
+	cluster_node_begin_.clear();
+	cluster_nodes_.clear();
+	node_local_.clear();
+	portal_tables_.clear();
+	portal_costs_.clear();
+	portal_paths_.clear();
+	portal_points_.clear();
+
+	portal_buckets_.clear();
+	portal_buckets_.push_back(clearance_);
+	for (float b : PORTAL_BUCKET_CLEARANCES) {
+		if (b > clearance_) portal_buckets_.push_back(b);
+	}
+
+	const int nc = static_cast<int>(clusters_.size());
+	if (nc == 0 || !nav_map_.is_valid()) return;
+
+	auto t0 = std::chrono::steady_clock::now();
+
+	auto navigable = [&](int cid) { return cluster_max_sdf_[cid] >= clearance_; };
+	for (const Cluster &c : clusters_) {
+		if (!navigable(c.id)) continue;
+		if (c.cx + 1 < ncx_ && navigable(cluster_id(c.cx + 1, c.cz))) {
+			scan_portal_border(c.id, cluster_id(c.cx + 1, c.cz), portals_);
+		}
+		if (c.cz + 1 < ncz_ && navigable(cluster_id(c.cx, c.cz + 1))) {
+			scan_portal_border(c.id, cluster_id(c.cx, c.cz + 1), portals_);
+		}
+	}
+
+	collect_portal_nodes();
+	build_portal_tables(std::vector<uint8_t>(nc, 1));
+	portals_built_ = true;
+
+	float ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t0).count();
+	UtilityFunctions::print("[HpaGraph] portal graph: ", (int)portals_.size(), " portals, ",
+							(int)portal_buckets_.size(), " clearance buckets, ", (int)portal_costs_.size(),
+							" stored edges, ", (int)(portal_points_.size() / 2), " cached path points in ", ms, " ms");
+}
+
+// Portals on the border between cid_a and cid_b, which lies east or south
+// of cid_a, appended to 'out' in border order.
+void HpaGraph::scan_portal_border(int cid_a, int cid_b, std::vector<HpaPortal> &out) const {
+	const float INF = std::numeric_limits<float>::infinity();
+	auto cell_sdf = [&](int gx, int gz) -> float {
+		float wx, wz;
+		grid_to_world(gx, gz, wx, wz);
+		return nav_map_->get_distance(wx, wz);
+	};
+
+	// Border cells (ax, az) + i * (step_x, step_z), paired with the cell
+	// offset by (ox, oz) in cid_b.
+	const Cluster &c = clusters_[cid_a];
+	const bool east = clusters_[cid_b].cz == c.cz;
+	const int ax = east ? c.x1 : c.x0, az = east ? c.z0 : c.z1;
+	const int step_x = east ? 0 : 1, step_z = east ? 1 : 0;
+	const int len = east ? c.z1 - c.z0 + 1 : c.x1 - c.x0 + 1;
+	const int ox = east ? 1 : 0, oz = east ? 0 : 1;
+
+	int best = -1;
+	float best_cl = 0.0f;
+	for (int i = 0; i <= len; ++i) {
+		float cl = -INF;
+		if (i < len) {
+			int gx = ax + i * step_x, gz = az + i * step_z;
+			cl = std::min(cell_sdf(gx, gz), cell_sdf(gx + ox, gz + oz));
+		}
+		if (cl >= clearance_) {
+			if (best < 0 || cl > best_cl) {
+				best = i;
+				best_cl = cl;
+			}
+			continue;
+		}
+		if (best < 0) continue;
+		HpaPortal p;
+		p.cid[0] = cid_a;
+		p.cid[1] = cid_b;
+		p.gx[0] = ax + best * step_x;
+		p.gz[0] = az + best * step_z;
+		p.gx[1] = p.gx[0] + ox;
+		p.gz[1] = p.gz[0] + oz;
+		p.clearance = best_cl;
+		out.push_back(p);
+		best = -1;
+	}
+}
+
+// Intra-cluster edge tables for the clusters flagged in 'rebuild'; every
+// other cluster keeps its table, which stays valid as long as its node set
+// (and so its node order) did not change.  The shared arrays are
+// re-flattened in cluster order either way, so they never hold dead edges.
+void HpaGraph::build_portal_tables(const std::vector<uint8_t> &rebuild) {
+	const int nc = static_cast<int>(clusters_.size());
+	const int nb = static_cast<int>(portal_buckets_.size());
+	const float INF = std::numeric_limits<float>::infinity();
+
+	struct TableBuild {
+		int lo = 0, hi = 0;
+		std::vector<float> costs;
+		std::vector<HpaPortalPath> paths;
+		std::vector<float> points;
+	};
+	std::vector<int> todo;
+	for (int cid = 0; cid < nc; ++cid) {
+		if (rebuild[cid]) todo.push_back(cid);
+	}
+	std::vector<TableBuild> tables(todo.size());
+
+	// One independent cluster per task
+	nav_parallel_for(static_cast<int>(todo.size()), 64, [&](int begin, int end) {
+		std::vector<float> sdf, dist;
+		std::vector<int> parent, chain;
+		for (int ti = begin; ti < end; ++ti) {
+			const int cid = todo[ti];
+			const Cluster &c = clusters_[cid];
+			TableBuild &t = tables[ti];
+			while (t.lo < nb && portal_buckets_[t.lo] <= cluster_min_sdf_[cid]) ++t.lo;
+			t.hi = t.lo;
+			while (t.hi < nb && portal_buckets_[t.hi] <= cluster_max_sdf_[cid]) ++t.hi;
+
+			const int nbeg = cluster_node_begin_[cid];
+			const int k = cluster_node_begin_[cid + 1] - nbeg;
+			if (k < 2 || t.lo == t.hi) continue;
+
+			cluster_cell_sdf(c, sdf);
+			const int w = c.x1 - c.x0 + 1;
+			const int kk = k * k;
+			t.costs.assign(static_cast<size_t>(t.hi - t.lo) * kk, INF);
+			t.paths.assign(t.costs.size(), HpaPortalPath{ 0, 0 });
+
+			for (int b = t.lo; b < t.hi; ++b) {
+				const float bcl = portal_buckets_[b];
+				float *costs = t.costs.data() + static_cast<size_t>(b - t.lo) * kk;
+				HpaPortalPath *paths = t.paths.data() + static_cast<size_t>(b - t.lo) * kk;
+				for (int i = 0; i < k; ++i) {
+					costs[i * k + i] = 0.0f;
+					const int ni = cluster_nodes_[nbeg + i];
+					if (portals_[ni >> 1].clearance < bcl) continue;
+					const int sx = portals_[ni >> 1].gx[ni & 1];
+					const int sz = portals_[ni >> 1].gz[ni & 1];
+					cluster_cell_dijkstra(c, sdf, sx, sz, bcl, dist, parent);
+
+					for (int j = i + 1; j < k; ++j) {
+						const int nj = cluster_nodes_[nbeg + j];
+						if (portals_[nj >> 1].clearance < bcl) continue;
+						const int lj = (portals_[nj >> 1].gz[nj & 1] - c.z0) * w +
+									   (portals_[nj >> 1].gx[nj & 1] - c.x0);
+						if (dist[lj] == INF) continue;
+						costs[i * k + j] = dist[lj];
+						costs[j * k + i] = dist[lj];
+
+						// Cell chain i → j as global cell indices
+						chain.clear();
+						for (int cur = lj; cur >= 0; cur = parent[cur]) {
+							chain.push_back((c.z0 + cur / w) * grid_w_ + (c.x0 + cur % w));
+						}
+						std::reverse(chain.begin(), chain.end());
+						HpaPortalPath &path = paths[i * k + j];
+						path.begin = static_cast<uint32_t>(t.points.size() / 2);
+						pull_cell_chain(chain, bcl, t.points);
+						path.count = static_cast<uint32_t>(t.points.size() / 2) - path.begin;
+					}
 				}
 			}
-			s.max_sdf   = max_sdf;
-			s.min_sdf   = min_sdf;
-			s.navigable = (max_sdf >= clearance_);
 		}
+	});
+
+	// Flatten into the shared arrays, copying the tables that were kept
+	std::vector<HpaPortalTable> old_tables;
+	std::vector<float> old_costs, old_points;
+	std::vector<HpaPortalPath> old_paths;
+	old_tables.swap(portal_tables_);
+	old_costs.swap(portal_costs_);
+	old_paths.swap(portal_paths_);
+	old_points.swap(portal_points_);
+
+	portal_tables_.resize(nc);
+	int ti = 0;
+	for (int cid = 0; cid < nc; ++cid) {
+		HpaPortalTable &pt = portal_tables_[cid];
+		pt.cost_begin = static_cast<uint32_t>(portal_costs_.size());
+		const uint32_t point_base = static_cast<uint32_t>(portal_points_.size() / 2);
+		if (rebuild[cid]) {
+			TableBuild &t = tables[ti++];
+			pt.bucket_lo = t.lo;
+			pt.bucket_hi = t.hi;
+			portal_costs_.insert(portal_costs_.end(), t.costs.begin(), t.costs.end());
+			for (HpaPortalPath path : t.paths) {
+				path.begin += point_base;
+				portal_paths_.push_back(path);
+			}
+			portal_points_.insert(portal_points_.end(), t.points.begin(), t.points.end());
+			continue;
+		}
+
+		const HpaPortalTable &ot = old_tables[cid];
+		pt.bucket_lo = ot.bucket_lo;
+		pt.bucket_hi = ot.bucket_hi;
+		const int k = cluster_node_begin_[cid + 1] - cluster_node_begin_[cid];
+		if (k < 2 || ot.bucket_lo == ot.bucket_hi) continue;
+		const size_t n = static_cast<size_t>(ot.bucket_hi - ot.bucket_lo) * k * k;
+
+		// A cluster's cached points are contiguous; rebase them as a block
+		uint32_t first = std::numeric_limits<uint32_t>::max(), last = 0;
+		for (size_t e = ot.cost_begin; e < ot.cost_begin + n; ++e) {
+			const HpaPortalPath &path = old_paths[e];
+			if (path.count == 0) continue;
+			first = std::min(first, path.begin);
+			last = std::max(last, path.begin + path.count);
+		}
+		portal_costs_.insert(portal_costs_.end(), old_costs.begin() + ot.cost_begin,
+							 old_costs.begin() + ot.cost_begin + n);
+		for (size_t e = ot.cost_begin; e < ot.cost_begin + n; ++e) {
+			HpaPortalPath path = old_paths[e];
+			if (path.count > 0) path.begin = path.begin - first + point_base;
+			else path.begin = point_base;
+			portal_paths_.push_back(path);
+		}
+		if (first < last) {
+			portal_points_.insert(portal_points_.end(), old_points.begin() + static_cast<size_t>(first) * 2,
+								  old_points.begin() + static_cast<size_t>(last) * 2);
+		}
+	}
+}
+
+// ============================================================================
+// sync_portals
+// ============================================================================
+//
+// Incremental build_portals after sync_with_map rescanned the clusters
+// flagged in 'rescanned'.  Only borders touching those clusters are
+// scanned again.  A border whose portals came out identical keeps them;
+// otherwise its old portals become free slots (cid -1), which the new ones
+// reuse, so every other portal node keeps its id.  Edge tables are rebuilt
+// for the rescanned clusters (their SDF changed) and for clusters whose
+// node set changed; the rest are copied.
+//
+int HpaGraph::sync_portals(const std::vector<uint8_t> &rescanned) {
+	const int nc = static_cast<int>(clusters_.size());
+
+	// Borders as (west/north cluster, east/south cluster)
+	std::vector<std::pair<int, int>> borders;
+	for (int cid = 0; cid < nc; ++cid) {
+		if (!rescanned[cid]) continue;
+		const Cluster &c = clusters_[cid];
+		if (c.cx > 0) borders.push_back({ cluster_id(c.cx - 1, c.cz), cid });
+		if (c.cz > 0) borders.push_back({ cluster_id(c.cx, c.cz - 1), cid });
+		if (c.cx + 1 < ncx_) borders.push_back({ cid, cluster_id(c.cx + 1, c.cz) });
+		if (c.cz + 1 < ncz_) borders.push_back({ cid, cluster_id(c.cx, c.cz + 1) });
+	}
+	std::sort(borders.begin(), borders.end());
+	borders.erase(std::unique(borders.begin(), borders.end()), borders.end());
+
+	auto navigable = [&](int cid) { return cluster_max_sdf_[cid] >= clearance_; };
+	auto border_order = [](const HpaPortal &a, const HpaPortal &b) {
+		return a.gx[0] != b.gx[0] ? a.gx[0] < b.gx[0] : a.gz[0] < b.gz[0];
+	};
+	auto same = [](const HpaPortal &a, const HpaPortal &b) {
+		return a.gx[0] == b.gx[0] && a.gz[0] == b.gz[0] && a.clearance == b.clearance;
+	};
+
+	std::vector<uint8_t> rebuild(rescanned);
+	std::vector<HpaPortal> fresh, old;
+	std::vector<int> old_ids;
+	int replaced = 0;
+	for (const auto &border : borders) {
+		const int a = border.first, b = border.second;
+		fresh.clear();
+		if (navigable(a) && navigable(b)) scan_portal_border(a, b, fresh);
+
+		// The node lists still describe the graph before this sync
+		old.clear();
+		old_ids.clear();
+		for (int k = cluster_node_begin_[a]; k < cluster_node_begin_[a + 1]; ++k) {
+			const int node = cluster_nodes_[k];
+			if ((node & 1) != 0 || portals_[node >> 1].cid[1] != b) continue;
+			old_ids.push_back(node >> 1);
+			old.push_back(portals_[node >> 1]);
+		}
+		std::sort(old.begin(), old.end(), border_order);
+		if (old.size() == fresh.size() && std::equal(old.begin(), old.end(), fresh.begin(), same)) continue;
+
+		for (int pi : old_ids) {
+			HpaPortal &p = portals_[pi];
+			p.cid[0] = p.cid[1] = -1;
+			p.clearance = -std::numeric_limits<float>::infinity();
+			free_portals_.push_back(pi);
+		}
+		for (const HpaPortal &p : fresh) {
+			if (free_portals_.empty()) {
+				portals_.push_back(p);
+			} else {
+				portals_[free_portals_.back()] = p;
+				free_portals_.pop_back();
+			}
+		}
+		rebuild[a] = rebuild[b] = 1;
+		replaced += static_cast<int>(fresh.size());
+	}
+
+	collect_portal_nodes();
+	build_portal_tables(rebuild);
+	return replaced;
+}
+
+// Per-cluster node lists from portals_, in node id order; free slots
+// (cid -1) are left out.
+void HpaGraph::collect_portal_nodes() {
+	const int nc = static_cast<int>(clusters_.size());
+	cluster_node_begin_.assign(nc + 1, 0);
+	for (const HpaPortal &p : portals_) {
+		if (p.cid[0] < 0) continue;
+		cluster_node_begin_[p.cid[0] + 1]++;
+		cluster_node_begin_[p.cid[1] + 1]++;
+	}
+	for (int cid = 0; cid < nc; ++cid) {
+		cluster_node_begin_[cid + 1] += cluster_node_begin_[cid];
+	}
+	cluster_nodes_.resize(cluster_node_begin_[nc]);
+	{
+		std::vector<int32_t> cursor(cluster_node_begin_.begin(), cluster_node_begin_.end() - 1);
+		for (int pi = 0; pi < static_cast<int>(portals_.size()); ++pi) {
+			if (portals_[pi].cid[0] < 0) continue;
+			for (int side = 0; side < 2; ++side) {
+				cluster_nodes_[cursor[portals_[pi].cid[side]]++] = pi * 2 + side;
+			}
+		}
+	}
+	index_portal_nodes();
+}
+
+// node id -> index in its cluster's node range (derived, not cached)
+void HpaGraph::index_portal_nodes() {
+	node_local_.assign(portals_.size() * 2, -1);
+	for (int cid = 0; cid + 1 < static_cast<int>(cluster_node_begin_.size()); ++cid) {
+		for (int k = cluster_node_begin_[cid]; k < cluster_node_begin_[cid + 1]; ++k) {
+			node_local_[cluster_nodes_[k]] = k - cluster_node_begin_[cid];
+		}
+	}
+}
+
+// Bounds checks for a portal graph read from the cache
+bool HpaGraph::portals_consistent() const {
+	const int nc = static_cast<int>(clusters_.size());
+	const int nn = static_cast<int>(portals_.size()) * 2;
+	int live = 0;
+	for (const HpaPortal &p : portals_) {
+		if (p.cid[0] >= 0 || p.cid[1] >= 0) live++;
+	}
+	if (portal_buckets_.empty() || static_cast<int>(cluster_node_begin_.size()) != nc + 1 ||
+			static_cast<int>(cluster_nodes_.size()) != live * 2 ||
+			static_cast<int>(portal_tables_.size()) != nc ||
+			portal_paths_.size() != portal_costs_.size()) {
+		return false;
+	}
+	for (const HpaPortal &p : portals_) {
+		if (p.cid[0] < 0 && p.cid[1] < 0) continue;  // free slot
+		for (int side = 0; side < 2; ++side) {
+			if (p.cid[side] < 0 || p.cid[side] >= nc) return false;
+			if (p.gx[side] < 0 || p.gx[side] >= grid_w_ || p.gz[side] < 0 || p.gz[side] >= grid_h_) return false;
+		}
+	}
+	if (cluster_node_begin_[0] != 0 || cluster_node_begin_[nc] != live * 2) return false;
+	for (int cid = 0; cid < nc; ++cid) {
+		const int k = cluster_node_begin_[cid + 1] - cluster_node_begin_[cid];
+		if (k < 0) return false;
+		const HpaPortalTable &t = portal_tables_[cid];
+		if (t.bucket_lo < 0 || t.bucket_hi < t.bucket_lo ||
+				t.bucket_hi > static_cast<int>(portal_buckets_.size())) {
+			return false;
+		}
+		if (k >= 2 && t.bucket_hi > t.bucket_lo &&
+				static_cast<uint64_t>(t.cost_begin) + static_cast<uint64_t>(t.bucket_hi - t.bucket_lo) * k * k >
+				portal_costs_.size()) {
+			return false;
+		}
+	}
+	for (int32_t node : cluster_nodes_) {
+		if (node < 0 || node >= nn || portals_[node >> 1].cid[0] < 0) return false;
+	}
+	const uint64_t npoints = portal_points_.size() / 2;
+	for (const HpaPortalPath &path : portal_paths_) {
+		if (static_cast<uint64_t>(path.begin) + path.count > npoints) return false;
+	}
+	return true;
+}
+
+// ============================================================================
+// sync_with_map
+// ============================================================================
+//
+// Land patches change the SDF under a few clusters; only those (and their
+// subs) are rescanned.  Cluster samples sit at cell centres and read the
+// SDF bilinearly, so the changed cell rect is widened by one cell.
+//
+bool HpaGraph::sync_with_map() {
+	if (!built_ || !nav_map_.is_valid()) return false;
+	uint64_t version = static_cast<uint64_t>(nav_map_->get_version());
+	if (version == map_version_) return false;
+	if (nav_map_->get_grid_width() != grid_w_ || nav_map_->get_grid_height() != grid_h_) {
+		UtilityFunctions::print("[HpaGraph] sync_with_map: map was rebuilt with a different grid; call build()");
+		map_version_ = version;
+		return false;
+	}
+
+	int x0, z0, x1, z1;
+	if (!nav_map_->get_changed_cells_since(map_version_, x0, z0, x1, z1)) {
+		x0 = 0;
+		z0 = 0;
+		x1 = grid_w_ - 1;
+		z1 = grid_h_ - 1;
+	}
+	map_version_ = version;
+	if (x0 > x1 || z0 > z1) return false;
+
+	x0 = std::max(0, x0 - 1);
+	z0 = std::max(0, z0 - 1);
+	x1 = std::min(grid_w_ - 1, x1 + 1);
+	z1 = std::min(grid_h_ - 1, z1 + 1);
+
+	std::unique_lock<std::shared_mutex> lock(structure_mutex_);
+	structure_gen_++;  // cached threat sets depend on cluster navigability
+	int rescanned = 0;
+	std::vector<uint8_t> rescanned_clusters(clusters_.size(), 0);
+	for (int cz = cell_cz(z0); cz <= cell_cz(z1); ++cz) {
+		for (int cx = cell_cx(x0); cx <= cell_cx(x1); ++cx) {
+			const int cid = cluster_id(cx, cz);
+			const Cluster &c = clusters_[cid];
+			scan_sdf_range(c.x0, c.z0, c.x1, c.z1, cluster_min_sdf_[cid], cluster_max_sdf_[cid]);
+			rescanned_clusters[cid] = 1;
+			++rescanned;
+		}
+	}
+	for (int scz = cell_scz(z0); scz <= cell_scz(z1); ++scz) {
+		for (int scx = cell_scx(x0); scx <= cell_scx(x1); ++scx) {
+			const int sid = sub_id(scx, scz);
+			const SubCluster &s = sub_clusters_[sid];
+			if (s.x0 >= grid_w_ || s.z0 >= grid_h_) continue;  // outside the grid
+			scan_sdf_range(s.x0, s.z0, s.x1, s.z1, sub_min_sdf_[sid], sub_max_sdf_[sid]);
+		}
+	}
+
+	int replaced = 0;
+	if (portals_built_) {
+		replaced = sync_portals(rescanned_clusters);
+	} else {
+		build_portals();
 	}
+	clear_route_cache();
+
+	UtilityFunctions::print("[HpaGraph] synced to map version ", static_cast<int64_t>(version),
+							": rescanned ", rescanned, " clusters, ", replaced, " new portals, ",
+							get_portal_count(), " portals");
+	return true;
+}
+
+std::shared_lock<std::shared_mutex> HpaGraph::lock_map_shared() const {
+	if (!nav_map_.is_valid()) return std::shared_lock<std::shared_mutex>();
+	return std::shared_lock<std::shared_mutex>(nav_map_->get_query_mutex());
 }
 
 // ============================================================================
@@ -301,31 +955,170 @@ std::vector<int> HpaGraph::clusters_in_radius(Vector2 pos, float radius) const {
 }
 
 // ============================================================================
-// add_obstacle / remove_obstacle / clear_obstacles
+// Dynamic obstacles
 // ============================================================================
+//
+// cluster_block_count_ is the spatial hash: one bucket per cluster, counting
+// the obstacle footprints over it.  snapshot_obstacles() turns it into the
+// per-cluster obstacle lists a query reads, once per obstacle version.
+//
+
+void HpaGraph::obstacle_footprint(HpaObstacle &obs) const {
+	// Bounding box of the circle now and at the horizon
+	const Vector2 end = obs.pos + obs.vel * obstacle_horizon_;
+	const float cluster_world = static_cast<float>(cluster_size_) * cell_size_;
+	const float wx0 = std::min(obs.pos.x, end.x) - obs.radius;
+	const float wx1 = std::max(obs.pos.x, end.x) + obs.radius;
+	const float wz0 = std::min(obs.pos.y, end.y) - obs.radius;
+	const float wz1 = std::max(obs.pos.y, end.y) + obs.radius;
+	obs.cx0 = std::max(0, static_cast<int>(std::floor((wx0 - min_x_) / cluster_world)));
+	obs.cx1 = std::min(ncx_ - 1, static_cast<int>(std::floor((wx1 - min_x_) / cluster_world)));
+	obs.cz0 = std::max(0, static_cast<int>(std::floor((wz0 - min_z_) / cluster_world)));
+	obs.cz1 = std::min(ncz_ - 1, static_cast<int>(std::floor((wz1 - min_z_) / cluster_world)));
+}
 
-void HpaGraph::add_obstacle(int id, Vector2 pos, float radius) {
+void HpaGraph::add_obstacle(int id, Vector2 pos, float radius, Vector2 velocity) {
+	if (clusters_.empty()) return;
+	auto it = obstacles_.find(id);
+	if (it != obstacles_.end() && it->second.radius == radius) {
+		move_obstacle(id, pos, velocity);
+		return;
+	}
 	remove_obstacle(id);
-	HpaObstacle obs{ id, pos, radius };
-	std::vector<int> cids = clusters_in_radius(pos, radius);
-	for (int cid : cids) cluster_block_count_[cid]++;
+	HpaObstacle obs{ id, pos, velocity, radius, 0, 0, -1, -1 };
+	obstacle_footprint(obs);
+	for (int cz = obs.cz0; cz <= obs.cz1; ++cz)
+		for (int cx = obs.cx0; cx <= obs.cx1; ++cx)
+			cluster_block_count_[cluster_id(cx, cz)]++;
 	obstacles_[id] = obs;
+	obstacle_version_++;
+}
+
+void HpaGraph::move_obstacle(int id, Vector2 pos, Vector2 velocity) {
+	auto it = obstacles_.find(id);
+	if (it == obstacles_.end()) return;
+	HpaObstacle &obs = it->second;
+	const int cx0 = obs.cx0, cz0 = obs.cz0, cx1 = obs.cx1, cz1 = obs.cz1;
+	obs.pos = pos;
+	obs.vel = velocity;
+	obstacle_footprint(obs);
+	if (obs.cx0 != cx0 || obs.cz0 != cz0 || obs.cx1 != cx1 || obs.cz1 != cz1) {
+		for (int cz = cz0; cz <= cz1; ++cz)
+			for (int cx = cx0; cx <= cx1; ++cx)
+				cluster_block_count_[cluster_id(cx, cz)]--;
+		for (int cz = obs.cz0; cz <= obs.cz1; ++cz)
+			for (int cx = obs.cx0; cx <= obs.cx1; ++cx)
+				cluster_block_count_[cluster_id(cx, cz)]++;
+	}
+	obstacle_version_++;
 }
 
 void HpaGraph::remove_obstacle(int id) {
 	auto it = obstacles_.find(id);
 	if (it == obstacles_.end()) return;
 	const HpaObstacle &obs = it->second;
-	std::vector<int> cids = clusters_in_radius(obs.pos, obs.radius);
-	for (int cid : cids)
-		if (cid >= 0 && cid < (int)cluster_block_count_.size())
-			cluster_block_count_[cid] = std::max(0, cluster_block_count_[cid] - 1);
+	for (int cz = obs.cz0; cz <= obs.cz1; ++cz)
+		for (int cx = obs.cx0; cx <= obs.cx1; ++cx)
+			cluster_block_count_[cluster_id(cx, cz)]--;
 	obstacles_.erase(it);
+	obstacle_version_++;
 }
 
 void HpaGraph::clear_obstacles() {
 	std::fill(cluster_block_count_.begin(), cluster_block_count_.end(), 0);
 	obstacles_.clear();
+	obstacle_version_++;
+}
+
+void HpaGraph::set_obstacle_horizon(float seconds) {
+	obstacle_horizon_ = std::max(0.0f, seconds);
+	for (auto &kv : obstacles_) {
+		move_obstacle(kv.first, kv.second.pos, kv.second.vel);
+	}
+	obstacle_version_++;
+}
+
+void HpaGraph::set_obstacle_soft_cost(float metres) {
+	obstacle_soft_cost_ = std::max(0.0f, metres);
+	obstacle_version_++;
+}
+
+std::shared_ptr<const HpaObstacleSet> HpaGraph::snapshot_obstacles() const {
+	if (obstacle_snapshot_ && obstacle_snapshot_version_ == obstacle_version_) {
+		return obstacle_snapshot_;
+	}
+	auto set = std::make_shared<HpaObstacleSet>();
+	set->horizon = obstacle_horizon_;
+	set->soft_cost = obstacle_soft_cost_;
+	const int nc = static_cast<int>(cluster_block_count_.size());
+	set->cluster_begin.assign(nc + 1, 0);
+	for (int cid = 0; cid < nc; ++cid) {
+		set->cluster_begin[cid + 1] = set->cluster_begin[cid] + cluster_block_count_[cid];
+	}
+	set->items.resize(set->cluster_begin[nc]);
+	set->obstacles.reserve(obstacles_.size());
+	std::vector<int32_t> cursor(set->cluster_begin.begin(), set->cluster_begin.end() - 1);
+	for (const auto &kv : obstacles_) {
+		const HpaObstacle &obs = kv.second;
+		const int32_t index = static_cast<int32_t>(set->obstacles.size());
+		set->obstacles.push_back(obs);
+		for (int cz = obs.cz0; cz <= obs.cz1; ++cz)
+			for (int cx = obs.cx0; cx <= obs.cx1; ++cx)
+				set->items[cursor[cluster_id(cx, cz)]++] = index;
+	}
+	obstacle_snapshot_ = std::move(set);
+	obstacle_snapshot_version_ = obstacle_version_;
+	return obstacle_snapshot_;
+}
+
+// Occupancy window of each obstacle listed on the cluster: the times its
+// circle overlaps the cluster box at constant velocity (slab test on the
+// box grown by the radius), clipped to [0, horizon] on entry.  The ship
+// holds the cluster from arrival for one cluster crossing.
+float HpaGraph::obstacle_cost(int cid, float g, const HpaBlockView &view) const {
+	const HpaObstacleSet *set = view.obstacles;
+	if (!set || cid < 0 || cid + 1 >= static_cast<int>(set->cluster_begin.size())) return 0.0f;
+	const int begin = set->cluster_begin[cid];
+	const int end = set->cluster_begin[cid + 1];
+	if (begin == end) return 0.0f;
+
+	const float INF = std::numeric_limits<float>::infinity();
+	const Cluster &c = clusters_[cid];
+	const float bx0 = min_x_ + static_cast<float>(c.x0) * cell_size_;
+	const float bx1 = min_x_ + static_cast<float>(c.x1 + 1) * cell_size_;
+	const float bz0 = min_z_ + static_cast<float>(c.z0) * cell_size_;
+	const float bz1 = min_z_ + static_cast<float>(c.z1 + 1) * cell_size_;
+	const float arrive = (view.speed > 0.0f) ? g / view.speed : 0.0f;
+	const float leave = (view.speed > 0.0f) ? arrive + cardinal_step_cost_ / view.speed : 0.0f;
+
+	auto slab = [](float p, float v, float lo, float hi, float &t0, float &t1) -> bool {
+		if (std::abs(v) < 1e-3f) {
+			t0 = -std::numeric_limits<float>::infinity();
+			t1 = std::numeric_limits<float>::infinity();
+			return p >= lo && p <= hi;
+		}
+		t0 = (lo - p) / v;
+		t1 = (hi - p) / v;
+		if (t0 > t1) std::swap(t0, t1);
+		return true;
+	};
+
+	float cost = 0.0f;
+	for (int k = begin; k < end; ++k) {
+		const HpaObstacle &obs = set->obstacles[set->items[k]];
+		float tx0, tx1, tz0, tz1;
+		if (!slab(obs.pos.x, obs.vel.x, bx0 - obs.radius, bx1 + obs.radius, tx0, tx1)) continue;
+		if (!slab(obs.pos.y, obs.vel.y, bz0 - obs.radius, bz1 + obs.radius, tz0, tz1)) continue;
+		const float t_in = std::max({ tx0, tz0, 0.0f });
+		const float t_out = std::min(tx1, tz1);
+		if (t_out < t_in || t_in > set->horizon) continue;
+		if (t_in > leave || t_out < arrive) continue;
+
+		const float wait = (view.speed > 0.0f && t_out < INF) ? (t_out - arrive) * view.speed : INF;
+		cost = std::max(cost, std::min(wait, set->soft_cost));
+		if (cost >= set->soft_cost) break;
+	}
+	return cost;
 }
 
 // ============================================================================
@@ -334,7 +1127,8 @@ void HpaGraph::clear_obstacles() {
 // Clusters with max_sdf < q_cl are impassable for this ship.
 // ============================================================================
 
-std::vector<int> HpaGraph::cluster_astar(int from_cid, int to_cid, float q_cl) const {
+std::vector<int> HpaGraph::cluster_astar(int from_cid, int to_cid, float q_cl,
+										const HpaBlockView &view) const {
 	if (from_cid == to_cid) return { from_cid };
 	if (from_cid < 0 || to_cid < 0 ||
 		from_cid >= (int)clusters_.size() ||
@@ -347,62 +1141,67 @@ std::vector<int> HpaGraph::cluster_astar(int from_cid, int to_cid, float q_cl) c
 	std::vector<int>   parent(N, -1);
 	std::vector<bool>  closed(N, false);
 
-	const Cluster &goal_c = clusters_[to_cid];
+	// Straight-line distance in cluster steps, from the grid coordinates
+	// alone so expansions never touch clusters_
+	const int goal_cx = to_cid % ncx_;
+	const int goal_cz = to_cid / ncx_;
 	auto heur = [&](int cid) -> float {
-		const Cluster &c = clusters_[cid];
-		float dx = c.wx_center - goal_c.wx_center;
-		float dz = c.wz_center - goal_c.wz_center;
-		return std::sqrt(dx * dx + dz * dz);
+		float dx = static_cast<float>(cid % ncx_ - goal_cx);
+		float dz = static_cast<float>(cid / ncx_ - goal_cz);
+		return cardinal_step_cost_ * std::sqrt(dx * dx + dz * dz);
 	};
+	const float *max_sdf = cluster_max_sdf_.data();
 
-	using PQ = std::pair<float, int>;
-	std::priority_queue<PQ, std::vector<PQ>, std::greater<PQ>> open;
+	NavQuadHeap open;
+	open.reserve_ids(N);
 
 	g[from_cid] = 0.0f;
-	open.push({ heur(from_cid), from_cid });
+	open.push(from_cid, heur(from_cid));
 
 	while (!open.empty()) {
-		auto [f, cur] = open.top(); open.pop();
+		auto [f, cur] = open.pop();
 		if (closed[cur]) continue;
 		closed[cur] = true;
 		if (cur == to_cid) break;
 
-		const Cluster &cc = clusters_[cur];
+		const int cur_cx = cur % ncx_;
+		const int cur_cz = cur / ncx_;
 
 		for (int dz = -1; dz <= 1; ++dz) {
 			for (int dx = -1; dx <= 1; ++dx) {
 				if (dx == 0 && dz == 0) continue;
 
-				int ncx = cc.cx + dx;
-				int ncz = cc.cz + dz;
+				int ncx = cur_cx + dx;
+				int ncz = cur_cz + dz;
 				if (ncx < 0 || ncx >= ncx_ || ncz < 0 || ncz >= ncz_) continue;
 
 				int ncid = cluster_id(ncx, ncz);
 				if (closed[ncid]) continue;
 
 				// Impassable: no navigable cell for this ship's clearance.
-				if (clusters_[ncid].max_sdf < q_cl) continue;
+				if (max_sdf[ncid] < q_cl) continue;
 
-				// Blocked by obstacle / threat (allow reaching the goal cluster).
-				if (ncid != to_cid && cluster_blocked(ncid)) continue;
+				// Blocked by threat (allow reaching the goal cluster).
+				if (ncid != to_cid && cluster_blocked(ncid, view)) continue;
 
 				// Diagonal: both cardinal neighbours must also be passable
 				// to prevent cutting through impassable corners.
 				bool is_diag = (dx != 0 && dz != 0);
 				if (is_diag) {
-					int cid_x = cluster_id(cc.cx + dx, cc.cz);
-					int cid_z = cluster_id(cc.cx,      cc.cz + dz);
-					if (clusters_[cid_x].max_sdf < q_cl) continue;
-					if (clusters_[cid_z].max_sdf < q_cl) continue;
+					int cid_x = cluster_id(cur_cx + dx, cur_cz);
+					int cid_z = cluster_id(cur_cx,      cur_cz + dz);
+					if (max_sdf[cid_x] < q_cl) continue;
+					if (max_sdf[cid_z] < q_cl) continue;
 				}
 
 				float step_cost = is_diag ? diagonal_step_cost_ : cardinal_step_cost_;
 				float ng = g[cur] + step_cost;
+				if (ncid != to_cid) ng += obstacle_cost(ncid, g[cur], view);
 
 				if (ng < g[ncid]) {
 					g[ncid] = ng;
 					parent[ncid] = cur;
-					open.push({ ng + heur(ncid), ncid });
+					open.push(ncid, ng + heur(ncid));
 				}
 			}
 		}
@@ -429,7 +1228,8 @@ std::vector<int> HpaGraph::cluster_astar(int from_cid, int to_cid, float q_cl) c
 
 std::vector<int> HpaGraph::sub_cluster_astar(
 		int from_sid, int to_sid, float q_cl,
-		const std::vector<uint8_t>* allowed_macros) const {
+		const HpaBlockView &view,
+		const HpaClusterBits *allowed_macros) const {
 	if (from_sid == to_sid) return { from_sid };
 	const int N = static_cast<int>(sub_clusters_.size());
 	if (from_sid < 0 || to_sid < 0 || from_sid >= N || to_sid >= N) return {};
@@ -444,85 +1244,90 @@ std::vector<int> HpaGraph::sub_cluster_astar(
 	std::vector<int>   parent(N, -1);
 	std::vector<bool>  closed(N, false);
 
-	const SubCluster &goal_s = sub_clusters_[to_sid];
+	// Grid-coordinate heuristic, as in cluster_astar
+	const int goal_scx = to_sid % nsubx_;
+	const int goal_scz = to_sid / nsubx_;
 	auto heur = [&](int sid) -> float {
-		const SubCluster &s = sub_clusters_[sid];
-		float dx = s.wx_center - goal_s.wx_center;
-		float dz = s.wz_center - goal_s.wz_center;
-		return std::sqrt(dx * dx + dz * dz);
-	};
-
-	auto macro_allowed = [&](int parent_cid) -> bool {
-		if (!allowed_macros) return true;
-		if (parent_cid < 0 || parent_cid >= static_cast<int>(allowed_macros->size())) return false;
-		return (*allowed_macros)[parent_cid] != 0;
+		float dx = static_cast<float>(sid % nsubx_ - goal_scx);
+		float dz = static_cast<float>(sid / nsubx_ - goal_scz);
+		return sub_card * std::sqrt(dx * dx + dz * dz);
 	};
+	const float *max_sdf = sub_max_sdf_.data();
 
 	// The goal sub may legitimately lie in a non-allowed macro (e.g. start/goal
 	// pinned to a coastal macro the abstract pass excluded); waive the corridor
 	// rule for from_sid and to_sid only.
-	auto sub_passable = [&](int sid) -> bool {
-		const SubCluster &s = sub_clusters_[sid];
-		if (s.max_sdf < q_cl) return false;
+	auto sub_passable = [&](int sid, int scx, int scz) -> bool {
+		if (max_sdf[sid] < q_cl) return false;
 		if (sid == from_sid || sid == to_sid) return true;
-		if (!macro_allowed(s.parent_cid)) return false;
-		// Re-use macro-level obstacle/threat blocking.  A sub inside a blocked
-		// macro is blocked too — except when it's the goal sub (mirror of the
-		// macro A* rule that lets the path reach a blocked goal).
-		if (cluster_blocked(s.parent_cid)) return false;
+		const int parent_cid = sub_parent_cid(scx, scz);
+		if (allowed_macros && !allowed_macros->test(parent_cid)) return false;
+		// Re-use macro-level threat blocking.  A sub inside a blocked macro is
+		// blocked too — except when it's the goal sub (mirror of the macro A*
+		// rule that lets the path reach a blocked goal).
+		if (cluster_blocked(parent_cid, view)) return false;
 		return true;
 	};
 
-	if (!sub_passable(from_sid) && from_sid != to_sid) {
+	// Obstacles are charged on entering another macro, except the start's
+	// and goal's own
+	const int from_parent = sub_parent_cid(from_sid % nsubx_, from_sid / nsubx_);
+	const int to_parent = sub_parent_cid(to_sid % nsubx_, to_sid / nsubx_);
+
+	if (!sub_passable(from_sid, from_sid % nsubx_, from_sid / nsubx_) && from_sid != to_sid) {
 		// from_sid impassable on its own merits (max_sdf < q_cl) — caller must
 		// have picked a bad start.  Bail rather than silently routing nowhere.
 		return {};
 	}
 
-	using PQ = std::pair<float, int>;
-	std::priority_queue<PQ, std::vector<PQ>, std::greater<PQ>> open;
+	NavQuadHeap open;
+	open.reserve_ids(N);
 
 	g[from_sid] = 0.0f;
-	open.push({ heur(from_sid), from_sid });
+	open.push(from_sid, heur(from_sid));
 
 	while (!open.empty()) {
-		auto [f, cur] = open.top(); open.pop();
+		auto [f, cur] = open.pop();
 		if (closed[cur]) continue;
 		closed[cur] = true;
 		if (cur == to_sid) break;
 
-		const SubCluster &cs = sub_clusters_[cur];
+		const int cur_scx = cur % nsubx_;
+		const int cur_scz = cur / nsubx_;
+		const int cur_parent = sub_parent_cid(cur_scx, cur_scz);
 
 		for (int dz = -1; dz <= 1; ++dz) {
 			for (int dx = -1; dx <= 1; ++dx) {
 				if (dx == 0 && dz == 0) continue;
 
-				int nscx = cs.scx + dx;
-				int nscz = cs.scz + dz;
+				int nscx = cur_scx + dx;
+				int nscz = cur_scz + dz;
 				if (nscx < 0 || nscx >= nsubx_ || nscz < 0 || nscz >= nsubz_) continue;
 
 				int nsid = sub_id(nscx, nscz);
 				if (closed[nsid]) continue;
-				if (!sub_passable(nsid)) continue;
+				if (!sub_passable(nsid, nscx, nscz)) continue;
 
 				// Diagonal corner-cutting rule: both cardinal neighbours must
 				// also be passable, otherwise we'd slip through an impassable
 				// corner that the ship physically cannot fit through.
 				bool is_diag = (dx != 0 && dz != 0);
 				if (is_diag) {
-					int sid_x = sub_id(cs.scx + dx, cs.scz);
-					int sid_z = sub_id(cs.scx,      cs.scz + dz);
-					if (!sub_passable(sid_x)) continue;
-					if (!sub_passable(sid_z)) continue;
+					if (!sub_passable(sub_id(nscx, cur_scz), nscx, cur_scz)) continue;
+					if (!sub_passable(sub_id(cur_scx, nscz), cur_scx, nscz)) continue;
 				}
 
 				float step_cost = is_diag ? sub_diag : sub_card;
 				float ng = g[cur] + step_cost;
+				const int nparent = sub_parent_cid(nscx, nscz);
+				if (nparent != cur_parent && nparent != from_parent && nparent != to_parent) {
+					ng += obstacle_cost(nparent, g[cur], view);
+				}
 
 				if (ng < g[nsid]) {
 					g[nsid] = ng;
 					parent[nsid] = cur;
-					open.push({ ng + heur(nsid), nsid });
+					open.push(nsid, ng + heur(nsid));
 				}
 			}
 		}
@@ -545,19 +1350,14 @@ std::vector<int> HpaGraph::sub_cluster_astar(
 
 PathResult HpaGraph::constrained_cell_astar(
 		Vector2 from, Vector2 to, float q_cl,
-		const std::vector<uint8_t> &allowed_macros) const {
+		const HpaClusterBits &allowed_macros,
+		const HpaBlockView &view) const {
 	PathResult result;
 	result.valid = false;
 	result.total_distance = 0.0f;
 
 	if (!built_ || !nav_map_.is_valid()) return result;
 
-	auto world_to_gx = [&](float wx) -> int {
-		return std::max(0, std::min(static_cast<int>((wx - min_x_) / cell_size_), grid_w_ - 1));
-	};
-	auto world_to_gz = [&](float wz) -> int {
-		return std::max(0, std::min(static_cast<int>((wz - min_z_) / cell_size_), grid_h_ - 1));
-	};
 	auto idx = [&](int gx, int gz) -> int { return gz * grid_w_ + gx; };
 
 	int sx = world_to_gx(from.x), sz = world_to_gz(from.y);
@@ -565,16 +1365,13 @@ PathResult HpaGraph::constrained_cell_astar(
 	const int start_idx = idx(sx, sz);
 	const int end_idx = idx(ex, ez);
 
-	auto macro_allowed = [&](int cid) -> bool {
-		return cid >= 0 && cid < static_cast<int>(allowed_macros.size()) && allowed_macros[cid] != 0;
-	};
 	auto cell_allowed = [&](int gx, int gz) -> bool {
 		if (gx < 0 || gx >= grid_w_ || gz < 0 || gz >= grid_h_) return false;
 		int cidx = idx(gx, gz);
 		int cid = cluster_id(cell_cx(gx), cell_cz(gz));
 		if (cidx != start_idx && cidx != end_idx) {
-			if (!macro_allowed(cid)) return false;
-			if (cluster_blocked(cid)) return false;
+			if (!allowed_macros.test(cid)) return false;
+			if (cluster_blocked(cid, view)) return false;
 		}
 		return nav_map_->get_distance(
 			min_x_ + (static_cast<float>(gx) + 0.5f) * cell_size_,
@@ -643,17 +1440,17 @@ PathResult HpaGraph::constrained_cell_astar(
 		return std::sqrt(dx * dx + dz * dz);
 	};
 
-	using PQ = std::pair<float, int>;
-	std::priority_queue<PQ, std::vector<PQ>, std::greater<PQ>> open;
+	NavQuadHeap open;
+	open.reserve_ids(total);
 	g[start_idx] = 0.0f;
 	parent[start_idx] = start_idx;
-	open.push({ heur(sx, sz), start_idx });
+	open.push(start_idx, heur(sx, sz));
 
 	const int dx8[] = {-1, 0, 1, -1, 1, -1, 0, 1};
 	const int dz8[] = {-1, -1, -1, 0, 0, 1, 1, 1};
 
 	while (!open.empty()) {
-		auto [f, cur] = open.top(); open.pop();
+		auto [f, cur] = open.pop();
 		if (closed[cur]) continue;
 		closed[cur] = 1;
 		if (cur == end_idx) break;
@@ -679,7 +1476,7 @@ PathResult HpaGraph::constrained_cell_astar(
 			if (ng < g[nidx]) {
 				g[nidx] = ng;
 				parent[nidx] = cur;
-				open.push({ ng + heur(nx, nz), nidx });
+				open.push(nidx, ng + heur(nx, nz));
 			}
 		}
 	}
@@ -725,59 +1522,449 @@ PathResult HpaGraph::constrained_cell_astar(
 }
 
 // ============================================================================
-// find_path
+// Portal graph queries
 // ============================================================================
 
-PathResult HpaGraph::find_path(Vector2 from, Vector2 to, float query_clearance) const {
-	using Clock = std::chrono::steady_clock;
-	auto query_t0 = Clock::now();
-
-	// Timing buckets (kept for perf metrics compatibility).
-	float connect_us   = 0.0f;   // guide-point LOS / local A* time
-	float abstract_us  = 0.0f;   // cluster A* time
-	float refine_us    = 0.0f;   // path assembly + string-pull time
-	float start_connect_us = 0.0f;
-	float goal_connect_us  = 0.0f;
+int HpaGraph::portal_bucket(float q_cl) const {
+	auto it = std::lower_bound(portal_buckets_.begin(), portal_buckets_.end(), q_cl);
+	return (it == portal_buckets_.end()) ? -1 : static_cast<int>(it - portal_buckets_.begin());
+}
 
-	// Repurposed counters (names kept for GDScript perf-metrics compat).
-	int connector_los_attempts      = 0;  // total LOS checks
-	int connector_los_hits          = 0;  // LOS checks that passed
-	int connector_local_search_runs = 0;  // local A* calls
-	int connector_local_expansions  = 0;  // unused
-	int connector_portal_candidates = 0;  // unused
+float HpaGraph::portal_edge_cost(int cid, int bucket, int i, int j,
+								 const HpaPortalPath **path) const {
+	*path = nullptr;
+	const HpaPortalTable &t = portal_tables_[cid];
+	const int nbeg = cluster_node_begin_[cid];
+	if (bucket < t.bucket_lo) {
+		// Open water at this clearance — straight across the cluster
+		const int ni = cluster_nodes_[nbeg + i];
+		const int nj = cluster_nodes_[nbeg + j];
+		const HpaPortal &pi = portals_[ni >> 1];
+		const HpaPortal &pj = portals_[nj >> 1];
+		float dx = static_cast<float>(pi.gx[ni & 1] - pj.gx[nj & 1]);
+		float dz = static_cast<float>(pi.gz[ni & 1] - pj.gz[nj & 1]);
+		return std::sqrt(dx * dx + dz * dz) * cell_size_;
+	}
+	if (bucket >= t.bucket_hi) return std::numeric_limits<float>::infinity();
 
-	PathResult no_path;
-	no_path.valid          = false;
-	no_path.total_distance = 0.0f;
+	const int k = cluster_node_begin_[cid + 1] - nbeg;
+	const size_t e = t.cost_begin + static_cast<size_t>(bucket - t.bucket_lo) * k * k +
+					 static_cast<size_t>(std::min(i, j)) * k + std::max(i, j);
+	*path = &portal_paths_[e];
+	return portal_costs_[e];
+}
 
-	// ── Performance tracking lambda (unchanged from original) ──────────────
-	auto finalize_query = [&](PathResult r) -> PathResult {
-		if (!perf_tracking_enabled_) return r;
+void HpaGraph::cluster_cell_sdf(const Cluster &c, std::vector<float> &sdf) const {
+	const int w = c.x1 - c.x0 + 1;
+	const int h = c.z1 - c.z0 + 1;
+	sdf.resize(static_cast<size_t>(w) * h);
+	for (int lz = 0; lz < h; ++lz) {
+		for (int lx = 0; lx < w; ++lx) {
+			float wx, wz;
+			grid_to_world(c.x0 + lx, c.z0 + lz, wx, wz);
+			sdf[lz * w + lx] = nav_map_->get_distance(wx, wz);
+		}
+	}
+}
 
-		auto query_t1 = Clock::now();
-		float total_us = std::chrono::duration<float, std::micro>(query_t1 - query_t0).count();
+void HpaGraph::cluster_cell_dijkstra(const Cluster &c, const std::vector<float> &sdf,
+									 int sx, int sz, float clearance,
+									 std::vector<float> &dist, std::vector<int> &parent) const {
+	const int w = c.x1 - c.x0 + 1;
+	const int h = c.z1 - c.z0 + 1;
+	const int n = w * h;
+	dist.assign(n, std::numeric_limits<float>::infinity());
+	parent.assign(n, -1);
+
+	auto passable = [&](int lx, int lz) -> bool {
+		return lx >= 0 && lx < w && lz >= 0 && lz < h && sdf[lz * w + lx] >= clearance;
+	};
 
-		perf_.query_count++;
-		if (r.valid) perf_.success_count++;
-		else         perf_.failure_count++;
+	const float card = cell_size_;
+	const float diag = cell_size_ * 1.41421356237f;
+	const int dx8[] = {-1, 0, 1, -1, 1, -1, 0, 1};
+	const int dz8[] = {-1, -1, -1, 0, 0, 1, 1, 1};
 
-		perf_.last_total_us         = total_us;
-		perf_.last_connect_us       = connect_us;
-		perf_.last_abstract_us      = abstract_us;
-		perf_.last_refine_us        = refine_us;
-		perf_.last_start_connect_us = start_connect_us;
-		perf_.last_goal_connect_us  = goal_connect_us;
+	NavQuadHeap open;
+	open.reserve_ids(n);
+	const int src = (sz - c.z0) * w + (sx - c.x0);
+	dist[src] = 0.0f;
+	open.push(src, 0.0f);
 
-		perf_.last_connector_los_attempts      = connector_los_attempts;
-		perf_.last_connector_los_hits          = connector_los_hits;
-		perf_.last_connector_local_search_runs = connector_local_search_runs;
-		perf_.last_connector_local_expansions  = connector_local_expansions;
-		perf_.last_connector_portal_candidates = connector_portal_candidates;
+	while (!open.empty()) {
+		auto [d, cur] = open.pop();
+		const int lx = cur % w;
+		const int lz = cur / w;
+		for (int k = 0; k < 8; ++k) {
+			const int nx = lx + dx8[k];
+			const int nz = lz + dz8[k];
+			if (!passable(nx, nz)) continue;
+			const bool is_diag = (dx8[k] != 0 && dz8[k] != 0);
+			if (is_diag && (!passable(lx + dx8[k], lz) || !passable(lx, lz + dz8[k]))) continue;
+			const int ni = nz * w + nx;
+			const float nd = d + (is_diag ? diag : card);
+			if (nd < dist[ni]) {
+				dist[ni] = nd;
+				parent[ni] = cur;
+				open.push(ni, nd);
+			}
+		}
+	}
+}
 
-		auto update_ema = [&](float &ema, float sample) {
-			if (perf_.query_count <= 1) ema = sample;
-			else ema = ema * 0.9f + sample * 0.1f;
-		};
+void HpaGraph::pull_cell_chain(const std::vector<int> &cells, float clearance,
+							   std::vector<float> &out) const {
+	const size_t n = cells.size();
+	size_t anchor = 0;
+	while (anchor + 1 < n) {
+		const int ax = cells[anchor] % grid_w_, az = cells[anchor] / grid_w_;
+		size_t farthest = anchor + 1;
+		for (size_t test = n - 1; test > anchor + 1; --test) {
+			// Both directions: supercover LOS is not symmetric and cached
+			// intra paths are walked either way
+			const int bx = cells[test] % grid_w_, bz = cells[test] / grid_w_;
+			if (nav_map_->line_of_sight(ax, az, bx, bz, clearance) &&
+				nav_map_->line_of_sight(bx, bz, ax, az, clearance)) {
+				farthest = test;
+				break;
+			}
+		}
+		if (farthest + 1 < n) {
+			float wx, wz;
+			grid_to_world(cells[farthest] % grid_w_, cells[farthest] / grid_w_, wx, wz);
+			out.push_back(wx);
+			out.push_back(wz);
+		}
+		anchor = farthest;
+	}
+}
+
+// ============================================================================
+// portal_route
+// ============================================================================
+//
+// A* over portal nodes at the smallest bucket >= q_cl; bucket costs are
+// conservative (a bucket path is valid for any smaller clearance).  The
+// start and goal connect to the portals of their own clusters through a
+// cell Dijkstra at q_cl.  Node ids 0..2P-1 are portal nodes, 2P is the goal.
+// A node in a blocked cluster is only entered when that cluster is the
+// start or goal cluster, mirroring cluster_astar; crossing a portal into
+// any other cluster adds its obstacle cost.
+//
+bool HpaGraph::portal_route(Vector2 from, Vector2 to, float q_cl,
+							int from_cid, int to_cid, const HpaBlockView &view,
+							std::vector<Vector2> &route, int &expanded) const {
+	const int bucket = portal_bucket(q_cl);
+	if (bucket < 0 || portals_.empty()) return false;
+
+	const float INF = std::numeric_limits<float>::infinity();
+
+	const Cluster &from_c = clusters_[from_cid];
+	const Cluster &to_c   = clusters_[to_cid];
+	std::vector<float> sdf, start_dist, goal_dist;
+	std::vector<int> start_parent, goal_parent;
+	cluster_cell_sdf(from_c, sdf);
+	cluster_cell_dijkstra(from_c, sdf, world_to_gx(from.x), world_to_gz(from.y), q_cl,
+						  start_dist, start_parent);
+	cluster_cell_sdf(to_c, sdf);
+	cluster_cell_dijkstra(to_c, sdf, world_to_gx(to.x), world_to_gz(to.y), q_cl,
+						  goal_dist, goal_parent);
+
+	auto node_cluster = [&](int node) -> int { return portals_[node >> 1].cid[node & 1]; };
+	auto node_gx = [&](int node) -> int { return portals_[node >> 1].gx[node & 1]; };
+	auto node_gz = [&](int node) -> int { return portals_[node >> 1].gz[node & 1]; };
+	auto local_cell = [&](const Cluster &c, int node) -> int {
+		return (node_gz(node) - c.z0) * (c.x1 - c.x0 + 1) + (node_gx(node) - c.x0);
+	};
+	auto node_pos = [&](int node) -> Vector2 {
+		float wx, wz;
+		grid_to_world(node_gx(node), node_gz(node), wx, wz);
+		return Vector2(wx, wz);
+	};
+	auto enterable = [&](int cid) -> bool {
+		return cid == from_cid || cid == to_cid || !cluster_blocked(cid, view);
+	};
+
+	// ── Route cache ──
+	// Sets built outside get_threat_set() have no id and are not cached
+	const bool cacheable = route_cache_capacity_ > 0 &&
+		!(view.threats && view.threats->id == 0 && !view.threats->cids.empty());
+	const RouteKey key{ from_cid, to_cid, bucket, view.threats ? view.threats->id : 0 };
+
+	std::vector<int32_t> nodes;
+	std::vector<Vector2> corridor;
+	if (cacheable) {
+		std::lock_guard<std::mutex> lock(route_cache_mutex_);
+		auto it = route_cache_.find(key);
+		if (it == route_cache_.end()) {
+			route_cache_misses_++;
+		} else {
+			const CachedRoute &entry = it->second;
+			float g = start_dist[local_cell(from_c, entry.nodes.front())];
+			bool usable = portals_[entry.nodes.front() >> 1].clearance >= q_cl &&
+						  g < INF && goal_dist[local_cell(to_c, entry.nodes.back())] < INF;
+			// The entry was planned around the obstacles of its time; any
+			// cluster on it occupied now is a replan.  Portal clearances are
+			// continuous while buckets are coarse, so every crossing is
+			// rechecked against this query's clearance too.
+			for (size_t n = 0; usable && n < entry.nodes.size(); ++n) {
+				const int node = entry.nodes[n];
+				const int cid = node_cluster(node);
+				if (n > 0) {
+					const int prev = entry.nodes[n - 1];
+					if (node == (prev ^ 1) && portals_[node >> 1].clearance < q_cl) {
+						usable = false;
+						break;
+					}
+					g += node_pos(prev).distance_to(node_pos(node));
+				}
+				usable = enterable(cid) &&
+					(cid == from_cid || cid == to_cid || obstacle_cost(cid, g, view) == 0.0f);
+			}
+			if (usable) {
+				nodes = entry.nodes;
+				corridor = entry.corridor;
+				route_lru_.splice(route_lru_.begin(), route_lru_, entry.lru);
+				route_cache_hits_++;
+			} else {
+				route_cache_stale_++;
+			}
+		}
+	}
+
+	// ── A* over the portal nodes ──
+	if (nodes.empty()) {
+		const int N = static_cast<int>(portals_.size()) * 2;
+		const int GOAL = N;
+		std::vector<float> g(N + 1, INF);
+		std::vector<int> parent(N + 1, -1);  // -1 on a node = joined from the start
+		std::vector<uint8_t> closed(N + 1, 0);
+
+		NavQuadHeap open;
+		open.reserve_ids(N + 1);
+		auto relax = [&](int node, int from_node, float ng) {
+			if (closed[node] || !(ng < g[node])) return;
+			g[node] = ng;
+			parent[node] = from_node;
+			open.push(node, ng + (node == GOAL ? 0.0f : node_pos(node).distance_to(to)));
+		};
+
+		for (int k = cluster_node_begin_[from_cid]; k < cluster_node_begin_[from_cid + 1]; ++k) {
+			const int node = cluster_nodes_[k];
+			if (portals_[node >> 1].clearance < q_cl) continue;
+			relax(node, -1, start_dist[local_cell(from_c, node)]);
+		}
+
+		while (!open.empty()) {
+			const int u = open.pop().second;
+			closed[u] = 1;
+			if (u == GOAL) break;
+			expanded++;
+
+			const int cid = node_cluster(u);
+			if (cid == to_cid) {
+				relax(GOAL, u, g[u] + goal_dist[local_cell(to_c, u)]);
+			}
+
+			// Cross the portal
+			const int v = u ^ 1;
+			const int vcid = node_cluster(v);
+			if (portals_[u >> 1].clearance >= q_cl && enterable(vcid)) {
+				float ng = g[u] + cell_size_;
+				if (vcid != from_cid && vcid != to_cid) ng += obstacle_cost(vcid, g[u], view);
+				relax(v, u, ng);
+			}
+
+			// Intra-cluster edges at the query's bucket
+			const int nbeg = cluster_node_begin_[cid];
+			const int k = cluster_node_begin_[cid + 1] - nbeg;
+			const int li = node_local_[u];
+			for (int j = 0; j < k; ++j) {
+				if (j == li) continue;
+				const HpaPortalPath *path;
+				float cost = portal_edge_cost(cid, bucket, li, j, &path);
+				if (cost == INF) continue;
+				relax(cluster_nodes_[nbeg + j], u, g[u] + cost);
+			}
+		}
+		if (g[GOAL] == INF) return false;
+
+		for (int node = parent[GOAL]; node >= 0; node = parent[node]) {
+			nodes.push_back(node);
+		}
+		std::reverse(nodes.begin(), nodes.end());
+
+		// Corridor: portal nodes joined by the cached intra-cluster paths
+		corridor.push_back(node_pos(nodes.front()));
+		for (size_t n = 1; n < nodes.size(); ++n) {
+			const int a = nodes[n - 1];
+			const int b = nodes[n];
+			const int cid = node_cluster(a);
+			if (cid == node_cluster(b)) {
+				const HpaPortalPath *path;
+				portal_edge_cost(cid, bucket, node_local_[a], node_local_[b], &path);
+				if (path && path->count > 0) {
+					const float *pts = portal_points_.data() + static_cast<size_t>(path->begin) * 2;
+					if (node_local_[a] < node_local_[b]) {
+						for (uint32_t p = 0; p < path->count; ++p) corridor.emplace_back(pts[p * 2], pts[p * 2 + 1]);
+					} else {
+						for (uint32_t p = path->count; p-- > 0;) corridor.emplace_back(pts[p * 2], pts[p * 2 + 1]);
+					}
+				}
+			}
+			corridor.push_back(node_pos(b));
+		}
+
+		if (cacheable) {
+			std::lock_guard<std::mutex> lock(route_cache_mutex_);
+			auto it = route_cache_.find(key);
+			if (it != route_cache_.end()) {
+				// Stale entry, or another thread planned the same pair meanwhile
+				it->second.nodes = nodes;
+				it->second.corridor = corridor;
+				route_lru_.splice(route_lru_.begin(), route_lru_, it->second.lru);
+			} else {
+				route_lru_.push_front(key);
+				CachedRoute &entry = route_cache_[key];
+				entry.nodes = nodes;
+				entry.corridor = corridor;
+				entry.lru = route_lru_.begin();
+				while (static_cast<int>(route_cache_.size()) > route_cache_capacity_) {
+					route_cache_.erase(route_lru_.back());
+					route_lru_.pop_back();
+					route_cache_evictions_++;
+				}
+			}
+		}
+	}
+
+	// ── Start leg + corridor + goal leg ──
+	std::vector<float> points;
+	std::vector<int> chain;
+	auto append_points = [&]() {
+		for (size_t p = 0; p + 1 < points.size(); p += 2) {
+			route.emplace_back(points[p], points[p + 1]);
+		}
+	};
+	auto connection_chain = [&](const Cluster &c, const std::vector<int> &tree, int node) {
+		// Cells from the node back to the Dijkstra source (global indices)
+		const int w = c.x1 - c.x0 + 1;
+		chain.clear();
+		for (int cur = local_cell(c, node); cur >= 0; cur = tree[cur]) {
+			chain.push_back((c.z0 + cur / w) * grid_w_ + (c.x0 + cur % w));
+		}
+	};
+
+	route.clear();
+	route.push_back(from);
+	connection_chain(from_c, start_parent, nodes.front());
+	std::reverse(chain.begin(), chain.end());
+	pull_cell_chain(chain, q_cl, points);
+	append_points();
+	route.insert(route.end(), corridor.begin(), corridor.end());
+
+	points.clear();
+	connection_chain(to_c, goal_parent, nodes.back());
+	pull_cell_chain(chain, q_cl, points);
+	append_points();
+	route.push_back(to);
+	return true;
+}
+
+// ============================================================================
+// Route cache
+// ============================================================================
+
+void HpaGraph::set_route_cache_capacity(int capacity) {
+	std::lock_guard<std::mutex> lock(route_cache_mutex_);
+	route_cache_capacity_ = std::max(0, capacity);
+	while (static_cast<int>(route_cache_.size()) > route_cache_capacity_) {
+		route_cache_.erase(route_lru_.back());
+		route_lru_.pop_back();
+		route_cache_evictions_++;
+	}
+}
+
+void HpaGraph::clear_route_cache() {
+	std::lock_guard<std::mutex> lock(route_cache_mutex_);
+	route_cache_.clear();
+	route_lru_.clear();
+}
+
+// ============================================================================
+// find_path
+// ============================================================================
+
+PathResult HpaGraph::find_path(Vector2 from, Vector2 to, float query_clearance) const {
+	std::shared_ptr<const HpaObstacleSet> obstacles = snapshot_obstacles();
+	HpaBlockView view;
+	view.obstacles = obstacles.get();
+	return find_path(from, to, query_clearance, view);
+}
+
+PathResult HpaGraph::find_path(Vector2 from, Vector2 to, float query_clearance,
+							   const HpaThreatSet &threats) const {
+	std::shared_ptr<const HpaObstacleSet> obstacles = snapshot_obstacles();
+	HpaBlockView view;
+	view.obstacles = obstacles.get();
+	view.threats = &threats;
+	return find_path(from, to, query_clearance, view);
+}
+
+PathResult HpaGraph::find_path(Vector2 from, Vector2 to, float query_clearance,
+							   const HpaBlockView &view) const {
+	std::shared_lock<std::shared_mutex> structure_lock(structure_mutex_);
+	std::shared_lock<std::shared_mutex> map_lock = lock_map_shared();
+	using Clock = std::chrono::steady_clock;
+	auto query_t0 = Clock::now();
+
+	// Timing buckets (kept for perf metrics compatibility).
+	float connect_us   = 0.0f;   // guide-point LOS / local A* time
+	float abstract_us  = 0.0f;   // cluster A* time
+	float refine_us    = 0.0f;   // path assembly + string-pull time
+	float start_connect_us = 0.0f;
+	float goal_connect_us  = 0.0f;
+
+	// Repurposed counters (names kept for GDScript perf-metrics compat).
+	int connector_los_attempts      = 0;  // total LOS checks
+	int connector_los_hits          = 0;  // LOS checks that passed
+	int connector_local_search_runs = 0;  // local A* calls
+	int connector_local_expansions  = 0;  // unused
+	int connector_portal_candidates = 0;  // portal nodes expanded
+
+	PathResult no_path;
+	no_path.valid          = false;
+	no_path.total_distance = 0.0f;
+
+	// ── Performance tracking lambda (unchanged from original) ──────────────
+	auto finalize_query = [&](PathResult r) -> PathResult {
+		if (!perf_tracking_enabled_) return r;
+		std::lock_guard<std::mutex> perf_lock(perf_mutex_);
+
+		auto query_t1 = Clock::now();
+		float total_us = std::chrono::duration<float, std::micro>(query_t1 - query_t0).count();
+
+		perf_.query_count++;
+		if (r.valid) perf_.success_count++;
+		else         perf_.failure_count++;
+
+		perf_.last_total_us         = total_us;
+		perf_.last_connect_us       = connect_us;
+		perf_.last_abstract_us      = abstract_us;
+		perf_.last_refine_us        = refine_us;
+		perf_.last_start_connect_us = start_connect_us;
+		perf_.last_goal_connect_us  = goal_connect_us;
+
+		perf_.last_connector_los_attempts      = connector_los_attempts;
+		perf_.last_connector_los_hits          = connector_los_hits;
+		perf_.last_connector_local_search_runs = connector_local_search_runs;
+		perf_.last_connector_local_expansions  = connector_local_expansions;
+		perf_.last_connector_portal_candidates = connector_portal_candidates;
+
+		auto update_ema = [&](float &ema, float sample) {
+			if (perf_.query_count <= 1) ema = sample;
+			else ema = ema * 0.9f + sample * 0.1f;
+		};
 		update_ema(perf_.avg_total_us,    total_us);
 		update_ema(perf_.avg_connect_us,  connect_us);
 		update_ema(perf_.avg_abstract_us, abstract_us);
@@ -851,12 +2038,6 @@ PathResult HpaGraph::find_path(Vector2 from, Vector2 to, float query_clearance)
 	float q_cl = (query_clearance > 0.0f) ? query_clearance : clearance_;
 
 	// ── Grid coordinate helpers ────────────────────────────────────────────
-	auto world_to_gx = [&](float wx) -> int {
-		return std::max(0, std::min(static_cast<int>((wx - min_x_) / cell_size_), grid_w_ - 1));
-	};
-	auto world_to_gz = [&](float wz) -> int {
-		return std::max(0, std::min(static_cast<int>((wz - min_z_) / cell_size_), grid_h_ - 1));
-	};
 
 	int from_gx = world_to_gx(from.x), from_gz = world_to_gz(from.y);
 	int to_gx   = world_to_gx(to.x),   to_gz   = world_to_gz(to.y);
@@ -865,23 +2046,12 @@ PathResult HpaGraph::find_path(Vector2 from, Vector2 to, float query_clearance)
 	int to_cid   = cluster_id(cell_cx(to_gx),   cell_cz(to_gz));
 
 	// ── Threat layer ───────────────────────────────────────────────────────
-	bool threat_layer_active = (threat_blocked_count_ > 0);
+	bool threat_layer_active = (view.threats && !view.threats->cids.empty());
 
 	// Reject a LOS segment that clips any threat-blocked cluster AABB.
-	// Iterates the compact threat_blocked_cids_ list rather than every cluster.
+	// Iterates the view's compact threat id list rather than every cluster.
 	auto threat_clear = [&](const Vector2 &a, const Vector2 &b) -> bool {
-		if (!threat_layer_active) return true;
-		const float hc = cell_size_ * 0.5f;
-		for (int cid : threat_blocked_cids_) {
-			const Cluster &cl = clusters_[cid];
-			float wx0, wz0, wx1, wz1;
-			grid_to_world(cl.x0, cl.z0, wx0, wz0);
-			grid_to_world(cl.x1, cl.z1, wx1, wz1);
-			if (segment_clips_aabb(a.x, a.y, b.x, b.y,
-			                       wx0 - hc, wz0 - hc, wx1 + hc, wz1 + hc))
-				return false;
-		}
-		return true;
+		return !threat_layer_active || segment_threat_clear(a, b, view.threats);
 	};
 
 	// ── Step 1: Direct LOS shortcut ────────────────────────────────────────
@@ -897,6 +2067,56 @@ PathResult HpaGraph::find_path(Vector2 from, Vector2 to, float query_clearance)
 		return finalize_query(r);
 	}
 
+	// ── Reachability at this clearance ─────────────────────────────────────
+	// The map's clearance tree rejects goals behind straits too narrow for
+	// this ship before any abstract search runs.
+	if (!nav_map_->can_reach(from_gx, from_gz, to_gx, to_gz, q_cl)) {
+		return finalize_query(no_path);
+	}
+
+	// ── String pulling + packaging (shared by both routers) ────────────────
+	// Greedy forward LOS simplification using the ship's actual clearance.
+	auto pull_and_package = [&](const std::vector<Vector2> &waypoints) -> PathResult {
+		if (waypoints.size() < 2) return no_path;
+		std::vector<Vector2> pulled;
+		pulled.push_back(waypoints.front());
+
+		size_t anchor = 0;
+		while (anchor < waypoints.size() - 1) {
+			size_t farthest = pull_farthest(waypoints, anchor, q_cl, view.threats);
+			pulled.push_back(waypoints[farthest]);
+			anchor = farthest;
+		}
+
+		PathResult result;
+		result.waypoints = pulled;
+		result.flags.assign(pulled.size(), WP_NONE);
+		for (size_t i = 0; i + 1 < pulled.size(); ++i)
+			result.total_distance += pulled[i].distance_to(pulled[i + 1]);
+		result.valid = true;
+		return result;
+	};
+
+	// ── Portal graph (HPA*) ────────────────────────────────────────────────
+	// Cross-cluster queries search the precomputed entrance graph and
+	// refine from its cached intra-cluster paths.  The guide pipeline below
+	// remains for same-cluster queries, clearances above the bucket ladder
+	// and the rare query the conservative bucket rounding cannot route.
+	if (portals_built_ && from_cid != to_cid) {
+		auto t_abs0 = Clock::now();
+		std::vector<Vector2> route;
+		bool routed = portal_route(from, to, q_cl, from_cid, to_cid, view,
+								   route, connector_portal_candidates);
+		auto t_abs1 = Clock::now();
+		abstract_us = std::chrono::duration<float, std::micro>(t_abs1 - t_abs0).count();
+
+		if (routed) {
+			PathResult result = pull_and_package(route);
+			refine_us = std::chrono::duration<float, std::micro>(Clock::now() - t_abs1).count();
+			return finalize_query(result);
+		}
+	}
+
 	// ── Step 2: Build guide-point sequence ─────────────────────────────────────
 	// Two cases:
 	//   (a) Same macro      → sub A* within from_cid produces the guide.
@@ -906,20 +2126,20 @@ PathResult HpaGraph::find_path(Vector2 from, Vector2 to, float query_clearance)
 	// unified Step 5 connector below.
 	//
 	// Open-cell rule (mirrors macro behaviour for subs):
-	//   is_sub_open(sid)  := sub_clusters_[sid].min_sdf >= q_cl   (fully safe)
+	//   is_sub_open(sid)  := sub_min_sdf_[sid] >= q_cl   (fully safe)
 	//   is_cluster_open   := analogous, at macro layer
 	// Only "open" intermediate centres are emitted as guides; coastal/terrain
 	// stretches are bridged by LOS / sub A* / cell A* in the connector.
 
 	auto is_cluster_open = [&](int cid) -> bool {
 		return cid >= 0 &&
-		       cid < static_cast<int>(clusters_.size()) &&
-		       clusters_[cid].min_sdf >= q_cl;
+		       cid < static_cast<int>(cluster_min_sdf_.size()) &&
+		       cluster_min_sdf_[cid] >= q_cl;
 	};
 	auto is_sub_open = [&](int sid) -> bool {
 		return sid >= 0 &&
-		       sid < static_cast<int>(sub_clusters_.size()) &&
-		       sub_clusters_[sid].min_sdf >= q_cl;
+		       sid < static_cast<int>(sub_min_sdf_.size()) &&
+		       sub_min_sdf_[sid] >= q_cl;
 	};
 
 	int from_sid = sub_id(cell_scx(from_gx), cell_scz(from_gz));
@@ -929,25 +2149,26 @@ PathResult HpaGraph::find_path(Vector2 from, Vector2 to, float query_clearance)
 	guide.reserve(8);
 	guide.push_back(from);
 
-	// allowed_macros: per-macro 0/1 mask used by sub_cluster_astar() to
+	// allowed_macros: per-macro bit mask used by sub_cluster_astar() to
 	// constrain corridor searches.  Sized once and shared between the
 	// same-macro fast path and the per-pair connector below.
-	std::vector<uint8_t> allowed_macros(clusters_.size(), 0);
+	HpaClusterBits allowed_macros;
+	allowed_macros.assign(static_cast<int>(clusters_.size()));
 
 	if (from_cid == to_cid) {
 		// (a) Same macro — sub A* over this single macro, no corridor needed.
-		allowed_macros[from_cid] = 1;
+		allowed_macros.set(from_cid);
 
 		if (from_sid != to_sid) {
 			auto t_abs0 = Clock::now();
 			std::vector<int> sub_path = sub_cluster_astar(
-				from_sid, to_sid, q_cl, &allowed_macros);
+				from_sid, to_sid, q_cl, view, &allowed_macros);
 			auto t_abs1 = Clock::now();
 			abstract_us += std::chrono::duration<float, std::micro>(t_abs1 - t_abs0).count();
 
 			if (sub_path.empty()) {
 				auto t0 = Clock::now();
-				PathResult local = constrained_cell_astar(from, to, q_cl, allowed_macros);
+				PathResult local = constrained_cell_astar(from, to, q_cl, allowed_macros, view);
 				auto t1 = Clock::now();
 				refine_us = std::chrono::duration<float, std::micro>(t1 - t0).count();
 				connector_local_search_runs++;
@@ -965,9 +2186,9 @@ PathResult HpaGraph::find_path(Vector2 from, Vector2 to, float query_clearance)
 	} else {
 		// (b) Cross macro — macro A* then sub-aware guide selection.
 		auto t_abs0 = Clock::now();
-		std::vector<int> cluster_path = cluster_astar(from_cid, to_cid, q_cl);
+		std::vector<int> cluster_path = cluster_astar(from_cid, to_cid, q_cl, view);
 		auto t_abs1 = Clock::now();
-		abstract_us = std::chrono::duration<float, std::micro>(t_abs1 - t_abs0).count();
+		abstract_us += std::chrono::duration<float, std::micro>(t_abs1 - t_abs0).count();
 
 		if (cluster_path.empty()) return finalize_query(no_path);
 
@@ -981,7 +2202,7 @@ PathResult HpaGraph::find_path(Vector2 from, Vector2 to, float query_clearance)
 					int nx = cc.cx + dx;
 					int nz = cc.cz + dz;
 					if (nx < 0 || nx >= ncx_ || nz < 0 || nz >= ncz_) continue;
-					allowed_macros[cluster_id(nx, nz)] = 1;
+					allowed_macros.set(cluster_id(nx, nz));
 				}
 			}
 		}
@@ -1084,7 +2305,7 @@ PathResult HpaGraph::find_path(Vector2 from, Vector2 to, float query_clearance)
 
 		if (a_sid != b_sid) {
 			std::vector<int> sub_path =
-				sub_cluster_astar(a_sid, b_sid, q_cl, &allowed_macros);
+				sub_cluster_astar(a_sid, b_sid, q_cl, view, &allowed_macros);
 
 			// Count open intermediates — only worth using if the sub layer
 			// produced at least one open detour point; otherwise the route
@@ -1112,7 +2333,7 @@ PathResult HpaGraph::find_path(Vector2 from, Vector2 to, float query_clearance)
 
 		// Sub A* couldn't help — run cell A* constrained to the HPA corridor.
 		connector_local_search_runs++;
-		PathResult local = constrained_cell_astar(A, B, q_cl, allowed_macros);
+		PathResult local = constrained_cell_astar(A, B, q_cl, allowed_macros, view);
 		if (local.valid && local.waypoints.size() >= 2) {
 			for (int j = 1; j < static_cast<int>(local.waypoints.size()); ++j) {
 				if (waypoints.back().distance_to(local.waypoints[j]) > merge_eps)
@@ -1131,42 +2352,13 @@ PathResult HpaGraph::find_path(Vector2 from, Vector2 to, float query_clearance)
 			waypoints.push_back(to);
 	}
 
-	// ── Step 6: String pulling ─────────────────────────────────────────────
-	// Greedy forward LOS simplification using the ship's actual clearance.
-	std::vector<Vector2> pulled;
-	pulled.push_back(waypoints.front());
-
-	size_t anchor = 0;
-	while (anchor < waypoints.size() - 1) {
-		size_t farthest = anchor + 1;
-		for (size_t test = waypoints.size() - 1; test > anchor + 1; --test) {
-			int ax = world_to_gx(waypoints[anchor].x), az = world_to_gz(waypoints[anchor].y);
-			int bx = world_to_gx(waypoints[test].x),   bz = world_to_gz(waypoints[test].y);
-			if (nav_map_->line_of_sight(ax, az, bx, bz, q_cl) &&
-				threat_clear(waypoints[anchor], waypoints[test])) {
-				farthest = test;
-				break;
-			}
-		}
-		pulled.push_back(waypoints[farthest]);
-		anchor = farthest;
-	}
+	PathResult result = pull_and_package(waypoints);
 
 	auto t_ref1 = Clock::now();
 	refine_us = std::chrono::duration<float, std::micro>(t_ref1 - t_ref0).count();
 
 	connect_us = start_connect_us + goal_connect_us; // 0 in new design
 
-	// ── Step 7: Package result ─────────────────────────────────────────────
-	if (pulled.size() < 2) return finalize_query(no_path);
-
-	PathResult result;
-	result.waypoints = pulled;
-	result.flags.assign(pulled.size(), WP_NONE);
-	for (size_t i = 0; i + 1 < pulled.size(); ++i)
-		result.total_distance += pulled[i].distance_to(pulled[i + 1]);
-	result.valid = true;
-
 	return finalize_query(result);
 }
 
@@ -1183,6 +2375,468 @@ PackedVector2Array HpaGraph::find_path_packed(Vector2 from, Vector2 to,
 	return out;
 }
 
+// ============================================================================
+// Progressive paths (begin_path / refine_path)
+// ============================================================================
+
+bool HpaGraph::segment_threat_clear(Vector2 a, Vector2 b, const HpaThreatSet *threats) const {
+	if (!threats) return true;
+	const float hc = cell_size_ * 0.5f;
+	for (int cid : threats->cids) {
+		const Cluster &cl = clusters_[cid];
+		float wx0, wz0, wx1, wz1;
+		grid_to_world(cl.x0, cl.z0, wx0, wz0);
+		grid_to_world(cl.x1, cl.z1, wx1, wz1);
+		if (segment_clips_aabb(a.x, a.y, b.x, b.y,
+		                       wx0 - hc, wz0 - hc, wx1 + hc, wz1 + hc))
+			return false;
+	}
+	return true;
+}
+
+size_t HpaGraph::pull_farthest(const std::vector<Vector2> &points, size_t anchor,
+							   float clearance, const HpaThreatSet *threats) const {
+	const int ax = world_to_gx(points[anchor].x), az = world_to_gz(points[anchor].y);
+	for (size_t test = points.size() - 1; test > anchor + 1; --test) {
+		const int bx = world_to_gx(points[test].x), bz = world_to_gz(points[test].y);
+		if (nav_map_->line_of_sight(ax, az, bx, bz, clearance) &&
+			segment_threat_clear(points[anchor], points[test], threats)) {
+			return test;
+		}
+	}
+	return anchor + 1;
+}
+
+HpaPathJob HpaGraph::begin_path(Vector2 from, Vector2 to, float query_clearance,
+								std::shared_ptr<const HpaThreatSet> threats, float speed) const {
+	HpaPathJob job;
+	job.clearance = (query_clearance > 0.0f) ? query_clearance : clearance_;
+	job.threats = std::move(threats);
+	const float q_cl = job.clearance;
+
+	std::shared_ptr<const HpaObstacleSet> obstacles = snapshot_obstacles();
+	HpaBlockView view;
+	view.obstacles = obstacles.get();
+	view.threats = job.threats.get();
+	view.speed = speed;
+	{
+		std::shared_lock<std::shared_mutex> structure_lock(structure_mutex_);
+		std::shared_lock<std::shared_mutex> map_lock = lock_map_shared();
+		if (!built_) {
+			job.done = true;
+			return job;
+		}
+		job.structure_gen = structure_gen_;
+
+		const int from_gx = world_to_gx(from.x), from_gz = world_to_gz(from.y);
+		const int to_gx   = world_to_gx(to.x),   to_gz   = world_to_gz(to.y);
+		const int from_cid = cluster_id(cell_cx(from_gx), cell_cz(from_gz));
+		const int to_cid   = cluster_id(cell_cx(to_gx),   cell_cz(to_gz));
+
+		const bool direct = nav_map_->line_of_sight(from_gx, from_gz, to_gx, to_gz, q_cl) &&
+							segment_threat_clear(from, to, job.threats.get());
+		if (!direct && !nav_map_->can_reach(from_gx, from_gz, to_gx, to_gz, q_cl)) {
+			job.done = true;
+			return job;
+		}
+		if (!direct && portals_built_ && from_cid != to_cid) {
+			int expanded = 0;
+			if (portal_route(from, to, q_cl, from_cid, to_cid, view, job.route, expanded)) {
+				job.pulled.push_back(from);
+				job.pulled_index.push_back(0);
+				job.valid = true;
+				return job;
+			}
+			job.route.clear();
+		}
+	}
+
+	// Direct line, or a query for the guide pipeline: plan it whole
+	PathResult pr = find_path(from, to, q_cl, view);
+	job.valid = pr.valid;
+	job.done = true;
+	job.route = std::move(pr.waypoints);
+	job.pulled = job.route;
+	for (size_t i = 0; i < job.route.size(); ++i) job.pulled_index.push_back(static_cast<int32_t>(i));
+	job.anchor = job.route.empty() ? 0 : job.route.size() - 1;
+	return job;
+}
+
+bool HpaGraph::refine_path(HpaPathJob &job, float budget_us) const {
+	if (job.done) return true;
+	std::shared_lock<std::shared_mutex> structure_lock(structure_mutex_);
+	std::shared_lock<std::shared_mutex> map_lock = lock_map_shared();
+	if (job.structure_gen != structure_gen_) return false;
+
+	using Clock = std::chrono::steady_clock;
+	const auto t0 = Clock::now();
+	do {
+		job.anchor = pull_farthest(job.route, job.anchor, job.clearance, job.threats.get());
+		job.pulled.push_back(job.route[job.anchor]);
+		job.pulled_index.push_back(static_cast<int32_t>(job.anchor));
+	} while (job.anchor + 1 < job.route.size() &&
+			 std::chrono::duration<float, std::micro>(Clock::now() - t0).count() < budget_us);
+	job.done = job.anchor + 1 >= job.route.size();
+	return true;
+}
+
+PathResult HpaPathJob::current() const {
+	PathResult r;
+	if (!valid) return r;
+	r.waypoints = pulled;
+	r.waypoints.insert(r.waypoints.end(), route.begin() + anchor + 1, route.end());
+	r.flags.assign(r.waypoints.size(), WP_NONE);
+	for (size_t i = 0; i + 1 < r.waypoints.size(); ++i)
+		r.total_distance += r.waypoints[i].distance_to(r.waypoints[i + 1]);
+	r.valid = true;
+	return r;
+}
+
+int HpaPathJob::route_index(int i) const {
+	const int last = static_cast<int>(pulled.size()) - 1;
+	if (i <= last) return pulled_index[std::max(0, i)];
+	return static_cast<int>(anchor) + (i - last);
+}
+
+int HpaPathJob::waypoint_at_or_after(int r) const {
+	const int last = static_cast<int>(pulled.size()) - 1;
+	if (r > static_cast<int>(anchor)) return last + (r - static_cast<int>(anchor));
+	return static_cast<int>(std::lower_bound(pulled_index.begin(), pulled_index.end(), r) -
+							pulled_index.begin());
+}
+
+// ============================================================================
+// estimate_path_costs
+// ============================================================================
+//
+// Dijkstra (no heuristic) over the portal nodes, seeded like portal_route
+// from a cell Dijkstra in the start cluster.  Each target runs one cell
+// Dijkstra in its own cluster; a settled node in that cluster offers
+// g + (node -> target).  Nodes settle in g order, so the search stops once
+// the popped g reaches the worst target's best offer.  Clearances above the
+// bucket ladder (or a graph without portals) fall back to find_path.  The
+// rare target only find_path's guide pipeline reaches (a strait narrower
+// than the rounded-up bucket) is reported unreachable rather than paying
+// for that pipeline per target.
+//
+std::vector<float> HpaGraph::estimate_path_costs(Vector2 from, const std::vector<Vector2> &targets,
+												 float query_clearance, const HpaBlockView &view) const {
+	const int T = static_cast<int>(targets.size());
+	std::vector<float> out(T, -1.0f);
+	if (!built_ || T == 0) return out;
+
+	const float q_cl = (query_clearance > 0.0f) ? query_clearance : clearance_;
+	const int bucket = portal_bucket(q_cl);
+	if (!portals_built_ || bucket < 0) {
+		for (int t = 0; t < T; ++t) {
+			PathResult pr = find_path(from, targets[t], q_cl, view);
+			if (pr.valid) out[t] = pr.total_distance;
+		}
+		return out;
+	}
+
+	std::shared_lock<std::shared_mutex> structure_lock(structure_mutex_);
+	std::shared_lock<std::shared_mutex> map_lock = lock_map_shared();
+	const float INF = std::numeric_limits<float>::infinity();
+	auto node_cluster = [&](int node) -> int { return portals_[node >> 1].cid[node & 1]; };
+	auto local_cell = [&](const Cluster &c, int node) -> int {
+		const HpaPortal &p = portals_[node >> 1];
+		return (p.gz[node & 1] - c.z0) * (c.x1 - c.x0 + 1) + (p.gx[node & 1] - c.x0);
+	};
+
+	const int from_gx = world_to_gx(from.x), from_gz = world_to_gz(from.y);
+	const int from_cid = cluster_id(cell_cx(from_gx), cell_cz(from_gz));
+	const Cluster &from_c = clusters_[from_cid];
+
+	std::vector<float> sdf, start_dist;
+	std::vector<int> tree;
+	cluster_cell_sdf(from_c, sdf);
+	cluster_cell_dijkstra(from_c, sdf, from_gx, from_gz, q_cl, start_dist, tree);
+
+	// Per target: straight line, same-cluster cell path, or a graph search
+	std::vector<float> best(T, INF);
+	std::vector<int> target_cid(T, -1);
+	std::vector<std::vector<float>> target_dist(T);
+	std::unordered_map<int, std::vector<int>> targets_in;  // cluster -> target indices
+	int pending = 0;
+	for (int t = 0; t < T; ++t) {
+		const int gx = world_to_gx(targets[t].x), gz = world_to_gz(targets[t].y);
+		if (nav_map_->line_of_sight(from_gx, from_gz, gx, gz, q_cl) &&
+			segment_threat_clear(from, targets[t], view.threats)) {
+			out[t] = from.distance_to(targets[t]);
+			continue;
+		}
+		if (!nav_map_->can_reach(from_gx, from_gz, gx, gz, q_cl)) continue;
+
+		const int cid = cluster_id(cell_cx(gx), cell_cz(gz));
+		const Cluster &c = clusters_[cid];
+		if (cid == from_cid) {
+			best[t] = start_dist[(gz - c.z0) * (c.x1 - c.x0 + 1) + (gx - c.x0)];
+		}
+		cluster_cell_sdf(c, sdf);
+		cluster_cell_dijkstra(c, sdf, gx, gz, q_cl, target_dist[t], tree);
+		target_cid[t] = cid;
+		targets_in[cid].push_back(t);
+		pending++;
+	}
+
+	if (pending > 0) {
+		auto enterable = [&](int cid) -> bool {
+			return cid == from_cid || targets_in.count(cid) != 0 || !cluster_blocked(cid, view);
+		};
+		auto worst_best = [&]() -> float {
+			float w = 0.0f;
+			for (int t = 0; t < T; ++t) {
+				if (target_cid[t] >= 0) w = std::max(w, best[t]);
+			}
+			return w;
+		};
+
+		const int N = static_cast<int>(portals_.size()) * 2;
+		std::vector<float> g(N, INF);
+		std::vector<uint8_t> closed(N, 0);
+		NavQuadHeap open;
+		open.reserve_ids(N);
+		auto relax = [&](int node, float ng) {
+			if (closed[node] || !(ng < g[node])) return;
+			g[node] = ng;
+			open.push(node, ng);
+		};
+
+		for (int k = cluster_node_begin_[from_cid]; k < cluster_node_begin_[from_cid + 1]; ++k) {
+			const int node = cluster_nodes_[k];
+			if (portals_[node >> 1].clearance < q_cl) continue;
+			relax(node, start_dist[local_cell(from_c, node)]);
+		}
+
+		float bound = worst_best();
+		while (!open.empty()) {
+			auto [gu, u] = open.pop();
+			if (gu >= bound) break;
+			closed[u] = 1;
+
+			const int cid = node_cluster(u);
+			auto tit = targets_in.find(cid);
+			if (tit != targets_in.end()) {
+				bool improved = false;
+				for (int t : tit->second) {
+					const float cost = gu + target_dist[t][local_cell(clusters_[cid], u)];
+					if (cost < best[t]) {
+						best[t] = cost;
+						improved = true;
+					}
+				}
+				if (improved) bound = worst_best();
+			}
+
+			const int v = u ^ 1;
+			const int vcid = node_cluster(v);
+			if (portals_[u >> 1].clearance >= q_cl && enterable(vcid)) {
+				float ng = gu + cell_size_;
+				if (vcid != from_cid && targets_in.count(vcid) == 0) ng += obstacle_cost(vcid, gu, view);
+				relax(v, ng);
+			}
+
+			const int nbeg = cluster_node_begin_[cid];
+			const int k = cluster_node_begin_[cid + 1] - nbeg;
+			const int li = node_local_[u];
+			for (int j = 0; j < k; ++j) {
+				if (j == li) continue;
+				const HpaPortalPath *path;
+				float cost = portal_edge_cost(cid, bucket, li, j, &path);
+				if (cost == INF) continue;
+				relax(cluster_nodes_[nbeg + j], gu + cost);
+			}
+		}
+
+	}
+
+	for (int t = 0; t < T; ++t) {
+		if (target_cid[t] >= 0 && best[t] < INF) out[t] = best[t];
+	}
+	return out;
+}
+
+PackedFloat32Array HpaGraph::estimate_path_costs_packed(Vector2 from, const PackedVector2Array &targets,
+														float query_clearance) const {
+	std::vector<Vector2> pts(targets.size());
+	for (int64_t i = 0; i < targets.size(); ++i) pts[i] = targets[i];
+
+	std::shared_ptr<const HpaObstacleSet> obstacles = snapshot_obstacles();
+	HpaBlockView view;
+	view.obstacles = obstacles.get();
+	std::vector<float> costs = estimate_path_costs(from, pts, query_clearance, view);
+
+	PackedFloat32Array out;
+	out.resize(static_cast<int64_t>(costs.size()));
+	for (size_t i = 0; i < costs.size(); ++i) out[static_cast<int64_t>(i)] = costs[i];
+	return out;
+}
+
+// ============================================================================
+// Distance fields
+// ============================================================================
+//
+// Multi-source Dijkstra over the sub-cluster grid with sub_cluster_astar's
+// rules (max_sdf >= clearance, no corner cutting), seeded from the subs in
+// the goal region at their centre's distance to it.  A goal's own sub is
+// seeded even when impassable, like the goal sub of a path query.
+//
+void HpaGraph::compute_distance_field(DistanceField &f) const {
+	const int N = static_cast<int>(sub_clusters_.size());
+	const float INF = std::numeric_limits<float>::infinity();
+	f.structure_gen = structure_gen_;
+	f.dist.assign(N, INF);
+	f.next.assign(N, -1);
+	if (!built_ || N == 0) return;
+
+	const float sub_card = static_cast<float>(sub_size_) * cell_size_;
+	const float sub_diag = sub_card * 1.41421356237f;
+	auto passable = [&](int sid) -> bool { return sub_max_sdf_[sid] >= f.clearance; };
+	auto region_dist = [&](Vector2 p) -> float {
+		float d = INF;
+		for (const Vector2 &goal : f.goals) d = std::min(d, p.distance_to(goal));
+		return std::max(0.0f, d - f.goal_radius);
+	};
+
+	NavQuadHeap open;
+	open.reserve_ids(N);
+	auto seed = [&](int sid) {
+		const SubCluster &s = sub_clusters_[sid];
+		const float d = region_dist(Vector2(s.wx_center, s.wz_center));
+		if (d < f.dist[sid]) {
+			f.dist[sid] = d;
+			open.push(sid, d);
+		}
+	};
+	for (const Vector2 &goal : f.goals) {
+		const int scx0 = cell_scx(world_to_gx(goal.x - f.goal_radius));
+		const int scx1 = cell_scx(world_to_gx(goal.x + f.goal_radius));
+		const int scz0 = cell_scz(world_to_gz(goal.y - f.goal_radius));
+		const int scz1 = cell_scz(world_to_gz(goal.y + f.goal_radius));
+		for (int scz = scz0; scz <= scz1; ++scz) {
+			for (int scx = scx0; scx <= scx1; ++scx) {
+				const int sid = sub_id(scx, scz);
+				const SubCluster &s = sub_clusters_[sid];
+				if (passable(sid) && Vector2(s.wx_center, s.wz_center).distance_to(goal) <= f.goal_radius) {
+					seed(sid);
+				}
+			}
+		}
+		seed(sub_id(cell_scx(world_to_gx(goal.x)), cell_scz(world_to_gz(goal.y))));
+	}
+
+	while (!open.empty()) {
+		auto [d, cur] = open.pop();
+		const SubCluster &cs = sub_clusters_[cur];
+		for (int dz = -1; dz <= 1; ++dz) {
+			for (int dx = -1; dx <= 1; ++dx) {
+				if (dx == 0 && dz == 0) continue;
+				const int nscx = cs.scx + dx;
+				const int nscz = cs.scz + dz;
+				if (nscx < 0 || nscx >= nsubx_ || nscz < 0 || nscz >= nsubz_) continue;
+				const int nsid = sub_id(nscx, nscz);
+				if (!passable(nsid)) continue;
+				const bool is_diag = (dx != 0 && dz != 0);
+				if (is_diag && (!passable(sub_id(cs.scx + dx, cs.scz)) || !passable(sub_id(cs.scx, cs.scz + dz)))) {
+					continue;
+				}
+				const float nd = d + (is_diag ? sub_diag : sub_card);
+				if (nd < f.dist[nsid]) {
+					f.dist[nsid] = nd;
+					f.next[nsid] = cur;
+					open.push(nsid, nd);
+				}
+			}
+		}
+	}
+}
+
+const HpaGraph::DistanceField *HpaGraph::current_distance_field(int field_id) const {
+	auto it = fields_.find(field_id);
+	if (it == fields_.end()) return nullptr;
+	if (it->second.structure_gen != structure_gen_) {
+		compute_distance_field(it->second);
+	}
+	return &it->second;
+}
+
+void HpaGraph::set_distance_field(int field_id, const PackedVector2Array &goals,
+								  float goal_radius, float clearance) {
+	std::shared_lock<std::shared_mutex> structure_lock(structure_mutex_);
+	std::shared_lock<std::shared_mutex> map_lock = lock_map_shared();
+	DistanceField f;
+	for (int64_t i = 0; i < goals.size(); ++i) f.goals.push_back(goals[i]);
+	f.goal_radius = std::max(0.0f, goal_radius);
+	f.clearance = (clearance > 0.0f) ? clearance : clearance_;
+	compute_distance_field(f);
+	std::lock_guard<std::mutex> lock(field_mutex_);
+	fields_[field_id] = std::move(f);
+}
+
+void HpaGraph::remove_distance_field(int field_id) {
+	std::lock_guard<std::mutex> lock(field_mutex_);
+	fields_.erase(field_id);
+}
+
+void HpaGraph::clear_distance_fields() {
+	std::lock_guard<std::mutex> lock(field_mutex_);
+	fields_.clear();
+}
+
+bool HpaGraph::has_distance_field(int field_id) const {
+	std::lock_guard<std::mutex> lock(field_mutex_);
+	return fields_.count(field_id) != 0;
+}
+
+float HpaGraph::get_field_distance(int field_id, Vector2 pos) const {
+	std::shared_lock<std::shared_mutex> structure_lock(structure_mutex_);
+	std::shared_lock<std::shared_mutex> map_lock = lock_map_shared();
+	std::lock_guard<std::mutex> lock(field_mutex_);
+	const DistanceField *f = current_distance_field(field_id);
+	if (!f || f->dist.empty()) return -1.0f;
+
+	const int sid = sub_id(cell_scx(world_to_gx(pos.x)), cell_scz(world_to_gz(pos.y)));
+	if (f->dist[sid] == std::numeric_limits<float>::infinity()) return -1.0f;
+
+	const int next = f->next[sid];
+	if (next < 0) {
+		float d = std::numeric_limits<float>::infinity();
+		for (const Vector2 &goal : f->goals) d = std::min(d, pos.distance_to(goal));
+		return std::max(0.0f, d - f->goal_radius);
+	}
+	const SubCluster &n = sub_clusters_[next];
+	return f->dist[next] + pos.distance_to(Vector2(n.wx_center, n.wz_center));
+}
+
+Vector2 HpaGraph::get_field_direction(int field_id, Vector2 pos) const {
+	std::shared_lock<std::shared_mutex> structure_lock(structure_mutex_);
+	std::shared_lock<std::shared_mutex> map_lock = lock_map_shared();
+	std::lock_guard<std::mutex> lock(field_mutex_);
+	const DistanceField *f = current_distance_field(field_id);
+	if (!f || f->dist.empty()) return Vector2();
+
+	const int sid = sub_id(cell_scx(world_to_gx(pos.x)), cell_scz(world_to_gz(pos.y)));
+	if (f->dist[sid] == std::numeric_limits<float>::infinity()) return Vector2();
+
+	Vector2 target;
+	const int next = f->next[sid];
+	if (next < 0) {
+		float best = std::numeric_limits<float>::infinity();
+		for (const Vector2 &goal : f->goals) {
+			const float d = pos.distance_to(goal);
+			if (d < best) {
+				best = d;
+				target = goal;
+			}
+		}
+		if (best <= f->goal_radius) return Vector2();
+	} else {
+		target = Vector2(sub_clusters_[next].wx_center, sub_clusters_[next].wz_center);
+	}
+	return (target - pos).normalized();
+}
+
 // ============================================================================
 // Debug helpers
 // ============================================================================
@@ -1195,8 +2849,8 @@ TypedArray<Dictionary> HpaGraph::get_debug_nodes() const {
 		d["id"]         = c.id;
 		d["cluster_id"] = c.id;
 		d["position"]   = Vector2(c.wx_center, c.wz_center);
-		d["max_sdf"]    = c.max_sdf;
-		d["min_sdf"]    = c.min_sdf;
+		d["max_sdf"]    = cluster_max_sdf_[c.id];
+		d["min_sdf"]    = cluster_min_sdf_[c.id];
 		out.push_back(d);
 	}
 	return out;
@@ -1227,6 +2881,34 @@ TypedArray<Dictionary> HpaGraph::get_debug_edges() const {
 	return out;
 }
 
+// get_debug_portals — one entry per portal: both crossing cells and the
+// clearance it admits.
+TypedArray<Dictionary> HpaGraph::get_debug_portals() const {
+	TypedArray<Dictionary> out;
+	for (int pi = 0; pi < static_cast<int>(portals_.size()); ++pi) {
+		const HpaPortal &p = portals_[pi];
+		if (p.cid[0] < 0) continue;  // free slot
+		float ax, az, bx, bz;
+		grid_to_world(p.gx[0], p.gz[0], ax, az);
+		grid_to_world(p.gx[1], p.gz[1], bx, bz);
+		Dictionary d;
+		d["id"]        = pi;
+		d["cluster_a"] = p.cid[0];
+		d["cluster_b"] = p.cid[1];
+		d["pos_a"]     = Vector2(ax, az);
+		d["pos_b"]     = Vector2(bx, bz);
+		d["clearance"] = p.clearance;
+		out.push_back(d);
+	}
+	return out;
+}
+
+PackedFloat32Array HpaGraph::get_portal_clearance_buckets() const {
+	PackedFloat32Array out;
+	for (float b : portal_buckets_) out.push_back(b);
+	return out;
+}
+
 TypedArray<Dictionary> HpaGraph::get_debug_clusters() const {
 	TypedArray<Dictionary> out;
 	for (const Cluster &c : clusters_) {
@@ -1240,9 +2922,9 @@ TypedArray<Dictionary> HpaGraph::get_debug_clusters() const {
 		d["z0"]        = wz0 - hc;
 		d["x1"]        = wx1 + hc;
 		d["z1"]        = wz1 + hc;
-		d["navigable"] = c.navigable;
-		d["max_sdf"]   = c.max_sdf;
-		d["min_sdf"]   = c.min_sdf;
+		d["navigable"] = cluster_max_sdf_[c.id] >= clearance_;
+		d["max_sdf"]   = cluster_max_sdf_[c.id];
+		d["min_sdf"]   = cluster_min_sdf_[c.id];
 		d["center"]    = Vector2(c.wx_center, c.wz_center);
 		out.push_back(d);
 	}
@@ -1263,9 +2945,9 @@ TypedArray<Dictionary> HpaGraph::get_debug_sub_clusters() const {
 		d["z0"]         = wz0 - hc;
 		d["x1"]         = wx1 + hc;
 		d["z1"]         = wz1 + hc;
-		d["navigable"]  = s.navigable;
-		d["max_sdf"]    = s.max_sdf;
-		d["min_sdf"]    = s.min_sdf;
+		d["navigable"]  = sub_max_sdf_[s.id] >= clearance_;
+		d["max_sdf"]    = sub_max_sdf_[s.id];
+		d["min_sdf"]    = sub_min_sdf_[s.id];
 		d["center"]     = Vector2(s.wx_center, s.wz_center);
 		out.push_back(d);
 	}
@@ -1277,6 +2959,7 @@ TypedArray<Dictionary> HpaGraph::get_debug_sub_clusters() const {
 // ============================================================================
 
 Dictionary HpaGraph::get_perf_metrics() const {
+	std::lock_guard<std::mutex> perf_lock(perf_mutex_);
 	Dictionary d;
 	d["query_count"]   = static_cast<int64_t>(perf_.query_count);
 	d["success_count"] = static_cast<int64_t>(perf_.success_count);
@@ -1313,6 +2996,9 @@ Dictionary HpaGraph::get_perf_metrics() const {
 
 	d["spike_threshold_us"] = perf_.spike_threshold_us;
 	d["spike_count"]        = static_cast<int64_t>(perf_.spike_count);
+
+	d["threat_los_traced"] = static_cast<int64_t>(threat_los_traced_.load(std::memory_order_relaxed));
+	d["threat_los_cached"] = static_cast<int64_t>(threat_los_cached_.load(std::memory_order_relaxed));
 	d["worst_spike_us"]     = perf_.worst_spike_us;
 
 	float inv = (perf_.window_queries > 0)
@@ -1328,18 +3014,35 @@ Dictionary HpaGraph::get_perf_metrics() const {
 		d["window_avg_abstract_us"] = 0.0f;
 		d["window_avg_refine_us"]   = 0.0f;
 	}
+
+	std::lock_guard<std::mutex> route_lock(route_cache_mutex_);
+	d["route_cache_hits"]      = static_cast<int64_t>(route_cache_hits_);
+	d["route_cache_misses"]    = static_cast<int64_t>(route_cache_misses_);
+	d["route_cache_stale"]     = static_cast<int64_t>(route_cache_stale_);
+	d["route_cache_evictions"] = static_cast<int64_t>(route_cache_evictions_);
+	d["route_cache_size"]      = static_cast<int64_t>(route_cache_.size());
 	return d;
 }
 
 void HpaGraph::reset_perf_metrics() {
+	std::lock_guard<std::mutex> perf_lock(perf_mutex_);
 	float threshold      = perf_.spike_threshold_us;
 	float report_interval = perf_.report_interval_s;
 	perf_ = PerfStats();
 	perf_.spike_threshold_us = threshold;
 	perf_.report_interval_s  = report_interval;
+	threat_los_traced_.store(0, std::memory_order_relaxed);
+	threat_los_cached_.store(0, std::memory_order_relaxed);
+
+	std::lock_guard<std::mutex> route_lock(route_cache_mutex_);
+	route_cache_hits_ = 0;
+	route_cache_misses_ = 0;
+	route_cache_stale_ = 0;
+	route_cache_evictions_ = 0;
 }
 
 void HpaGraph::set_perf_spike_threshold_us(float threshold_us) {
+	std::lock_guard<std::mutex> perf_lock(perf_mutex_);
 	perf_.spike_threshold_us = std::max(0.0f, threshold_us);
 }
 
@@ -1356,77 +3059,307 @@ bool HpaGraph::is_perf_tracking_enabled() const {
 }
 
 // ============================================================================
-// stamp_threats / clear_threats
+// benchmark_cluster_storage
 // ============================================================================
 
-void HpaGraph::stamp_threats(const std::vector<ThreatCircle> &threats) {
-	std::fill(cluster_threat_blocked_.begin(), cluster_threat_blocked_.end(), 0);
-	threat_blocked_cids_.clear();
-	threat_blocked_count_ = 0;
-	if (threats.empty() || clusters_.empty() || !nav_map_.is_valid()) return;
+Dictionary HpaGraph::benchmark_cluster_storage(int queries, float clearance) {
+	Dictionary result;
+	if (!built_ || !nav_map_.is_valid()) {
+		UtilityFunctions::push_error("[HpaGraph] benchmark_cluster_storage: graph is not built");
+		return result;
+	}
+	std::vector<std::pair<Vector2, Vector2>> pairs =
+			nav_map_->benchmark_query_pairs(std::max(1, queries), clearance);
 
-	for (const ThreatCircle &t : threats) {
-		if (t.radius <= 0.0f) continue;
+	using Clock = std::chrono::steady_clock;
+	auto us = [](Clock::time_point a, Clock::time_point b) {
+		return std::chrono::duration<double, std::micro>(b - a).count();
+	};
+	const HpaBlockView open_water;
+	double cluster_us = 0.0, sub_us = 0.0, path_us = 0.0;
+	int64_t cluster_hops = 0, sub_hops = 0;
+	int cluster_failures = 0, sub_failures = 0, path_failures = 0;
+	{
+		std::shared_lock<std::shared_mutex> structure_lock(structure_mutex_);
+		std::shared_lock<std::shared_mutex> map_lock = lock_map_shared();
+		for (const auto &pair : pairs) {
+			const int ax = world_to_gx(pair.first.x), az = world_to_gz(pair.first.y);
+			const int bx = world_to_gx(pair.second.x), bz = world_to_gz(pair.second.y);
+
+			auto t0 = Clock::now();
+			std::vector<int> cpath = cluster_astar(cluster_id(cell_cx(ax), cell_cz(az)),
+					cluster_id(cell_cx(bx), cell_cz(bz)), clearance, open_water);
+			auto t1 = Clock::now();
+			std::vector<int> spath = sub_cluster_astar(sub_id(cell_scx(ax), cell_scz(az)),
+					sub_id(cell_scx(bx), cell_scz(bz)), clearance, open_water);
+			auto t2 = Clock::now();
+
+			cluster_us += us(t0, t1);
+			sub_us += us(t1, t2);
+			cluster_hops += static_cast<int64_t>(cpath.size());
+			sub_hops += static_cast<int64_t>(spath.size());
+			if (cpath.empty()) cluster_failures++;
+			if (spath.empty()) sub_failures++;
+		}
+	}
+	// find_path takes the locks itself
+	clear_route_cache();
+	double length_sum = 0.0;
+	for (const auto &pair : pairs) {
+		auto t0 = Clock::now();
+		PathResult r = find_path(pair.first, pair.second, clearance);
+		path_us += us(t0, Clock::now());
+		if (!r.valid) path_failures++;
+		length_sum += r.total_distance;
+	}
 
-		int gx_t = static_cast<int>((t.origin.x - min_x_) / cell_size_);
-		int gz_t = static_cast<int>((t.origin.y - min_z_) / cell_size_);
-		gx_t = std::max(0, std::min(gx_t, grid_w_ - 1));
-		gz_t = std::max(0, std::min(gz_t, grid_h_ - 1));
+	const double n = static_cast<double>(std::max<size_t>(pairs.size(), 1));
+	Dictionary ca;
+	ca["avg_us"] = cluster_us / n;
+	ca["avg_hops"] = static_cast<double>(cluster_hops) / n;
+	ca["failures"] = cluster_failures;
+	Dictionary sa;
+	sa["avg_us"] = sub_us / n;
+	sa["avg_hops"] = static_cast<double>(sub_hops) / n;
+	sa["failures"] = sub_failures;
+	Dictionary fp;
+	fp["avg_us"] = path_us / n;
+	fp["avg_length"] = length_sum / n;
+	fp["failures"] = path_failures;
+
+	// Storage: the structs hold only geometry, the SDF ranges live in
+	// parallel arrays, and per-cluster masks are one bit per cluster
+	const size_t nc = clusters_.size();
+	const size_t ns = sub_clusters_.size();
+	HpaClusterBits mask;
+	mask.assign(static_cast<int>(nc));
+	Dictionary mem;
+	mem["cluster_struct_bytes"] = static_cast<int64_t>(nc * sizeof(Cluster));
+	mem["sub_cluster_struct_bytes"] = static_cast<int64_t>(ns * sizeof(SubCluster));
+	mem["sdf_range_bytes"] = static_cast<int64_t>((nc + ns) * 2 * sizeof(float));
+	mem["cluster_mask_bytes"] = static_cast<int64_t>(mask.words.size() * sizeof(uint64_t));
+	mem["cluster_byte_mask_bytes"] = static_cast<int64_t>(nc);  // the vector<uint8_t> it replaced
+	mem["cluster_struct_size"] = static_cast<int>(sizeof(Cluster));
+	mem["sub_cluster_struct_size"] = static_cast<int>(sizeof(SubCluster));
+
+	result["cluster_astar"] = ca;
+	result["sub_cluster_astar"] = sa;
+	result["find_path"] = fp;
+	result["memory"] = mem;
+	result["queries"] = static_cast<int>(pairs.size());
+	UtilityFunctions::print("[HpaGraph] benchmark_cluster_storage: ", result);
+	return result;
+}
 
-		const float r2 = t.radius * t.radius;
+// ============================================================================
+// get_threat_set / rasterize_threats
+// ============================================================================
 
-		// Only candidate clusters whose AABB overlaps the threat circle are
-		// worth testing — avoids the previous O(clusters × threats) sweep.
-		std::vector<int> candidates = clusters_in_radius(t.origin, t.radius);
-		for (int cid : candidates) {
-			if (cluster_threat_blocked_[cid]) continue;  // already blocked by another threat
-			const Cluster &c = clusters_[cid];
-			if (!c.navigable) continue;
-
-			// Grid coords of the 4 cluster corner cells.
-			// Testing all corners (rather than just the centre) conservatively marks
-			// clusters where the threat has line-of-sight to any part of the boundary.
-			const int corner_gx[4] = { c.x0, c.x1, c.x0, c.x1 };
-			const int corner_gz[4] = { c.z0, c.z0, c.z1, c.z1 };
-
-			bool threatened = false;
-			for (int i = 0; i < 4 && !threatened; ++i) {
-				float wx, wz;
-				grid_to_world(corner_gx[i], corner_gz[i], wx, wz);
-				float dx = wx - t.origin.x;
-				float dz = wz - t.origin.y;
-				if (dx * dx + dz * dz > r2) continue;
+std::shared_ptr<const HpaThreatSet> HpaGraph::get_threat_set(
+		int team_id, int radius_bin, uint64_t bin_version,
+		const std::vector<ThreatCircle> &threats) const {
+	if (threats.empty()) return nullptr;
+
+	std::shared_lock<std::shared_mutex> structure_lock(structure_mutex_);
+	std::shared_lock<std::shared_mutex> map_lock = lock_map_shared();
+	std::shared_ptr<BinThreatState> state;
+	{
+		std::lock_guard<std::mutex> lock(threat_cache_mutex_);
+		std::shared_ptr<BinThreatState> &slot = threat_cache_[threat_bin_key(team_id, radius_bin)];
+		if (!slot) slot = std::make_shared<BinThreatState>();
+		state = slot;
+	}
+
+	// One thread updates a bin while the others wait for its result;
+	// different bins update in parallel.
+	std::lock_guard<std::mutex> lock(state->mutex);
+	const int n = static_cast<int>(clusters_.size());
+	if (state->structure_gen != structure_gen_) {
+		// Cluster navigability or the SDF changed — every LOS bit is stale
+		state->structure_gen = structure_gen_;
+		state->set.reset();
+		state->cover.assign(n, 0);
+		state->threats.clear();
+	}
+	if (state->set && state->bin_version == bin_version) return state->set;
+
+	// Re-trace every listed threat and diff its cluster list against the
+	// previous one; only clusters whose cover count crosses zero change.
+	std::vector<int> touched;
+	auto add = [&](int cid) { if (state->cover[cid]++ == 0) touched.push_back(cid); };
+	auto sub = [&](int cid) { if (--state->cover[cid] == 0) touched.push_back(cid); };
+
+	const uint64_t pass = ++state->pass;
+	std::vector<int> cids;
+	for (size_t i = 0; i < threats.size(); i++) {
+		const ThreatCircle &t = threats[i];
+		// Unidentified or repeated enemies get a slot by list position
+		int64_t id = (t.enemy_id != -1) ? t.enemy_id : INT64_MIN + static_cast<int64_t>(i);
+		auto it = state->threats.find(id);
+		if (it != state->threats.end() && it->second.pass == pass) {
+			id = INT64_MIN + static_cast<int64_t>(i);
+			it = state->threats.find(id);
+		}
+		ThreatVisibility &vis = (it != state->threats.end()) ? it->second : state->threats[id];
+		vis.pass = pass;
+
+		cids.clear();
+		trace_threat(t, vis, cids);
+		if (cids != vis.cids) {
+			for (int cid : vis.cids) sub(cid);
+			for (int cid : cids) add(cid);
+			vis.cids.swap(cids);
+		}
+	}
+	for (auto it = state->threats.begin(); it != state->threats.end();) {
+		if (it->second.pass != pass) {
+			for (int cid : it->second.cids) sub(cid);
+			it = state->threats.erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	state->bin_version = bin_version;
+	if (state->set && touched.empty()) return state->set;
+
+	// Queries may still hold the previous set, so publish a new one
+	const HpaThreatSet *prev = state->set.get();
+	auto set = std::make_shared<HpaThreatSet>();
+	set->id = next_threat_set_id_.fetch_add(1, std::memory_order_relaxed);
+	if (prev) {
+		set->blocked = prev->blocked;
+	} else {
+		set->blocked.assign(n);
+	}
+	std::sort(touched.begin(), touched.end());
+	touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+	for (int cid : touched) {
+		if (state->cover[cid] > 0) {
+			set->blocked.set(cid);
+		} else {
+			set->blocked.reset(cid);
+		}
+	}
+	if (prev) {
+		for (int cid : prev->cids) {
+			if (set->blocked.test(cid)) set->cids.push_back(cid);
+		}
+	}
+	for (int cid : touched) {
+		if (set->blocked.test(cid) && !(prev && prev->blocked.test(cid))) set->cids.push_back(cid);
+	}
+	state->set = set;
+	return state->set;
+}
+
+void HpaGraph::trace_threat(const ThreatCircle &t, ThreatVisibility &vis,
+							std::vector<int> &out_cids) const {
+	if (t.radius <= 0.0f || clusters_.empty() || !nav_map_.is_valid()) return;
+
+	int gx_t = static_cast<int>((t.origin.x - min_x_) / cell_size_);
+	int gz_t = static_cast<int>((t.origin.y - min_z_) / cell_size_);
+	gx_t = std::max(0, std::min(gx_t, grid_w_ - 1));
+	gz_t = std::max(0, std::min(gz_t, grid_h_ - 1));
+
+	// LOS is traced between cells, so the bits hold until the origin
+	// leaves its cell
+	if (vis.gx != gx_t || vis.gz != gz_t ||
+		vis.corner_los.size() != clusters_.size()) {
+		vis.gx = gx_t;
+		vis.gz = gz_t;
+		vis.corner_los.assign(clusters_.size(), 0);
+	}
+
+	const float r2 = t.radius * t.radius;
+	uint64_t traced = 0, cached = 0;
 
+	// Only candidate clusters whose AABB overlaps the threat circle are
+	// worth testing — avoids the previous O(clusters × threats) sweep.
+	std::vector<int> candidates = clusters_in_radius(t.origin, t.radius);
+	for (int cid : candidates) {
+		if (cluster_max_sdf_[cid] < clearance_) continue;
+		const Cluster &c = clusters_[cid];
+
+		// Grid coords of the 4 cluster corner cells.
+		// Testing all corners (rather than just the centre) conservatively marks
+		// clusters where the threat has line-of-sight to any part of the boundary.
+		const int corner_gx[4] = { c.x0, c.x1, c.x0, c.x1 };
+		const int corner_gz[4] = { c.z0, c.z0, c.z1, c.z1 };
+
+		uint8_t &bits = vis.corner_los[cid];
+		bool threatened = false;
+		for (int i = 0; i < 4 && !threatened; ++i) {
+			float wx, wz;
+			grid_to_world(corner_gx[i], corner_gz[i], wx, wz);
+			float dx = wx - t.origin.x;
+			float dz = wz - t.origin.y;
+			if (dx * dx + dz * dz > r2) continue;
+
+			if (bits & (1u << i)) {
+				cached++;
+			} else {
+				traced++;
+				bits |= static_cast<uint8_t>(1u << i);
 				if (nav_map_->line_of_sight(corner_gx[i], corner_gz[i], gx_t, gz_t, 0.0f)) {
-					threatened = true;
+					bits |= static_cast<uint8_t>(0x10u << i);
 				}
 			}
-
-			if (threatened) {
-				cluster_threat_blocked_[cid] = 1;
-				threat_blocked_cids_.push_back(cid);
-			}
+			threatened = (bits & (0x10u << i)) != 0;
 		}
-	}
 
-	threat_blocked_count_ = static_cast<int>(threat_blocked_cids_.size());
+		if (threatened) out_cids.push_back(cid);
+	}
+	threat_los_traced_.fetch_add(traced, std::memory_order_relaxed);
+	threat_los_cached_.fetch_add(cached, std::memory_order_relaxed);
 }
 
-void HpaGraph::clear_threats() {
-	std::fill(cluster_threat_blocked_.begin(), cluster_threat_blocked_.end(), 0);
-	threat_blocked_cids_.clear();
-	threat_blocked_count_ = 0;
+void HpaGraph::rasterize_threats(const std::vector<ThreatCircle> &threats,
+								 HpaThreatSet &out) const {
+	out.blocked.assign(static_cast<int>(clusters_.size()));
+	out.cids.clear();
+	std::vector<int> cids;
+	for (const ThreatCircle &t : threats) {
+		ThreatVisibility vis;
+		cids.clear();
+		trace_threat(t, vis, cids);
+		for (int cid : cids) {
+			if (out.blocked.test(cid)) continue;
+			out.blocked.set(cid);
+			out.cids.push_back(cid);
+		}
+	}
 }
 
 // ============================================================================
-// get_debug_threat_clusters
+// get_debug_threat_clusters / get_debug_threat_set
 // ============================================================================
 
 TypedArray<Dictionary> HpaGraph::get_debug_threat_clusters() const {
+	HpaThreatSet merged;
+	{
+		std::shared_lock<std::shared_mutex> structure_lock(structure_mutex_);
+		merged.blocked.assign(static_cast<int>(clusters_.size()));
+		std::lock_guard<std::mutex> lock(threat_cache_mutex_);
+		for (const auto &kv : threat_cache_) {
+			std::lock_guard<std::mutex> state_lock(kv.second->mutex);
+			if (!kv.second->set || kv.second->structure_gen != structure_gen_) continue;
+			for (int cid : kv.second->set->cids) {
+				if (cid < merged.blocked.size() && !merged.blocked.test(cid)) {
+					merged.blocked.set(cid);
+					merged.cids.push_back(cid);
+				}
+			}
+		}
+	}
+	return get_debug_threat_set(merged);
+}
+
+TypedArray<Dictionary> HpaGraph::get_debug_threat_set(const HpaThreatSet &threats) const {
 	TypedArray<Dictionary> out;
 	if (!built_) return out;
-	for (int cid = 0; cid < static_cast<int>(clusters_.size()); ++cid) {
-		if (cluster_threat_blocked_[cid] == 0) continue;
+	for (int cid : threats.cids) {
+		if (cid < 0 || cid >= static_cast<int>(clusters_.size())) continue;
 		const Cluster &cl = clusters_[cid];
 		float wx0, wz0, wx1, wz1;
 		grid_to_world(cl.x0, cl.z0, wx0, wz0);
@@ -1448,55 +3381,10 @@ TypedArray<Dictionary> HpaGraph::get_debug_threat_clusters() const {
 
 TypedArray<Dictionary> HpaGraph::compute_debug_threat_clusters(
 		const std::vector<ThreatCircle> &threats) const {
-	TypedArray<Dictionary> out;
-	if (!built_ || threats.empty() || !nav_map_.is_valid()) return out;
-
-	for (const Cluster &c : clusters_) {
-		if (!c.navigable) continue;
-
-		// Grid coords of the 4 cluster corner cells (mirrors stamp_threats logic).
-		const int corner_gx[4] = { c.x0, c.x1, c.x0, c.x1 };
-		const int corner_gz[4] = { c.z0, c.z0, c.z1, c.z1 };
-
-		bool blocked = false;
-		for (const ThreatCircle &t : threats) {
-			if (t.radius <= 0.0f) continue;
-
-			int gx_t = static_cast<int>((t.origin.x - min_x_) / cell_size_);
-			int gz_t = static_cast<int>((t.origin.y - min_z_) / cell_size_);
-			gx_t = std::max(0, std::min(gx_t, grid_w_ - 1));
-			gz_t = std::max(0, std::min(gz_t, grid_h_ - 1));
-
-			const float r2 = t.radius * t.radius;
-
-			for (int i = 0; i < 4 && !blocked; ++i) {
-				float wx, wz;
-				grid_to_world(corner_gx[i], corner_gz[i], wx, wz);
-				float dx = wx - t.origin.x;
-				float dz = wz - t.origin.y;
-				if (dx * dx + dz * dz > r2) continue;
-
-				if (nav_map_->line_of_sight(corner_gx[i], corner_gz[i], gx_t, gz_t, 0.0f)) {
-					blocked = true;
-				}
-			}
-
-			if (blocked) break;
-		}
-		if (!blocked) continue;
-
-		float wx0, wz0, wx1, wz1;
-		grid_to_world(c.x0, c.z0, wx0, wz0);
-		grid_to_world(c.x1, c.z1, wx1, wz1);
-		float hc = cell_size_ * 0.5f;
-		Dictionary d;
-		d["x0"] = wx0 - hc;
-		d["z0"] = wz0 - hc;
-		d["x1"] = wx1 + hc;
-		d["z1"] = wz1 + hc;
-		out.push_back(d);
-	}
-	return out;
+	if (!built_ || threats.empty() || !nav_map_.is_valid()) return TypedArray<Dictionary>();
+	HpaThreatSet set;
+	rasterize_threats(threats, set);
+	return get_debug_threat_set(set);
 }
 
 } // namespace godot
@@ -2,10 +2,15 @@
 #define HPA_GRAPH_H
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <queue>
+#include <shared_mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -13,10 +18,12 @@
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/array.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
 #include <godot_cpp/variant/packed_vector2_array.hpp>
 #include <godot_cpp/variant/typed_array.hpp>
 #include <godot_cpp/variant/vector2.hpp>
 
+#include "nav_heap.h"
 #include "nav_types.h"
 #include "navigation_map.h"
 
@@ -24,6 +31,11 @@ namespace godot {
 
 // ---------------------------------------------------------------------------
 // Plain data structures (no Godot reflection needed)
+//
+// Cluster and SubCluster hold the layout, which only build, refinement and
+// the debug views read.  The SDF range the searches test on every expansion
+// lives in HpaGraph's parallel arrays (cluster_max_sdf_ etc.); a cluster is
+// navigable when its max SDF reaches the build clearance.
 // ---------------------------------------------------------------------------
 
 struct Cluster {
@@ -33,11 +45,8 @@ struct Cluster {
 	int   x1, z1;        // inclusive cell range end
 	int   sub_x0, sub_z0; // inclusive sub-cluster grid range start (level 1.5)
 	int   sub_x1, sub_z1; // inclusive sub-cluster grid range end
-	float max_sdf;       // max SDF in cluster  (most open water cell)
-	float min_sdf;       // min SDF in cluster  (closest to land)
 	float wx_center;     // world X of cluster centre
 	float wz_center;     // world Z of cluster centre
-	bool  navigable;     // max_sdf >= build clearance
 };
 
 // ---------------------------------------------------------------------------
@@ -59,21 +68,148 @@ struct SubCluster {
 	int   scx, scz;      // sub-cluster grid coordinates (global)
 	int   x0, z0;        // inclusive cell range start (clamped to grid bounds)
 	int   x1, z1;        // inclusive cell range end
-	float max_sdf;       // max SDF in sub  (most open cell)
-	float min_sdf;       // min SDF in sub  (closest to land)
 	float wx_center;     // world X of sub centre
 	float wz_center;     // world Z of sub centre
-	bool  navigable;     // max_sdf >= build clearance
 };
 
 // ---------------------------------------------------------------------------
-// Obstacle record (circular, identified by caller-supplied id)
+// One bit per cluster: threat-blocked sets and corridor masks.  Bits past
+// size() read as clear.
+// ---------------------------------------------------------------------------
+
+struct HpaClusterBits {
+	std::vector<uint64_t> words;
+	int                   count = 0;
+
+	void assign(int n) {
+		count = n;
+		words.assign(static_cast<size_t>(n + 63) >> 6, 0);
+	}
+	int size() const { return count; }
+
+	inline bool test(int i) const {
+		return i >= 0 && i < count && ((words[i >> 6] >> (i & 63)) & 1u) != 0;
+	}
+	inline void set(int i) { words[i >> 6] |= uint64_t(1) << (i & 63); }
+	inline void reset(int i) { words[i >> 6] &= ~(uint64_t(1) << (i & 63)); }
+};
+
+// ---------------------------------------------------------------------------
+// HpaPortal — one entrance between two 4-adjacent clusters (HPA* transition).
+//
+// Every maximal run of border cell pairs passable at the build clearance
+// yields one portal, placed on the pair with the most clearance.  A portal
+// is two abstract nodes, node = portal * 2 + side, one in each cluster.
+// ---------------------------------------------------------------------------
+
+struct HpaPortal {
+	int   cid[2];        // clusters on either side (west / north first)
+	int   gx[2], gz[2];  // crossing cell on each side
+	float clearance;     // min SDF of the two cells — largest clearance that passes
+};
+
+// Intra-cluster edge table of one cluster.  Clearance buckets below
+// bucket_lo are open water for the whole cluster (straight edges); from
+// bucket_hi up no cell passes.  Only [bucket_lo, bucket_hi) is stored.
+struct HpaPortalTable {
+	uint32_t cost_begin;  // into portal_costs_ / portal_paths_: (hi - lo) × k × k entries
+	int32_t  bucket_lo;
+	int32_t  bucket_hi;
+};
+
+// Cached refinement of one stored intra-cluster edge (node i → j, i < j)
+struct HpaPortalPath {
+	uint32_t begin;  // first interior waypoint in portal_points_ (x, z pairs)
+	uint32_t count;
+};
+
+// ---------------------------------------------------------------------------
+// Obstacle record (circular, identified by caller-supplied id).  The
+// footprint is the cluster rect the circle sweeps over the obstacle horizon
+// at its current velocity; moves that keep it leave the block counts alone.
 // ---------------------------------------------------------------------------
 
 struct HpaObstacle {
 	int     id;
 	Vector2 pos;
+	Vector2 vel;         // m/s, zero when parked
 	float   radius;
+	int     cx0, cz0;    // inclusive footprint cluster range
+	int     cx1, cz1;
+};
+
+// ---------------------------------------------------------------------------
+// Obstacles bucketed by the clusters their footprints cover, as read by one
+// query (HpaGraph::snapshot_obstacles).  'items' lists obstacle indices
+// grouped by cluster; cluster c owns [cluster_begin[c], cluster_begin[c+1]).
+// ---------------------------------------------------------------------------
+
+struct HpaObstacleSet {
+	std::vector<HpaObstacle> obstacles;
+	std::vector<int32_t>     cluster_begin;  // per cluster + 1
+	std::vector<int32_t>     items;
+	float                    horizon   = 0.0f;  // seconds of motion predicted
+	float                    soft_cost = 0.0f;  // metres, cap per occupied cluster
+};
+
+// ---------------------------------------------------------------------------
+// Threat-blocked clusters for one threat set (see rasterize_threats).
+// 'blocked' has a bit per cluster, 'cids' lists the blocked ids compactly
+// for the LOS threat test.  'id' is unique per set published by
+// get_threat_set() (0 for sets built elsewhere) and keys the route cache.
+// ---------------------------------------------------------------------------
+
+struct HpaThreatSet {
+	HpaClusterBits   blocked;
+	std::vector<int> cids;
+	uint64_t         id = 0;
+};
+
+// ---------------------------------------------------------------------------
+// Blocked-cluster state read by one query.  Threat clusters are impassable.
+// Obstacles only cost: a cluster the query would cross while an obstacle is
+// predicted there (arrival time = route distance / speed) is charged the
+// wait for it to leave, capped at the set's soft_cost; speed 0 charges the
+// cap for every occupied cluster.  The start and goal clusters are free.
+// find_path() without a view snapshots the live obstacles; PathPlanner
+// workers get a snapshot taken on the main thread at submit.  Null members
+// block nothing.
+// ---------------------------------------------------------------------------
+
+struct HpaBlockView {
+	const HpaObstacleSet *obstacles = nullptr;  // from snapshot_obstacles()
+	const HpaThreatSet   *threats   = nullptr;  // from get_threat_set()
+	float                 speed     = 0.0f;     // querying ship, m/s
+};
+
+// ---------------------------------------------------------------------------
+// Progressive path from HpaGraph::begin_path().  'route' is the unpulled
+// portal route (from, ..., to), already followable; refine_path() string-
+// pulls it one anchor at a time into 'pulled'.  current() is the pulled
+// prefix followed by the rest of the route, so a follower can switch to
+// each refinement without losing its place (route_index /
+// waypoint_at_or_after).
+// ---------------------------------------------------------------------------
+
+struct HpaPathJob {
+	std::vector<Vector2> route;
+	std::vector<Vector2> pulled;        // ends at route[anchor]
+	std::vector<int32_t> pulled_index;  // route index of each pulled point
+	size_t   anchor        = 0;
+	float    clearance     = 0.0f;
+	std::shared_ptr<const HpaThreatSet> threats;
+	uint64_t structure_gen = 0;
+	bool     valid         = false;
+	bool     done          = false;
+
+	PathResult current() const;
+
+	/// Route index of waypoint i of current() (past the end continues
+	/// linearly, e.g. onto a destination the follower appended).
+	int route_index(int i) const;
+
+	/// First waypoint of current() at or after route index r.
+	int waypoint_at_or_after(int r) const;
 };
 
 // ---------------------------------------------------------------------------
@@ -82,22 +218,38 @@ struct HpaObstacle {
 // Level 0 : SDF grid cells (stored in NavigationMap).
 // Level 1 : Fixed-size rectangular clusters.
 //
-// Each cluster stores max_sdf and min_sdf (scanned at build time).
-// No portal/entrance nodes are precomputed.
+// Each cluster stores max_sdf and min_sdf (scanned at build time), and the
+// HPA* portals on its borders (HpaPortal).  For every clearance bucket in
+// PORTAL_BUCKET_CLEARANCES that a cluster is only partly passable at, the
+// cost and a string-pulled cell path between each pair of its portal nodes
+// are precomputed; buckets the whole cluster clears use straight edges.
 //
 // find_path(from, to, q_cl):
 //   1. Direct LOS shortcut with q_cl.
-//   2. A* over the cluster grid — skips clusters whose max_sdf < q_cl
-//      (no navigable cell for this ship).
-//   3. Assembles waypoints from open-water cluster centres; terrain
-//      clusters are bridged by NavigationMap::find_path_internal.
+//   2. Cross-cluster: A* over the portal graph at the smallest bucket
+//      >= q_cl, with the start and goal joined to their cluster's portals
+//      by a cell Dijkstra; refined from the cached intra-cluster paths.
+//   3. Otherwise (same cluster, q_cl above the ladder, no portal route):
+//      A* over the cluster grid, guide points from open-water cluster and
+//      sub-cluster centres, bridged by LOS / sub-cluster A* / cell A*.
 //   4. Greedy string-pulling with q_cl to remove redundant waypoints.
 //
 // "Open water" cluster: min_sdf >= q_cl (all cells safe for this ship).
 // "Terrain" cluster   : max_sdf >= q_cl but min_sdf < q_cl (has land).
 // "Impassable"        : max_sdf < q_cl (no navigable cell).
 //
-// Dynamic circular obstacles are handled by per-cluster block counts.
+// Dynamic circular obstacles are bucketed into the clusters they sweep over
+// the next obstacle_horizon seconds and add a time-dependent soft cost to
+// routes crossing those clusters (see HpaBlockView).
+//
+// Threat arcs are not stamped onto the graph: each query passes the
+// threat-blocked set of its navigator's ThreatRegistry bin, rasterized once
+// per bin version and cached, so one graph serves every team and bin.
+//
+// Threading: find_path(from, to, q_cl, view) and get_threat_set() may run
+// on worker threads (PathPlanner) while the main thread keeps updating
+// obstacles, which the view-based query does not read.  Cluster rescans
+// (build, read_cache, sync_with_map) wait for running queries.
 // ---------------------------------------------------------------------------
 
 class HpaGraph : public RefCounted {
@@ -107,6 +259,17 @@ public:
 	static constexpr int DEFAULT_CLUSTER_SIZE = 16;
 	static constexpr int DEFAULT_SUB_SIZE     = 4;
 
+	// Clearances (world metres) the intra-cluster portal edges are
+	// precomputed for, above the build clearance which is always the first
+	// bucket.  A query uses the smallest bucket >= its clearance.
+	// Dense over 200-600 m, where ShipNavigator's planning clearances
+	// (hull clearance + 200 m) fall.
+	static constexpr float PORTAL_BUCKET_CLEARANCES[] = {
+		100.0f, 150.0f, 200.0f, 225.0f, 250.0f, 275.0f, 300.0f, 325.0f,
+		350.0f, 375.0f, 400.0f, 425.0f, 450.0f, 475.0f, 500.0f, 525.0f,
+		550.0f, 575.0f, 600.0f, 700.0f, 800.0f,
+	};
+
 	// ------------------------------------------------------------------
 	// Lifecycle
 	// ------------------------------------------------------------------
@@ -131,21 +294,87 @@ public:
 	/// Find a path from world-space 'from' to 'to'.
 	/// query_clearance: ship clearance (ship_length/2 + ship_beam).  When
 	/// <= 0, falls back to the clearance passed to build().
+	/// Obstacles only add cost; see the overloads for threat-aware queries.
 	PathResult find_path(Vector2 from, Vector2 to,
 						 float query_clearance = -1.0f) const;
 
+	/// Obstacles plus the clusters in 'threats' (from get_threat_set()).
+	PathResult find_path(Vector2 from, Vector2 to, float query_clearance,
+						 const HpaThreatSet &threats) const;
+
+	/// Same query against an explicit blocked-cluster view instead of the
+	/// live obstacles.  Safe to call from worker threads.
+	PathResult find_path(Vector2 from, Vector2 to, float query_clearance,
+						 const HpaBlockView &view) const;
+
+	/// Budgeted find_path against the live obstacles: the portal route is
+	/// returned unpulled and refine_path() string-pulls it over later
+	/// frames.  Queries the portal graph cannot serve (same cluster, above
+	/// the bucket ladder) run find_path whole and come back done.
+	/// 'speed' is the ship's, for obstacle arrival times (see HpaBlockView).
+	HpaPathJob begin_path(Vector2 from, Vector2 to, float query_clearance,
+						  std::shared_ptr<const HpaThreatSet> threats,
+						  float speed = 0.0f) const;
+
+	/// Pull the job's route for about budget_us (at least one anchor).
+	/// Returns false when the clusters were rescanned since begin_path;
+	/// the job is stale and the caller should plan again.
+	bool refine_path(HpaPathJob &job, float budget_us) const;
+
 	/// Convenience wrapper — returns only the waypoint positions as a
 	/// PackedVector2Array for GDScript callers.
 	PackedVector2Array find_path_packed(Vector2 from, Vector2 to,
 										 float query_clearance = -1.0f) const;
 
+	// One-to-many ------------------------------------------------------
+
+	/// Travel-cost estimates (world metres) from 'from' to every target in
+	/// one Dijkstra over the portal graph, for ranking candidate
+	/// destinations without a find_path per candidate.  -1 = unreachable
+	/// (including the rare strait only open below the rounded-up bucket).
+	/// Costs are unpulled cell-path lengths at the query's portal bucket,
+	/// so they run slightly above find_path's total_distance; targets in
+	/// direct line of sight cost their straight-line distance.
+	std::vector<float> estimate_path_costs(Vector2 from, const std::vector<Vector2> &targets,
+										   float query_clearance, const HpaBlockView &view) const;
+
+	/// GDScript wrapper against the live obstacle counts.
+	PackedFloat32Array estimate_path_costs_packed(Vector2 from, const PackedVector2Array &targets,
+												  float query_clearance = -1.0f) const;
+
+	// Distance fields --------------------------------------------------
+
+	/// Build (or replace) distance field 'field_id' towards a goal region:
+	/// every point within goal_radius of one of 'goals'.  One Dijkstra over
+	/// the sub-clusters passable at 'clearance', so lookups are O(1).
+	/// Obstacles and threats are ignored.  Call again when the goal moves;
+	/// a map change rebuilds the field on its next lookup.
+	void set_distance_field(int field_id, const PackedVector2Array &goals,
+							float goal_radius, float clearance);
+	void remove_distance_field(int field_id);
+	void clear_distance_fields();
+	bool has_distance_field(int field_id) const;
+
+	/// Sailing distance (world metres) from 'pos' to the field's goal
+	/// region; 0 inside it, -1 when unreachable or no such field.
+	float get_field_distance(int field_id, Vector2 pos) const;
+
+	/// Unit direction downhill towards the goal region from 'pos' (the
+	/// next sub-cluster centre, or the goal itself next to the region).
+	/// Zero inside the region, when unreachable or no such field.
+	Vector2 get_field_direction(int field_id, Vector2 pos) const;
+
 	// Dynamic obstacles ------------------------------------------------
 
-	/// Register a circular obstacle.  All clusters whose axis-aligned
-	/// bounding box overlaps (pos, radius) have their block count
-	/// incremented; abstract edges that route through those clusters are
-	/// skipped until the obstacle is removed.
-	void add_obstacle(int id, Vector2 pos, float radius);
+	/// Register (or replace) a circular obstacle moving at 'velocity'.
+	/// Every cluster its circle sweeps within the obstacle horizon has its
+	/// block count incremented; routes crossing one while the obstacle is
+	/// predicted there pay the soft cost.
+	void add_obstacle(int id, Vector2 pos, float radius, Vector2 velocity = Vector2());
+
+	/// Update a registered obstacle's motion.  Only touches the block counts
+	/// when the footprint changes clusters.  Unknown ids are ignored.
+	void move_obstacle(int id, Vector2 pos, Vector2 velocity);
 
 	/// Unregister an obstacle by its id.  Block counts are decremented.
 	void remove_obstacle(int id);
@@ -153,21 +382,53 @@ public:
 	/// Unregister all obstacles at once.
 	void clear_obstacles();
 
+	/// Seconds of constant-velocity motion an obstacle's footprint covers.
+	void set_obstacle_horizon(float seconds);
+	float get_obstacle_horizon() const { return obstacle_horizon_; }
+
+	/// Largest cost (metres) one occupied cluster adds to a route.
+	void set_obstacle_soft_cost(float metres);
+	float get_obstacle_soft_cost() const { return obstacle_soft_cost_; }
+
+	// Route cache ------------------------------------------------------
+
+	/// Portal corridors kept for reuse between the same cluster pair,
+	/// clearance bucket and threat set (LRU).  0 disables the cache.
+	void set_route_cache_capacity(int capacity);
+	int get_route_cache_capacity() const { return route_cache_capacity_; }
+	void clear_route_cache();
+
+	/// The current obstacles bucketed by cluster, for a query view.  Shared
+	/// between calls until the obstacles change again.  Main thread only.
+	std::shared_ptr<const HpaObstacleSet> snapshot_obstacles() const;
+
+	// Map changes ------------------------------------------------------
+
+	/// Rescan the clusters and sub-clusters over cells whose SDF changed
+	/// since the last build/sync (NavigationMap::apply_land_patch), and the
+	/// portals and edge tables around them.  A version check only when
+	/// nothing changed.  Returns true if any cluster was rescanned.
+	bool sync_with_map();
+
 	// Statistics / debug -----------------------------------------------
 
-	// No portal nodes in the new design; returns 0 for backward compat.
-	int get_node_count()    const { return 0; }
+	// Portal nodes (two per portal)
+	int get_node_count()    const { return get_portal_count() * 2; }
+	int get_portal_count()  const { return static_cast<int>(portals_.size() - free_portals_.size()); }
 	int get_cluster_count() const { return static_cast<int>(clusters_.size()); }
 	int get_sub_cluster_count() const { return static_cast<int>(sub_clusters_.size()); }
+	PackedFloat32Array get_portal_clearance_buckets() const;
 
 	TypedArray<Dictionary> get_debug_nodes()    const;
+	TypedArray<Dictionary> get_debug_portals()  const;
 	TypedArray<Dictionary> get_debug_edges()    const;
 	TypedArray<Dictionary> get_debug_clusters() const;
 	TypedArray<Dictionary> get_debug_sub_clusters() const;
-	// Reads the currently-stamped global blocked state (reflects last stamp_threats call).
+	// Union of every cached bin's threat-blocked clusters.
 	TypedArray<Dictionary> get_debug_threat_clusters() const;
-	// Pure query: computes blocked clusters for the given threat set without touching
-	// cluster_threat_blocked_.  Always reflects the caller's own threat bin.
+	// Blocked clusters for one threat set, as AABB dictionaries.
+	TypedArray<Dictionary> get_debug_threat_set(const HpaThreatSet &threats) const;
+	// Pure query: rasterizes the given threats without using the cache.
 	TypedArray<Dictionary> compute_debug_threat_clusters(const std::vector<ThreatCircle> &threats) const;
 
 	// Performance diagnostics (query-time, runtime focused)
@@ -178,6 +439,24 @@ public:
 	void set_perf_tracking_enabled(bool enabled);
 	bool is_perf_tracking_enabled() const;
 
+	// Run the same random reachable queries (NavigationMap::
+	// benchmark_query_pairs) through cluster_astar, sub_cluster_astar and
+	// find_path at `clearance`.  Returns average time, hops / length and
+	// failures per search, plus the bytes held by the cluster structs, the
+	// parallel SDF range arrays and a per-cluster bitset.
+	Dictionary benchmark_cluster_storage(int queries = 200, float clearance = 150.0f);
+
+	// Cache serialization (C++ only, used by NavigationCache) ----------
+
+	/// Append the cluster layout, clusters, sub-clusters and portal graph
+	/// to the writer.
+	void write_cache(NavCacheWriter &w) const;
+
+	/// Restore a graph written by write_cache on top of 'map' (which must
+	/// match the map it was built from).  Obstacles and cached threat sets
+	/// start empty.
+	bool read_cache(NavCacheReader &r, Ref<NavigationMap> map);
+
 protected:
 	static void _bind_methods();
 
@@ -187,6 +466,7 @@ private:
 	// ------------------------------------------------------------------
 
 	Ref<NavigationMap>          nav_map_;
+	uint64_t                    map_version_  = 0;  // nav_map_ version the clusters reflect
 	float                       clearance_    = 0.0f;
 	int                         cluster_size_ = DEFAULT_CLUSTER_SIZE;
 	int                         sub_size_     = DEFAULT_SUB_SIZE;
@@ -206,30 +486,137 @@ private:
 	std::vector<Cluster>             clusters_;
 	std::vector<SubCluster>          sub_clusters_;
 
+	// SDF range per cluster / sub-cluster (parallel to clusters_ and
+	// sub_clusters_).  Subs wholly outside the cell grid hold -inf.
+	std::vector<float>               cluster_max_sdf_;     // most open water cell
+	std::vector<float>               cluster_min_sdf_;     // closest to land
+	std::vector<float>               sub_max_sdf_;
+	std::vector<float>               sub_min_sdf_;
+
 	// Per-cluster obstacle block counts (parallel to clusters_)
 	std::vector<int>                 cluster_block_count_;
 
-	// Per-cluster threat-arc blocked flags (parallel to clusters_).
-	// Stamped wholesale each time stamp_threats() is called.
-	// Separate from cluster_block_count_ so obstacle blocking and threat
-	// blocking can be cleared independently.
-	std::vector<uint8_t>             cluster_threat_blocked_;
+	// Portal graph (populated by build_portals())
+	std::vector<float>               portal_buckets_;      // build clearance + PORTAL_BUCKET_CLEARANCES above it
+	std::vector<HpaPortal>           portals_;             // cid -1 = free slot (see sync_portals)
+	std::vector<int32_t>             free_portals_;        // slots of portals_ a sync may reuse
+	std::vector<int32_t>             cluster_node_begin_;  // per cluster + 1: range into cluster_nodes_
+	std::vector<int32_t>             cluster_nodes_;       // portal node ids, grouped by cluster
+	std::vector<int32_t>             node_local_;          // node id -> index within its cluster's range
+	std::vector<HpaPortalTable>      portal_tables_;       // parallel to clusters_
+	std::vector<float>               portal_costs_;        // intra edge costs, INF = no path
+	std::vector<HpaPortalPath>       portal_paths_;        // parallel to portal_costs_
+	std::vector<float>               portal_points_;       // cached intra path waypoints (x, z)
+	bool                             portals_built_ = false;
+
+	// Route cache: portal node sequences and their refined corridors by
+	// (from cluster, to cluster, bucket, threat set id).  A hit redoes only
+	// the start and goal legs; entries are rechecked against the query's
+	// blocked clusters, since obstacles move every frame.
+	struct RouteKey {
+		int32_t  from_cid;
+		int32_t  to_cid;
+		int32_t  bucket;
+		uint64_t threat_id;
+		bool operator==(const RouteKey &o) const {
+			return from_cid == o.from_cid && to_cid == o.to_cid &&
+				bucket == o.bucket && threat_id == o.threat_id;
+		}
+	};
+	struct RouteKeyHash {
+		size_t operator()(const RouteKey &k) const {
+			uint64_t h = static_cast<uint32_t>(k.from_cid);
+			h = h * 0x9E3779B97F4A7C15ull ^ static_cast<uint32_t>(k.to_cid);
+			h = h * 0x9E3779B97F4A7C15ull ^ static_cast<uint32_t>(k.bucket);
+			h = h * 0x9E3779B97F4A7C15ull ^ k.threat_id;
+			return static_cast<size_t>(h ^ (h >> 29));
+		}
+	};
+	struct CachedRoute {
+		std::vector<int32_t> nodes;     // portal nodes, first in from_cid, last in to_cid
+		std::vector<Vector2> corridor;  // refined waypoints, first node .. last node
+		std::list<RouteKey>::iterator lru;
+	};
+	static constexpr int DEFAULT_ROUTE_CACHE_CAPACITY = 512;
+	int route_cache_capacity_ = DEFAULT_ROUTE_CACHE_CAPACITY;
+	mutable std::mutex route_cache_mutex_;
+	mutable std::list<RouteKey> route_lru_;  // most recent first
+	mutable std::unordered_map<RouteKey, CachedRoute, RouteKeyHash> route_cache_;
+	mutable uint64_t route_cache_hits_ = 0;
+	mutable uint64_t route_cache_misses_ = 0;
+	mutable uint64_t route_cache_stale_ = 0;      // found but blocked / unreachable legs
+	mutable uint64_t route_cache_evictions_ = 0;
+
+	// Source of HpaThreatSet::id
+	mutable std::atomic<uint64_t> next_threat_set_id_{ 1 };
+
+	// Distance fields by caller id.  Sub-cluster Dijkstra results towards
+	// a goal region; rebuilt lazily once structure_gen_ moves on.
+	struct DistanceField {
+		std::vector<Vector2> goals;
+		float                goal_radius   = 0.0f;
+		float                clearance     = 0.0f;
+		uint64_t             structure_gen = 0;
+		std::vector<float>   dist;  // per sub: metres from its centre to the region, INF = unreachable
+		std::vector<int32_t> next;  // per sub: downhill neighbour, -1 = seeded from the region / unreachable
+	};
+	mutable std::mutex field_mutex_;
+	mutable std::unordered_map<int, DistanceField> fields_;
+
+	// Visibility of the clusters around one threat.  The corner LOS bits
+	// only depend on the origin cell, so they are reused until the threat
+	// crosses into another cell; moving within the cell or a radius change
+	// only redoes the range tests.
+	struct ThreatVisibility {
+		int gx = -1, gz = -1;              // origin cell the LOS bits were traced from
+		std::vector<uint8_t> corner_los;   // per cluster: traced corners (bits 0-3) | visible corners (bits 4-7)
+		std::vector<int> cids;             // clusters this threat blocks
+		uint64_t pass = 0;                 // BinThreatState::pass that last listed it
+	};
+
+	// Threat-blocked set of one ThreatRegistry bin.  A new bin version
+	// re-traces each threat against its cached visibility and applies only
+	// the clusters whose cover count crossed zero.
+	struct BinThreatState {
+		std::mutex mutex;
+		uint64_t bin_version   = 0;
+		uint64_t structure_gen = 0;
+		uint64_t pass          = 0;
+		std::shared_ptr<const HpaThreatSet> set;
+		std::vector<uint16_t> cover;                          // per cluster: threats blocking it
+		std::unordered_map<int64_t, ThreatVisibility> threats; // by enemy id
+	};
+	mutable std::mutex threat_cache_mutex_;
+	mutable std::unordered_map<uint64_t, std::shared_ptr<BinThreatState>> threat_cache_;  // key = threat_bin_key
 
-	// Compact list of currently threat-blocked cluster ids.  Rebuilt by
-	// stamp_threats()/clear_threats() in lock-step with cluster_threat_blocked_,
-	// so threat_clear() iterates only the small subset instead of every cluster.
-	std::vector<int>                 threat_blocked_cids_;
+	// Corner LOS tests traced vs answered from a ThreatVisibility cache
+	mutable std::atomic<uint64_t> threat_los_traced_{ 0 };
+	mutable std::atomic<uint64_t> threat_los_cached_{ 0 };
 
-	// O(1) cached count of currently threat-blocked clusters; replaces the
-	// per-query linear scan that used to compute threat_layer_active.
-	int                              threat_blocked_count_ = 0;
+	// Bumped under structure_mutex_ whenever clusters are built or rescanned
+	uint64_t                         structure_gen_ = 0;
 
 	// Precomputed cluster A* step costs (cardinal / diagonal).  Set in build().
 	float                            cardinal_step_cost_ = 0.0f;
 	float                            diagonal_step_cost_ = 0.0f;
 
-	// Registered obstacles (keyed by id) for removal
+	// Registered obstacles (keyed by id); cluster_block_count_ counts their
+	// footprints per cluster
 	std::unordered_map<int, HpaObstacle> obstacles_;
+	static constexpr float DEFAULT_OBSTACLE_HORIZON   = 60.0f;    // seconds
+	static constexpr float DEFAULT_OBSTACLE_SOFT_COST = 1500.0f;  // metres
+	float obstacle_horizon_   = DEFAULT_OBSTACLE_HORIZON;
+	float obstacle_soft_cost_ = DEFAULT_OBSTACLE_SOFT_COST;
+
+	// Bumped on every obstacle change; snapshot_obstacles() reuses its last
+	// set while this is unchanged.
+	uint64_t                                              obstacle_version_ = 0;
+	mutable uint64_t                                      obstacle_snapshot_version_ = 0;
+	mutable std::shared_ptr<const HpaObstacleSet>         obstacle_snapshot_;
+
+	// Held shared by view queries, exclusively while clusters_ and
+	// sub_clusters_ are rebuilt or rescanned.
+	mutable std::shared_mutex structure_mutex_;
 
 	bool built_ = false;
 
@@ -281,6 +668,7 @@ private:
 	};
 
 	mutable PerfStats perf_;
+	mutable std::mutex perf_mutex_;  // queries finish on several threads
 	bool perf_tracking_enabled_ = false;
 
 	// ------------------------------------------------------------------
@@ -289,15 +677,42 @@ private:
 
 	void build_clusters();
 	void build_sub_clusters();
-
-	// Threat rasterization onto the Level-1 cluster grid.
-	// stamp_threats() tests every navigable cluster: clusters within a
-	// threat circle that have line-of-sight to the threat origin are marked
-	// blocked. clear_threats() zeroes the vector.
+	void scan_sdf_range(int x0, int z0, int x1, int z1, float &min_sdf, float &max_sdf) const;
+
+	// Portal graph: entrances, per-cluster node lists and edge tables
+	void build_portals();
+	void scan_portal_border(int cid_a, int cid_b, std::vector<HpaPortal> &out) const;
+	void build_portal_tables(const std::vector<uint8_t> &rebuild);
+	int sync_portals(const std::vector<uint8_t> &rescanned);
+	void collect_portal_nodes();
+	void index_portal_nodes();
+	bool portals_consistent() const;
+
+	// Threat rasterization onto the Level-1 cluster grid: navigable
+	// clusters within a threat circle that have line-of-sight to the threat
+	// origin are marked blocked.
 public:
-	void stamp_threats(const std::vector<ThreatCircle>& threats);
-	void clear_threats();
+	/// Threat-blocked clusters for the ThreatRegistry bin (team_id,
+	/// radius_bin) at bin_version.  Updated incrementally on the first call
+	/// for each version and shared by every later query against that bin;
+	/// returns null when 'threats' is empty.  Safe to call from worker
+	/// threads.
+	std::shared_ptr<const HpaThreatSet> get_threat_set(
+			int team_id, int radius_bin, uint64_t bin_version,
+			const std::vector<ThreatCircle>& threats) const;
 private:
+	// Uncached trace of every threat (debug queries)
+	void rasterize_threats(const std::vector<ThreatCircle>& threats,
+						   HpaThreatSet &out) const;
+
+	// Clusters 't' blocks, reusing and extending the LOS bits in 'vis'
+	void trace_threat(const ThreatCircle &t, ThreatVisibility &vis,
+					  std::vector<int> &out_cids) const;
+
+	static uint64_t threat_bin_key(int team_id, int radius_bin) {
+		return (static_cast<uint64_t>(static_cast<uint32_t>(team_id)) << 32) |
+			static_cast<uint32_t>(radius_bin);
+	}
 
 	// ------------------------------------------------------------------
 	// Query helpers
@@ -307,17 +722,20 @@ private:
 	/// from_cid to to_cid (inclusive), or empty if no path exists.
 	/// Clusters with max_sdf < q_cl are treated as impassable.
 	std::vector<int> cluster_astar(
-			int from_cid, int to_cid, float q_cl) const;
+			int from_cid, int to_cid, float q_cl,
+			const HpaBlockView &view) const;
 
 	/// A* over the sub-cluster grid.  Returns ordered sub-cluster IDs from
 	/// from_sid to to_sid (inclusive), or empty if no path exists.
 	/// Sub-clusters with max_sdf < q_cl are treated as impassable.
-	/// If allowed_macros is non-null, only sub-clusters whose parent_cid bit
-	/// is set in the supplied per-macro mask are considered passable.  This
-	/// constrains the search to a corridor of macros along an abstract path.
+	/// If allowed_macros is non-null, only sub-clusters whose parent cluster
+	/// bit is set in the supplied per-macro mask are considered passable.
+	/// This constrains the search to a corridor of macros along an abstract
+	/// path.
 	std::vector<int> sub_cluster_astar(
 			int from_sid, int to_sid, float q_cl,
-			const std::vector<uint8_t>* allowed_macros = nullptr) const;
+			const HpaBlockView &view,
+			const HpaClusterBits *allowed_macros = nullptr) const;
 
 	// ------------------------------------------------------------------
 	// Inline coordinate / SDF helpers
@@ -335,6 +753,15 @@ private:
 		return std::min(gz / cluster_size_, ncz_ - 1);
 	}
 
+	// Grid cell containing a world X / Z, clamped to the grid
+	inline int world_to_gx(float wx) const {
+		return std::max(0, std::min(static_cast<int>((wx - min_x_) / cell_size_), grid_w_ - 1));
+	}
+
+	inline int world_to_gz(float wz) const {
+		return std::max(0, std::min(static_cast<int>((wz - min_z_) / cell_size_), grid_h_ - 1));
+	}
+
 	// --- Sub-cluster indexing ---
 
 	inline int sub_id(int scx, int scz) const {
@@ -349,6 +776,10 @@ private:
 		return std::min(gz / sub_size_, nsubz_ - 1);
 	}
 
+	inline int sub_parent_cid(int scx, int scz) const {
+		return cluster_id(scx / subs_per_macro_side_, scz / subs_per_macro_side_);
+	}
+
 	inline void grid_to_world(int gx, int gz, float &wx, float &wz) const {
 		wx = min_x_ + (static_cast<float>(gx) + 0.5f) * cell_size_;
 		wz = min_z_ + (static_cast<float>(gz) + 0.5f) * cell_size_;
@@ -362,17 +793,81 @@ private:
 		return nav_map_->get_distance(wx, wz) >= clearance_;
 	}
 
-	inline bool cluster_blocked(int cid) const {
-		if (cid < 0 || cid >= static_cast<int>(cluster_block_count_.size()))
-			return false;
-		return cluster_block_count_[cid] > 0 || cluster_threat_blocked_[cid] != 0;
+	// Threat-blocked (impassable) for this view; obstacles go through
+	// obstacle_cost instead
+	inline bool cluster_blocked(int cid, const HpaBlockView &view) const {
+		return view.threats && view.threats->blocked.test(cid);
 	}
 
+	/// Extra route cost (metres) of entering cluster cid 'g' metres along
+	/// the route: the wait for the last obstacle predicted there at the
+	/// arrival time to leave, capped at the soft cost.  0 when unoccupied.
+	float obstacle_cost(int cid, float g, const HpaBlockView &view) const;
+
+	/// Footprint cluster range of 'obs' over the obstacle horizon
+	void obstacle_footprint(HpaObstacle &obs) const;
+
+	// --- Portal graph queries ---
+
+	/// Index of the smallest portal bucket >= q_cl, or -1 above the ladder.
+	int portal_bucket(float q_cl) const;
+
+	/// Intra-cluster cost between local portal nodes i and j at 'bucket'
+	/// (INF when not connected).  'path' receives the cached waypoints, or
+	/// null for a straight edge.
+	float portal_edge_cost(int cid, int bucket, int i, int j,
+						   const HpaPortalPath **path) const;
+
+	/// SDF at every cell of the cluster, row-major over its cell range.
+	void cluster_cell_sdf(const Cluster &c, std::vector<float> &sdf) const;
+
+	/// 8-connected Dijkstra over the cluster's cells with SDF >= clearance
+	/// from cell (sx, sz), which itself is exempt.  dist / parent are
+	/// indexed like cluster_cell_sdf; costs are in world metres.
+	void cluster_cell_dijkstra(const Cluster &c, const std::vector<float> &sdf,
+							   int sx, int sz, float clearance,
+							   std::vector<float> &dist, std::vector<int> &parent) const;
+
+	/// Greedy LOS pull of a cell chain at 'clearance'; appends the world
+	/// positions of the kept interior cells (not the two ends) to 'out'.
+	void pull_cell_chain(const std::vector<int> &cells, float clearance,
+						 std::vector<float> &out) const;
+
+	/// Shared hold on the NavigationMap's query mutex, so a land patch
+	/// cannot rewrite the grids under a running search.  Take it after
+	/// structure_mutex_ (which guards nav_map_); empty before build().
+	std::shared_lock<std::shared_mutex> lock_map_shared() const;
+
+	/// Fill f.dist / f.next for the current sub-clusters.  Called with
+	/// structure_mutex_ held (either way), and field_mutex_ when 'f' is in
+	/// fields_.
+	void compute_distance_field(DistanceField &f) const;
+
+	/// Field 'field_id', rebuilt first if the sub-clusters changed; null
+	/// when there is none.  Called with both locks held as above.
+	const DistanceField *current_distance_field(int field_id) const;
+
+	/// False when the segment clips a cluster in 'threats' (null = clear).
+	bool segment_threat_clear(Vector2 a, Vector2 b, const HpaThreatSet *threats) const;
+
+	/// Greedy string-pull step: the farthest point after 'anchor' in
+	/// line of sight at 'clearance' and threat-clear (at least anchor + 1).
+	size_t pull_farthest(const std::vector<Vector2> &points, size_t anchor,
+						 float clearance, const HpaThreatSet *threats) const;
+
+	/// HPA* over the portal graph between different clusters, through the
+	/// route cache.  Fills 'route' (from, ..., to) and returns true when a
+	/// route exists.
+	bool portal_route(Vector2 from, Vector2 to, float q_cl,
+					  int from_cid, int to_cid, const HpaBlockView &view,
+					  std::vector<Vector2> &route, int &expanded) const;
+
 	/// Corridor-constrained cell A* used by HPA refinement when LOS/sub-cluster
 	/// connectors cannot directly bridge a guide segment.
 	PathResult constrained_cell_astar(
 			Vector2 from, Vector2 to, float q_cl,
-			const std::vector<uint8_t> &allowed_macros) const;
+			const HpaClusterBits &allowed_macros,
+			const HpaBlockView &view) const;
 
 	/// Return all cluster ids whose AABB overlaps the circle (pos, radius).
 	std::vector<int> clusters_in_radius(Vector2 pos, float radius) const;
@@ -0,0 +1,83 @@
+#ifndef NAV_CACHE_IO_H
+#define NAV_CACHE_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace godot {
+
+// ---------------------------------------------------------------------------
+// Byte stream helpers for the navigation cache (see NavigationCache).
+// Values are stored in native layout: caches are only valid for the build
+// that wrote them, which the cache key and format version already enforce.
+// ---------------------------------------------------------------------------
+
+struct NavCacheWriter {
+	std::vector<uint8_t> data;
+
+	template <typename T>
+	void write(const T &value) {
+		static_assert(std::is_trivially_copyable<T>::value, "NavCacheWriter::write needs a POD type");
+		size_t base = data.size();
+		data.resize(base + sizeof(T));
+		std::memcpy(data.data() + base, &value, sizeof(T));
+	}
+
+	template <typename T>
+	void write_vector(const std::vector<T> &values) {
+		static_assert(std::is_trivially_copyable<T>::value, "NavCacheWriter::write_vector needs a POD type");
+		write<uint64_t>(values.size());
+		size_t base = data.size();
+		data.resize(base + values.size() * sizeof(T));
+		if (!values.empty()) {
+			std::memcpy(data.data() + base, values.data(), values.size() * sizeof(T));
+		}
+	}
+};
+
+struct NavCacheReader {
+	const uint8_t *data = nullptr;
+	size_t size = 0;
+	size_t pos = 0;
+	bool ok = true;  // sticky: false after the first short or malformed read
+
+	NavCacheReader(const uint8_t *p_data, size_t p_size) : data(p_data), size(p_size) {}
+
+	template <typename T>
+	bool read(T &out) {
+		static_assert(std::is_trivially_copyable<T>::value, "NavCacheReader::read needs a POD type");
+		if (!ok || size - pos < sizeof(T)) {
+			ok = false;
+			return false;
+		}
+		std::memcpy(&out, data + pos, sizeof(T));
+		pos += sizeof(T);
+		return true;
+	}
+
+	/// Read a length-prefixed vector; fails if it would run past the end
+	/// of the buffer or exceeds max_count elements.
+	template <typename T>
+	bool read_vector(std::vector<T> &out, uint64_t max_count) {
+		static_assert(std::is_trivially_copyable<T>::value, "NavCacheReader::read_vector needs a POD type");
+		uint64_t count = 0;
+		if (!read(count)) return false;
+		if (count > max_count || count > (size - pos) / sizeof(T)) {
+			ok = false;
+			return false;
+		}
+		out.resize(static_cast<size_t>(count));
+		if (count > 0) {
+			std::memcpy(out.data(), data + pos, static_cast<size_t>(count) * sizeof(T));
+		}
+		pos += static_cast<size_t>(count) * sizeof(T);
+		return true;
+	}
+};
+
+} // namespace godot
+
+#endif // NAV_CACHE_IO_H
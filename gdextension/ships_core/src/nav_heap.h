@@ -0,0 +1,117 @@
+#ifndef NAV_HEAP_H
+#define NAV_HEAP_H
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace godot {
+
+// ---------------------------------------------------------------------------
+// NavQuadHeap — open list shared by every A* in the navigation code (cell
+// A*, JPS+, HPA cluster / sub-cluster / constrained cell searches).
+//
+// A 4-ary min-heap of (key, id) over dense ids in [0, capacity) with
+// decrease-key: each id is in the heap at most once, so finding a cheaper
+// g-cost moves the entry up instead of pushing a stale copy that has to be
+// popped and skipped later.  Four children per node halve the depth of a
+// binary heap, and the four child keys share a cache line.
+//
+// A monotone radix/bucket heap was not used: the planners step diagonals at
+// 1.414 against Euclidean/octile heuristics, so popped f-values are not
+// strictly monotone.
+// ---------------------------------------------------------------------------
+
+class NavQuadHeap {
+public:
+	using Entry = std::pair<float, int>;  // (key, id), same shape as the old priority_queue entries
+
+	// Size the id -> slot index.  Clears the heap when the capacity changes.
+	void reserve_ids(int capacity) {
+		if (static_cast<int>(pos_.size()) == capacity) return;
+		heap_.clear();
+		pos_.assign(capacity, -1);
+	}
+
+	bool empty() const { return heap_.empty(); }
+	int size() const { return static_cast<int>(heap_.size()); }
+	bool contains(int id) const { return pos_[id] >= 0; }
+
+	// O(size): only the ids still queued need their slot reset
+	void clear() {
+		for (const Entry &e : heap_) {
+			pos_[e.second] = -1;
+		}
+		heap_.clear();
+	}
+
+	// Insert id, or lower its key if it is already queued (a higher key is ignored)
+	void push(int id, float key) {
+		int slot = pos_[id];
+		if (slot < 0) {
+			slot = static_cast<int>(heap_.size());
+			heap_.push_back({ key, id });
+		} else if (key < heap_[slot].first) {
+			heap_[slot].first = key;
+		} else {
+			return;
+		}
+		sift_up(slot);
+	}
+
+	// Remove and return the entry with the smallest key
+	Entry pop() {
+		Entry top = heap_.front();
+		pos_[top.second] = -1;
+		Entry last = heap_.back();
+		heap_.pop_back();
+		if (!heap_.empty()) {
+			heap_[0] = last;
+			pos_[last.second] = 0;
+			sift_down(0);
+		}
+		return top;
+	}
+
+private:
+	std::vector<Entry> heap_;
+	std::vector<int32_t> pos_;  // slot of each id in heap_, -1 = not queued
+
+	void sift_up(int slot) {
+		Entry e = heap_[slot];
+		while (slot > 0) {
+			int parent = (slot - 1) >> 2;
+			if (!(e.first < heap_[parent].first)) break;
+			heap_[slot] = heap_[parent];
+			pos_[heap_[slot].second] = slot;
+			slot = parent;
+		}
+		heap_[slot] = e;
+		pos_[e.second] = slot;
+	}
+
+	void sift_down(int slot) {
+		const int n = static_cast<int>(heap_.size());
+		Entry e = heap_[slot];
+		while (true) {
+			int first = (slot << 2) + 1;
+			if (first >= n) break;
+			int best = first;
+			int last = std::min(first + 4, n);
+			for (int c = first + 1; c < last; c++) {
+				if (heap_[c].first < heap_[best].first) best = c;
+			}
+			if (!(heap_[best].first < e.first)) break;
+			heap_[slot] = heap_[best];
+			pos_[heap_[slot].second] = slot;
+			slot = best;
+		}
+		heap_[slot] = e;
+		pos_[e.second] = slot;
+	}
+};
+
+} // namespace godot
+
+#endif // NAV_HEAP_H
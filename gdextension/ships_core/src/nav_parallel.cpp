@@ -0,0 +1,103 @@
+#include "nav_parallel.h"
+
+namespace godot {
+
+namespace {
+std::mutex pool_instance_mutex;
+std::unique_ptr<NavThreadPool> pool_instance;
+} // namespace
+
+NavThreadPool &NavThreadPool::get() {
+	std::lock_guard<std::mutex> lock(pool_instance_mutex);
+	if (!pool_instance) {
+		const int hw = static_cast<int>(std::thread::hardware_concurrency());
+		pool_instance.reset(new NavThreadPool(std::max(0, hw - 1)));
+	}
+	return *pool_instance;
+}
+
+void NavThreadPool::shutdown() {
+	std::lock_guard<std::mutex> lock(pool_instance_mutex);
+	pool_instance.reset();
+}
+
+NavThreadPool::NavThreadPool(int workers) {
+	workers_.reserve(workers);
+	for (int i = 0; i < workers; i++) {
+		workers_.emplace_back(&NavThreadPool::worker_loop, this);
+	}
+}
+
+NavThreadPool::~NavThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopping_ = true;
+	}
+	work_cv_.notify_all();
+	for (std::thread &t : workers_) {
+		t.join();
+	}
+}
+
+void NavThreadPool::run(int count, const std::function<void(int)> &fn) {
+	if (count <= 0) return;
+	if (workers_.empty() || count == 1) {
+		for (int i = 0; i < count; i++) fn(i);
+		return;
+	}
+
+	auto batch = std::make_shared<Batch>();
+	batch->fn = &fn;
+	batch->count = count;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		queue_.push_back(batch);
+	}
+	work_cv_.notify_all();
+
+	finish(*batch, work_on(*batch));
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	done_cv_.wait(lock, [&batch]() { return batch->done == batch->count; });
+}
+
+int NavThreadPool::work_on(Batch &batch) {
+	int ran = 0;
+	for (int i = batch.next.fetch_add(1); i < batch.count; i = batch.next.fetch_add(1)) {
+		(*batch.fn)(i);
+		ran++;
+	}
+	return ran;
+}
+
+void NavThreadPool::finish(Batch &batch, int ran) {
+	bool complete;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		// Every index is claimed once work_on returns: nothing left to hand out
+		for (auto it = queue_.begin(); it != queue_.end(); ++it) {
+			if (it->get() == &batch) {
+				queue_.erase(it);
+				break;
+			}
+		}
+		batch.done += ran;
+		complete = batch.done == batch.count;
+	}
+	if (complete) done_cv_.notify_all();
+}
+
+void NavThreadPool::worker_loop() {
+	for (;;) {
+		std::shared_ptr<Batch> batch;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			work_cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+			if (stopping_) return;
+			batch = queue_.front();
+		}
+		finish(*batch, work_on(*batch));
+	}
+}
+
+} // namespace godot
@@ -0,0 +1,104 @@
+#ifndef NAV_PARALLEL_H
+#define NAV_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace godot {
+
+// ---------------------------------------------------------------------------
+// NavThreadPool — persistent workers behind nav_parallel_for.
+//
+// Started on first use with one thread fewer than the hardware thread count
+// and kept until shutdown() (module uninitialization), so the per-call cost
+// is a queue push and a wake-up instead of thread creation.
+//
+// A batch is fn(0) .. fn(count - 1).  The submitting thread works through
+// its own batch alongside the workers and only sleeps once every index has
+// been claimed, so a batch always completes — including one submitted from
+// inside another batch, or while other threads' batches hold the workers.
+// ---------------------------------------------------------------------------
+
+class NavThreadPool {
+public:
+	static NavThreadPool &get();
+
+	/// Join the workers.  A later get() starts them again.
+	static void shutdown();
+
+	int get_worker_count() const { return static_cast<int>(workers_.size()); }
+
+	/// Run fn(i) for every i in [0, count) and return once all have finished
+	void run(int count, const std::function<void(int)> &fn);
+
+	~NavThreadPool();
+
+private:
+	struct Batch {
+		const std::function<void(int)> *fn = nullptr;
+		int count = 0;
+		std::atomic<int> next{ 0 };
+		int done = 0;  // guarded by mutex_
+	};
+
+	explicit NavThreadPool(int workers);
+
+	void worker_loop();
+
+	// Claim and run indices of 'batch' until none are left.  Returns the
+	// number this thread ran.
+	static int work_on(Batch &batch);
+
+	// Record 'ran' finished indices of 'batch', waking its submitter
+	void finish(Batch &batch, int ran);
+
+	std::vector<std::thread> workers_;
+	std::mutex mutex_;
+	std::condition_variable work_cv_;   // a batch was queued, or stopping
+	std::condition_variable done_cv_;   // a batch finished
+	std::deque<std::shared_ptr<Batch>> queue_;  // batches with unclaimed indices
+	bool stopping_ = false;
+};
+
+// ---------------------------------------------------------------------------
+// nav_parallel_for — split [0, count) into contiguous chunks and run
+// fn(begin, end) on each, one chunk per hardware thread, on NavThreadPool.
+// The calling thread takes part; the call returns once every chunk has
+// finished.
+//
+// Used by the build-time passes (SDF, scans), which are embarrassingly
+// parallel over rows or columns.  Chunks are never smaller than min_chunk,
+// so small grids stay on the calling thread; max_threads > 0 caps the number
+// of chunks.  fn must only write to disjoint output ranges.
+// ---------------------------------------------------------------------------
+
+template <typename F>
+inline void nav_parallel_for(int count, int min_chunk, F &&fn, int max_threads = 0) {
+	if (count <= 0) return;
+
+	int hw = static_cast<int>(std::thread::hardware_concurrency());
+	if (max_threads > 0) hw = std::min(std::max(hw, 1), max_threads);
+	int chunks = std::max(1, std::min(hw, count / std::max(1, min_chunk)));
+	if (chunks <= 1) {
+		fn(0, count);
+		return;
+	}
+
+	const int per_chunk = (count + chunks - 1) / chunks;
+	chunks = (count + per_chunk - 1) / per_chunk;
+	NavThreadPool::get().run(chunks, [&fn, count, per_chunk](int c) {
+		const int begin = c * per_chunk;
+		fn(begin, std::min(count, begin + per_chunk));
+	});
+}
+
+} // namespace godot
+
+#endif // NAV_PARALLEL_H
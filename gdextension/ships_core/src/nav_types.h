@@ -12,6 +12,9 @@
 #include <functional>
 #include <cmath>
 #include <limits>
+#include <memory>
+
+#include "nav_heap.h"
 
 namespace godot {
 
@@ -36,6 +39,24 @@ enum WaypointFlags : uint8_t {
 	WP_DEPARTURE       = 1 << 2,  // Departure/recovery waypoint (prepended by planner)
 };
 
+// Cell-level planner run by NavigationMap::begin_path_search
+enum CellPlanner : uint8_t {
+	CELL_PLANNER_SDF_JUMP = 0,  // 8-neighbour A* with SDF sphere-trace jumps
+	CELL_PLANNER_JPS_PLUS = 1,  // Jump Point Search over precomputed jump distances
+};
+
+// JPS+ jump distances for one clearance bucket (NavigationMap::get_jps_table).
+// A cell is open when its SDF >= clearance; diagonal steps need both
+// orthogonal neighbours open.  dist[cell * 8 + d] (row-major cell, dx8/dz8
+// direction order): > 0 = steps to the next jump point, <= 0 = minus the
+// steps that can be taken before running into a closed cell.
+struct JpsTable {
+	float clearance = 0.0f;
+	int width = 0;
+	int height = 0;
+	std::vector<int16_t> dist;
+};
+
 // Result of pathfinding
 struct PathResult {
 	std::vector<Vector2> waypoints;
@@ -322,9 +343,8 @@ struct PathSearch {
     std::vector<uint32_t> closed_gen;
     uint32_t current_gen = 0;
 
-    // Priority queue
-    using PQEntry = std::pair<float, int>;
-    std::priority_queue<PQEntry, std::vector<PQEntry>, std::greater<PQEntry>> open_set;
+    // Open list (f-cost keyed, decrease-key on cell index)
+    NavQuadHeap open_set;
 
     // Search parameters (set by begin_path_search)
     int sx = 0, sz = 0, ex = 0, ez = 0;
@@ -337,6 +357,11 @@ struct PathSearch {
     Vector2 from, to;
     float clearance = 0;  // original clearance param (for post-processing)
 
+    // Cell planner for this search; JPS+ searches hold their table so a
+    // land patch evicting it from the map's cache does not pull it away
+    uint8_t planner = CELL_PLANNER_SDF_JUMP;
+    std::shared_ptr<const JpsTable> jps;
+
     // Progress tracking
     int iterations = 0;
     int max_iterations = 200000;
@@ -356,17 +381,18 @@ struct PathSearch {
         parent_dir.resize(total_cells);
         open_gen.resize(total_cells, 0);
         closed_gen.resize(total_cells, 0);
+        open_set.reserve_ids(total_cells);
         current_gen = 0;
     }
 
     void reset() {
-        // Clear PQ (no clear() on std::priority_queue, swap with empty)
-        std::priority_queue<PQEntry, std::vector<PQEntry>, std::greater<PQEntry>> empty_pq;
-        open_set.swap(empty_pq);
+        open_set.clear();
         iterations = 0;
         found = false;
         active = false;
         complete = false;
+        planner = CELL_PLANNER_SDF_JUMP;
+        jps.reset();
         result = PathResult();
     }
 };
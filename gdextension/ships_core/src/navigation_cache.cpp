@@ -0,0 +1,240 @@
+#include "navigation_cache.h"
+
+#include <godot_cpp/classes/box_shape3d.hpp>
+#include <godot_cpp/classes/collision_shape3d.hpp>
+#include <godot_cpp/classes/concave_polygon_shape3d.hpp>
+#include <godot_cpp/classes/convex_polygon_shape3d.hpp>
+#include <godot_cpp/classes/cylinder_shape3d.hpp>
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/shape3d.hpp>
+#include <godot_cpp/classes/sphere_shape3d.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/transform3d.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <cstring>
+
+#include "nav_cache_io.h"
+
+using namespace godot;
+
+namespace {
+
+// 64-bit FNV-1a, used for both the cache key and the payload checksum
+constexpr uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME  = 0x100000001b3ULL;
+
+struct Fnv1a {
+	uint64_t h = FNV_OFFSET;
+
+	void bytes(const void *data, size_t size) {
+		const uint8_t *p = static_cast<const uint8_t *>(data);
+		for (size_t i = 0; i < size; i++) {
+			h ^= p[i];
+			h *= FNV_PRIME;
+		}
+	}
+
+	template <typename T>
+	void value(const T &v) { bytes(&v, sizeof(T)); }
+
+	void transform(const Transform3D &t) {
+		for (int r = 0; r < 3; r++) {
+			value(t.basis.rows[r]);
+		}
+		value(t.origin);
+	}
+
+	void points(const PackedVector3Array &pts) {
+		value<int64_t>(pts.size());
+		if (pts.size() > 0) {
+			bytes(pts.ptr(), static_cast<size_t>(pts.size()) * sizeof(Vector3));
+		}
+	}
+};
+
+constexpr size_t HEADER_SIZE = sizeof(uint32_t) * 2 + sizeof(uint64_t) * 3;
+
+} // namespace
+
+void NavigationCache::_bind_methods() {
+	ClassDB::bind_static_method("NavigationCache", D_METHOD("compute_key", "island_bodies", "bounds", "cell_size", "hpa_clearance"), &NavigationCache::compute_key);
+	ClassDB::bind_static_method("NavigationCache", D_METHOD("save_cache", "path", "key", "map", "hpa"), &NavigationCache::save_cache);
+	ClassDB::bind_static_method("NavigationCache", D_METHOD("load_cache", "path", "key"), &NavigationCache::load_cache);
+}
+
+NavigationCache::NavigationCache() {}
+NavigationCache::~NavigationCache() {}
+
+// ============================================================================
+// Cache key
+// ============================================================================
+
+int64_t NavigationCache::compute_key(TypedArray<Node3D> island_bodies, Rect2 bounds,
+		float cell_size, float hpa_clearance) {
+	Fnv1a hash;
+	hash.value(FORMAT_VERSION);
+	hash.value(bounds);
+	hash.value(cell_size);
+	hash.value(hpa_clearance);
+	hash.value<int32_t>(HpaGraph::DEFAULT_CLUSTER_SIZE);
+	hash.value<int32_t>(HpaGraph::DEFAULT_SUB_SIZE);
+	for (float b : HpaGraph::PORTAL_BUCKET_CLEARANCES) {
+		hash.value<float>(b);
+	}
+	hash.value<int32_t>(NavigationMap::DEFAULT_SHORE_REFINEMENT);
+	hash.value<float>(NavigationMap::DEFAULT_SHORE_BAND);
+
+	// Mirrors the shape walk in NavigationMap::build_from_collision_shapes
+	for (int i = 0; i < island_bodies.size(); i++) {
+		Node3D *body = Object::cast_to<Node3D>(island_bodies[i]);
+		if (!body) continue;
+
+		hash.transform(body->get_global_transform());
+
+		for (int c = 0; c < body->get_child_count(); c++) {
+			CollisionShape3D *col_shape = Object::cast_to<CollisionShape3D>(body->get_child(c));
+			if (!col_shape) continue;
+
+			Ref<Shape3D> shape = col_shape->get_shape();
+			if (shape.is_null()) continue;
+
+			hash.transform(col_shape->get_transform());
+			CharString cls = shape->get_class().utf8();
+			hash.bytes(cls.get_data(), cls.length());
+
+			Ref<ConcavePolygonShape3D> concave = shape;
+			if (concave.is_valid()) {
+				hash.points(concave->get_faces());
+				continue;
+			}
+			Ref<ConvexPolygonShape3D> convex = shape;
+			if (convex.is_valid()) {
+				hash.points(convex->get_points());
+				continue;
+			}
+			Ref<BoxShape3D> box = shape;
+			if (box.is_valid()) {
+				hash.value(box->get_size());
+				continue;
+			}
+			Ref<SphereShape3D> sphere = shape;
+			if (sphere.is_valid()) {
+				hash.value(sphere->get_radius());
+				continue;
+			}
+			Ref<CylinderShape3D> cylinder = shape;
+			if (cylinder.is_valid()) {
+				hash.value(cylinder->get_radius());
+				hash.value(cylinder->get_height());
+				continue;
+			}
+		}
+	}
+
+	return static_cast<int64_t>(hash.h);
+}
+
+// ============================================================================
+// Save / load
+// ============================================================================
+
+bool NavigationCache::save_cache(const String &path, int64_t key,
+		Ref<NavigationMap> map, Ref<HpaGraph> hpa) {
+	if (map.is_null() || !map->is_built() || hpa.is_null() || !hpa->is_built()) {
+		UtilityFunctions::push_warning("[NavigationCache] save_cache: map or HPA graph is not built");
+		return false;
+	}
+
+	NavCacheWriter payload;
+	map->write_cache(payload);
+	hpa->write_cache(payload);
+
+	Fnv1a checksum;
+	checksum.bytes(payload.data.data(), payload.data.size());
+
+	NavCacheWriter header;
+	header.write<uint32_t>(MAGIC);
+	header.write<uint32_t>(FORMAT_VERSION);
+	header.write<uint64_t>(static_cast<uint64_t>(key));
+	header.write<uint64_t>(payload.data.size());
+	header.write<uint64_t>(checksum.h);
+
+	PackedByteArray bytes;
+	bytes.resize(static_cast<int64_t>(header.data.size() + payload.data.size()));
+	std::memcpy(bytes.ptrw(), header.data.data(), header.data.size());
+	std::memcpy(bytes.ptrw() + header.data.size(), payload.data.data(), payload.data.size());
+
+	DirAccess::make_dir_recursive_absolute(path.get_base_dir());
+	Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+	if (file.is_null()) {
+		UtilityFunctions::push_warning("[NavigationCache] save_cache: cannot open ", path, " for writing");
+		return false;
+	}
+	file->store_buffer(bytes);
+	bool ok = file->get_error() == OK;
+	file->close();
+
+	UtilityFunctions::print("[NavigationCache] wrote ", path, " (", bytes.size() / 1024, " KiB)");
+	return ok;
+}
+
+Dictionary NavigationCache::load_cache(const String &path, int64_t key) {
+	if (!FileAccess::file_exists(path)) {
+		return Dictionary();
+	}
+
+	// One read of the whole file; the grids are copied straight out of it
+	PackedByteArray bytes = FileAccess::get_file_as_bytes(path);
+	NavCacheReader header(bytes.ptr(), static_cast<size_t>(bytes.size()));
+
+	uint32_t magic = 0, version = 0;
+	uint64_t file_key = 0, payload_size = 0, payload_checksum = 0;
+	header.read(magic);
+	header.read(version);
+	header.read(file_key);
+	header.read(payload_size);
+	header.read(payload_checksum);
+	if (!header.ok || magic != MAGIC || version != FORMAT_VERSION) {
+		UtilityFunctions::print("[NavigationCache] ", path, ": unrecognised or outdated cache, ignoring");
+		return Dictionary();
+	}
+	if (file_key != static_cast<uint64_t>(key)) {
+		UtilityFunctions::print("[NavigationCache] ", path, ": key mismatch (map geometry or settings changed), ignoring");
+		return Dictionary();
+	}
+	if (payload_size != static_cast<uint64_t>(bytes.size()) - HEADER_SIZE) {
+		UtilityFunctions::push_warning("[NavigationCache] ", path, ": truncated cache, ignoring");
+		return Dictionary();
+	}
+
+	const uint8_t *payload = bytes.ptr() + HEADER_SIZE;
+	Fnv1a checksum;
+	checksum.bytes(payload, static_cast<size_t>(payload_size));
+	if (checksum.h != payload_checksum) {
+		UtilityFunctions::push_warning("[NavigationCache] ", path, ": checksum mismatch, ignoring");
+		return Dictionary();
+	}
+
+	NavCacheReader reader(payload, static_cast<size_t>(payload_size));
+	Ref<NavigationMap> map;
+	map.instantiate();
+	if (!map->read_cache(reader)) {
+		UtilityFunctions::push_warning("[NavigationCache] ", path, ": malformed navigation map data, ignoring");
+		return Dictionary();
+	}
+	Ref<HpaGraph> hpa;
+	hpa.instantiate();
+	if (!hpa->read_cache(reader, map) || reader.pos != reader.size) {
+		UtilityFunctions::push_warning("[NavigationCache] ", path, ": malformed HPA graph data, ignoring");
+		return Dictionary();
+	}
+
+	Dictionary result;
+	result["map"] = map;
+	result["hpa"] = hpa;
+	return result;
+}
@@ -0,0 +1,65 @@
+#ifndef NAVIGATION_CACHE_H
+#define NAVIGATION_CACHE_H
+
+#include <godot_cpp/classes/node3d.hpp>
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/rect2.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include <godot_cpp/variant/typed_array.hpp>
+
+#include <cstdint>
+
+#include "hpa_graph.h"
+#include "navigation_map.h"
+
+namespace godot {
+
+/// On-disk cache of a built NavigationMap (SDF, shoreline tiles, heights,
+/// regions, islands) and its HpaGraph clusters, so a map load skips the
+/// rasterize/SDF/HPA build.
+///
+/// A cache file is only used when its key matches compute_key() for the
+/// current island geometry and build settings; anything else (stale key,
+/// bad checksum, truncated file, older FORMAT_VERSION) is treated as a miss
+/// and the caller rebuilds.
+///
+/// File layout: [magic u32][version u32][key u64][payload size u64]
+/// [payload checksum u64][payload], payload written by
+/// NavigationMap::write_cache followed by HpaGraph::write_cache.
+class NavigationCache : public RefCounted {
+	GDCLASS(NavigationCache, RefCounted)
+
+public:
+	static constexpr uint32_t MAGIC = 0x4E415643; // "NAVC"
+	// Bump whenever the payload layout or any build step that feeds it
+	// (rasterization, SDF, regions, islands, HPA clustering) changes.
+	static constexpr uint32_t FORMAT_VERSION = 8;  // 2: exact (FH) EDT, 3: shoreline tiles, 4: tiled grids, 5: land mask, 6: clearance tree, 7: HPA portals, 8: SoA cluster SDF ranges
+
+protected:
+	static void _bind_methods();
+
+public:
+	NavigationCache();
+	~NavigationCache();
+
+	/// Hash of everything the build depends on: island transforms and
+	/// collision shape data, bounds, cell size, HPA clearance and the format
+	/// version.  Bodies must already be in the tree (global transforms).
+	static int64_t compute_key(TypedArray<Node3D> island_bodies, Rect2 bounds,
+			float cell_size, float hpa_clearance);
+
+	/// Write map + hpa to path (parent directories are created).
+	/// Returns false if either is not built or the file cannot be written.
+	static bool save_cache(const String &path, int64_t key,
+			Ref<NavigationMap> map, Ref<HpaGraph> hpa);
+
+	/// Load a cache written by save_cache().  Returns { map, hpa } on a hit,
+	/// or an empty Dictionary if the file is missing, stale or corrupt.
+	static Dictionary load_cache(const String &path, int64_t key);
+};
+
+} // namespace godot
+
+#endif // NAVIGATION_CACHE_H
@@ -20,11 +20,18 @@
 #include <cstring>
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <unordered_set>
 #include <queue>
 #include <vector>
 #include <stack>
 #include <limits>
 #include <functional>
+#include <type_traits>
+#include <chrono>
+#include <random>
+
+#include "nav_parallel.h"
 
 using namespace godot;
 
@@ -36,19 +43,35 @@ void NavigationMap::_bind_methods() {
 	// Construction
 	ClassDB::bind_method(D_METHOD("set_bounds", "min_x", "min_z", "max_x", "max_z"), &NavigationMap::set_bounds);
 	ClassDB::bind_method(D_METHOD("set_cell_size", "size"), &NavigationMap::set_cell_size);
+	ClassDB::bind_method(D_METHOD("set_shore_refinement", "factor", "band_m"), &NavigationMap::set_shore_refinement);
+	ClassDB::bind_method(D_METHOD("get_shore_refinement"), &NavigationMap::get_shore_refinement);
+	ClassDB::bind_method(D_METHOD("get_shore_tile_count"), &NavigationMap::get_shore_tile_count);
 	ClassDB::bind_method(D_METHOD("build_from_collision_shapes", "island_bodies"), &NavigationMap::build_from_collision_shapes);
+	ClassDB::bind_method(D_METHOD("set_scan_thread_count", "count"), &NavigationMap::set_scan_thread_count);
 	ClassDB::bind_method(D_METHOD("build_from_raycast_scan", "space_state", "island_bodies", "collision_mask"), &NavigationMap::build_from_raycast_scan, DEFVAL(1));
 
+	// Runtime land changes
+	ClassDB::bind_method(D_METHOD("apply_land_patch", "rect", "mask", "mask_width"), &NavigationMap::apply_land_patch, DEFVAL(PackedByteArray()), DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("remove_land_patch", "patch_id"), &NavigationMap::remove_land_patch);
+	ClassDB::bind_method(D_METHOD("clear_land_patches"), &NavigationMap::clear_land_patches);
+	ClassDB::bind_method(D_METHOD("get_land_patch_count"), &NavigationMap::get_land_patch_count);
+	ClassDB::bind_method(D_METHOD("get_version"), &NavigationMap::get_version);
+
 	// Core SDF queries
 	ClassDB::bind_method(D_METHOD("get_distance", "x", "z"), &NavigationMap::get_distance);
 	ClassDB::bind_method(D_METHOD("get_gradient", "x", "z"), &NavigationMap::get_gradient);
+	ClassDB::bind_method(D_METHOD("get_distances", "points"), &NavigationMap::get_distances);
+	ClassDB::bind_method(D_METHOD("get_gradients", "points"), &NavigationMap::get_gradients);
 	ClassDB::bind_method(D_METHOD("is_navigable", "x", "z", "clearance"), &NavigationMap::is_navigable);
+	ClassDB::bind_method(D_METHOD("is_reachable", "from", "to", "clearance"), &NavigationMap::is_reachable);
 
 	// Raycasting
 	ClassDB::bind_method(D_METHOD("raycast", "from", "to", "clearance"), &NavigationMap::raycast);
 
 	// Pathfinding
-	ClassDB::bind_method(D_METHOD("find_path", "from", "to", "clearance", "turning_radius"), &NavigationMap::find_path, DEFVAL(0.0f));
+	ClassDB::bind_method(D_METHOD("find_path", "from", "to", "clearance", "turning_radius", "planner"), &NavigationMap::find_path, DEFVAL(0.0f), DEFVAL(PLANNER_SDF_JUMP));
+	BIND_CONSTANT(PLANNER_SDF_JUMP);
+	BIND_CONSTANT(PLANNER_JPS_PLUS);
 
 	// Island data
 	ClassDB::bind_method(D_METHOD("get_islands"), &NavigationMap::get_islands);
@@ -69,6 +92,9 @@ void NavigationMap::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_cell_size_value"), &NavigationMap::get_cell_size_value);
 	ClassDB::bind_method(D_METHOD("is_built"), &NavigationMap::is_built);
 	ClassDB::bind_method(D_METHOD("get_island_count"), &NavigationMap::get_island_count);
+	ClassDB::bind_method(D_METHOD("benchmark_grid_layouts", "samples"), &NavigationMap::benchmark_grid_layouts, DEFVAL(100000));
+	ClassDB::bind_method(D_METHOD("benchmark_cell_planners", "queries", "clearance"), &NavigationMap::benchmark_cell_planners, DEFVAL(200), DEFVAL(150.0f));
+	ClassDB::bind_method(D_METHOD("benchmark_open_lists", "queries", "clearance"), &NavigationMap::benchmark_open_lists, DEFVAL(200), DEFVAL(150.0f));
 	// Height grid queries
 	ClassDB::bind_method(D_METHOD("get_terrain_height", "x", "z"), &NavigationMap::get_terrain_height);
 	ClassDB::bind_method(D_METHOD("get_height_data"), &NavigationMap::get_height_data);
@@ -88,6 +114,16 @@ NavigationMap::NavigationMap() {
 	max_z = 17500.0f;
 	built = false;
 	region_count = 0;
+	shore_refinement = DEFAULT_SHORE_REFINEMENT;
+	shore_band = DEFAULT_SHORE_BAND;
+	shore_tiles_x = 0;
+	shore_tiles_z = 0;
+	grid_tile_shift = 0;
+	grid_tiles_x = 0;
+	scan_thread_count = 0;
+	next_patch_id = 1;
+	nav_version = 0;
+	nav_changes_floor = 0;
 
 	// Precompute turn angle lookup table for all 8-direction pairs
 	const int dx8[] = {-1, 0, 1, -1, 1, -1, 0, 1};
@@ -142,7 +178,18 @@ void NavigationMap::set_cell_size(float p_cell_size) {
 	}
 }
 
+void NavigationMap::set_shore_refinement(int factor, float band_m) {
+	shore_refinement = std::max(1, factor);
+	shore_band = std::max(0.0f, band_m);
+}
+
+void NavigationMap::set_scan_thread_count(int count) {
+	scan_thread_count = std::max(0, count);
+}
+
 void NavigationMap::build_from_collision_shapes(TypedArray<Node3D> island_bodies) {
+	std::unique_lock<std::shared_mutex> query_lock(query_mutex_);
+
 	// Calculate grid dimensions
 	grid_width = static_cast<int>(std::ceil((max_x - min_x) / cell_size)) + 1;
 	grid_height = static_cast<int>(std::ceil((max_z - min_z) / cell_size)) + 1;
@@ -151,13 +198,42 @@ void NavigationMap::build_from_collision_shapes(TypedArray<Node3D> island_bodies
 	UtilityFunctions::print("[NavigationMap] Building SDF: ", grid_width, "x", grid_height,
 							" (", total_cells, " cells, cell_size=", cell_size, "m)");
 
+	// Shoreline tiles need the land mask at the fine resolution, so rasterize
+	// once at cell_size / refinement on a grid whose every refinement-th
+	// sample coincides with a coarse cell, and derive the coarse mask from it.
+	const int coarse_w = grid_width;
+	const int coarse_h = grid_height;
+	const float coarse_cell = cell_size;
+	int refinement = std::max(1, shore_refinement);
+	while (refinement > 1 &&
+		   static_cast<int64_t>((coarse_w - 1) * refinement + 1) * ((coarse_h - 1) * refinement + 1) > MAX_SHORE_RASTER_CELLS) {
+		refinement--;
+	}
+	shore_refinement = refinement;
+	shore_tile_index.clear();
+	shore_tile_data.clear();
+	shore_tiles_x = 0;
+	shore_tiles_z = 0;
+
+	grid_width = (coarse_w - 1) * refinement + 1;
+	grid_height = (coarse_h - 1) * refinement + 1;
+	cell_size = coarse_cell / static_cast<float>(refinement);
+	// Build passes work row-major; the tiled layout is applied at the end
+	grid_tile_shift = 0;
+	grid_tiles_x = grid_width;
+	int raster_cells = grid_width * grid_height;
+	if (refinement > 1) {
+		UtilityFunctions::print("[NavigationMap] Rasterizing at ", cell_size, "m (", grid_width, "x", grid_height,
+								") for shoreline tiles");
+	}
+
 	// Step 1: Create binary land mask
 	// NOTE: All rasterization methods now filter by waterline Y > 0.
 	// Geometry at or below the waterline (base planes, underwater collision)
 	// is NOT marked as land. This prevents rectangular base meshes from
 	// inflating island footprints in the SDF.
-	std::vector<bool> land_mask(total_cells, false);
-	std::vector<float> height_grid(total_cells, 0.0f);
+	std::vector<uint8_t> land_mask(raster_cells, 0);
+	std::vector<float> height_grid(raster_cells, 0.0f);
 
 	int island_count = island_bodies.size();
 	UtilityFunctions::print("[NavigationMap] Processing ", island_count, " island bodies...");
@@ -257,6 +333,22 @@ void NavigationMap::build_from_collision_shapes(TypedArray<Node3D> island_bodies
 		}
 	}
 
+	// Fine SDF for the shoreline tiles, then back to the coarse grid
+	if (refinement > 1) {
+		int fine_w = grid_width;
+		int fine_h = grid_height;
+		compute_sdf_from_mask(land_mask);
+		std::vector<float> fine_sdf = std::move(sdf_grid);
+		sdf_grid.clear();
+
+		grid_width = coarse_w;
+		grid_height = coarse_h;
+		grid_tiles_x = coarse_w;
+		cell_size = coarse_cell;
+		downsample_land_mask(refinement, fine_w, fine_h, land_mask, height_grid);
+		build_shore_tiles(fine_sdf, fine_w, fine_h);
+	}
+
 	// Count land cells
 	int land_cells = 0;
 	for (int i = 0; i < total_cells; i++) {
@@ -273,11 +365,16 @@ void NavigationMap::build_from_collision_shapes(TypedArray<Node3D> island_bodies
 
 	// Step 4: Compute connected water regions for O(1) reachability checks
 	compute_regions();
+	int tree_cells = compute_clearance_tree();
+	UtilityFunctions::print("[NavigationMap] Clearance tree: ", static_cast<int64_t>(ctree_value.size()),
+							" nodes over ", tree_cells, " water cells.");
 
 	// Step 5: Allocate reusable A* buffers
 	allocate_astar_buffers();
 
+	finish_land_build(std::move(land_mask));
 	this->height_grid = std::move(height_grid);
+	set_grid_layout(DEFAULT_GRID_TILE_SHIFT);
 	built = true;
 	UtilityFunctions::print("[NavigationMap] Build complete. ", islands.size(), " islands detected, ",
 							region_count, " navigable regions.");
@@ -290,6 +387,7 @@ void NavigationMap::build_from_collision_shapes(TypedArray<Node3D> island_bodies
 void NavigationMap::build_from_raycast_scan(PhysicsDirectSpaceState3D *space_state,
 											TypedArray<Node3D> island_bodies,
 											int collision_mask) {
+	std::unique_lock<std::shared_mutex> query_lock(query_mutex_);
 	if (space_state == nullptr) {
 		UtilityFunctions::push_error("[NavigationMap] build_from_raycast_scan: space_state is null");
 		return;
@@ -309,6 +407,11 @@ void NavigationMap::build_from_raycast_scan(PhysicsDirectSpaceState3D *space_sta
 	// just above this so we never start inside geometry.
 	float max_y = 100.0f; // sensible default if no AABBs found
 
+	// The XZ footprint of every shape is kept too: lattice blocks that see
+	// only water but overlap a footprint are refined, so islets smaller than
+	// the coarse lattice spacing are not missed.
+	std::vector<Rect2> shape_footprints;
+
 	int island_count = island_bodies.size();
 	for (int i = 0; i < island_count; i++) {
 		Node3D *body = Object::cast_to<Node3D>(island_bodies[i]);
@@ -326,55 +429,54 @@ void NavigationMap::build_from_raycast_scan(PhysicsDirectSpaceState3D *space_sta
 
 			Transform3D shape_transform = body_transform * col_shape->get_transform();
 
+			bool has_footprint = false;
+			Rect2 footprint;
+			auto grow = [&](const Vector3 &world_v) {
+				if (world_v.y > max_y) max_y = world_v.y;
+				if (!has_footprint) {
+					footprint = Rect2(world_v.x, world_v.z, 0.0f, 0.0f);
+					has_footprint = true;
+				} else {
+					footprint.expand_to(Vector2(world_v.x, world_v.z));
+				}
+			};
+
 			// Try each supported shape type for its AABB height
 			Ref<ConcavePolygonShape3D> concave = shape;
+			Ref<ConvexPolygonShape3D> convex = shape;
+			Ref<BoxShape3D> box = shape;
+			Ref<SphereShape3D> sphere = shape;
+			Ref<CylinderShape3D> cylinder = shape;
 			if (concave.is_valid()) {
 				PackedVector3Array faces = concave->get_faces();
 				for (int f = 0; f < faces.size(); f++) {
-					Vector3 world_v = shape_transform.xform(faces[f]);
-					if (world_v.y > max_y) max_y = world_v.y;
+					grow(shape_transform.xform(faces[f]));
 				}
-				continue;
-			}
-
-			Ref<ConvexPolygonShape3D> convex = shape;
-			if (convex.is_valid()) {
+			} else if (convex.is_valid()) {
 				PackedVector3Array points = convex->get_points();
 				for (int p = 0; p < points.size(); p++) {
-					Vector3 world_v = shape_transform.xform(points[p]);
-					if (world_v.y > max_y) max_y = world_v.y;
+					grow(shape_transform.xform(points[p]));
 				}
-				continue;
-			}
-
-			Ref<BoxShape3D> box = shape;
-			if (box.is_valid()) {
+			} else if (box.is_valid()) {
 				Vector3 half = box->get_size() * 0.5f;
 				for (int corner = 0; corner < 8; corner++) {
 					Vector3 local(
 						(corner & 1) ? half.x : -half.x,
 						(corner & 2) ? half.y : -half.y,
 						(corner & 4) ? half.z : -half.z);
-					Vector3 world_v = shape_transform.xform(local);
-					if (world_v.y > max_y) max_y = world_v.y;
+					grow(shape_transform.xform(local));
 				}
-				continue;
+			} else if (sphere.is_valid() || cylinder.is_valid()) {
+				float r = sphere.is_valid() ? sphere->get_radius() : cylinder->get_radius();
+				float h = sphere.is_valid() ? r : cylinder->get_height() * 0.5f;
+				grow(shape_transform.xform(Vector3(0, h, 0)));
+				Vector3 center = shape_transform.origin;
+				grow(Vector3(center.x - r, center.y, center.z - r));
+				grow(Vector3(center.x + r, center.y, center.z + r));
 			}
 
-			Ref<SphereShape3D> sphere = shape;
-			if (sphere.is_valid()) {
-				float r = sphere->get_radius();
-				Vector3 top = shape_transform.xform(Vector3(0, r, 0));
-				if (top.y > max_y) max_y = top.y;
-				continue;
-			}
-
-			Ref<CylinderShape3D> cylinder = shape;
-			if (cylinder.is_valid()) {
-				float h = cylinder->get_height() * 0.5f;
-				Vector3 top = shape_transform.xform(Vector3(0, h, 0));
-				if (top.y > max_y) max_y = top.y;
-				continue;
+			if (has_footprint) {
+				shape_footprints.push_back(footprint);
 			}
 		}
 	}
@@ -385,23 +487,40 @@ void NavigationMap::build_from_raycast_scan(PhysicsDirectSpaceState3D *space_sta
 	UtilityFunctions::print("[NavigationMap] Tallest island geometry Y=", max_y,
 							", ray origin Y=", ray_origin_y);
 
-	// --- Set up the reusable ray query ---
-	Ref<PhysicsRayQueryParameters3D> ray_query;
-	ray_query.instantiate();
-	ray_query->set_collision_mask(static_cast<uint32_t>(collision_mask));
-	ray_query->set_collide_with_bodies(true);
-	ray_query->set_collide_with_areas(false);
-	ray_query->set_hit_back_faces(false);
+	// Build passes work row-major; the tiled layout is applied at the end
+	grid_tile_shift = 0;
+	grid_tiles_x = grid_width;
 
-	// --- Cast one ray per grid cell ---
-	std::vector<bool> land_mask(total_cells, false);
-	std::vector<float> height_grid(total_cells, 0.0f);
-	int land_cells = 0;
+	// Shoreline tiles would need one ray per fine cell; the scan stays uniform
+	shore_tile_index.clear();
+	shore_tile_data.clear();
+	shore_tiles_x = 0;
+	shore_tiles_z = 0;
 
-	for (int iz = 0; iz < grid_height; iz++) {
-		for (int ix = 0; ix < grid_width; ix++) {
+	// GodotPhysics writes every ray query into buffers shared by the whole
+	// space, so concurrent intersect_ray calls race even with
+	// physics/3d/run_on_separate_thread.  The scan stays on the calling thread
+	// unless set_scan_thread_count opts in for a backend whose direct space
+	// state is thread-safe.
+	int threads = (scan_thread_count > 0) ? scan_thread_count : 1;
+
+	std::vector<uint8_t> land_mask(total_cells, 0);
+	std::vector<float> height_grid(total_cells, 0.0f);
+	std::atomic<int> rays_cast(0);
+
+	// Cast one downward ray per cell in [cells), each worker with its own query
+	auto scan_cells = [&](const std::vector<int> &cells, int begin, int end) {
+		Ref<PhysicsRayQueryParameters3D> ray_query;
+		ray_query.instantiate();
+		ray_query->set_collision_mask(static_cast<uint32_t>(collision_mask));
+		ray_query->set_collide_with_bodies(true);
+		ray_query->set_collide_with_areas(false);
+		ray_query->set_hit_back_faces(false);
+
+		for (int i = begin; i < end; i++) {
+			int idx = cells[i];
 			float wx, wz;
-			grid_to_world(ix, iz, wx, wz);
+			grid_to_world(idx % grid_width, idx / grid_width, wx, wz);
 
 			ray_query->set_from(Vector3(wx, ray_origin_y, wz));
 			ray_query->set_to(Vector3(wx, ray_end_y, wz));
@@ -412,14 +531,115 @@ void NavigationMap::build_from_raycast_scan(PhysicsDirectSpaceState3D *space_sta
 				Vector3 hit_pos = result["position"];
 				// Hit point above the waterline (Y > 0) means land
 				if (hit_pos.y > 0.0f) {
-					int idx = iz * grid_width + ix;
-					land_mask[idx] = true;
+					land_mask[idx] = 1;
 					height_grid[idx] = std::max(height_grid[idx], hit_pos.y);
-					land_cells++;
 				}
 			}
 		}
+		rays_cast += end - begin;
+	};
+
+	// --- Pass 1: coarse lattice, every RAYCAST_COARSE_STRIDE cells ---
+	const int K = RAYCAST_COARSE_STRIDE;
+	const int blocks_x = (grid_width + K - 1) / K;
+	const int blocks_z = (grid_height + K - 1) / K;
+	auto lattice_x = [&](int bx) { return std::min(bx * K, grid_width - 1); };
+	auto lattice_z = [&](int bz) { return std::min(bz * K, grid_height - 1); };
+
+	std::vector<int> lattice_cells;
+	lattice_cells.reserve(static_cast<size_t>(blocks_x + 1) * (blocks_z + 1));
+	for (int bz = 0; bz <= blocks_z; bz++) {
+		for (int bx = 0; bx <= blocks_x; bx++) {
+			lattice_cells.push_back(lattice_z(bz) * grid_width + lattice_x(bx));
+		}
+	}
+	std::sort(lattice_cells.begin(), lattice_cells.end());  // clamped edge points repeat
+	lattice_cells.erase(std::unique(lattice_cells.begin(), lattice_cells.end()), lattice_cells.end());
+	nav_parallel_for(static_cast<int>(lattice_cells.size()), 256,
+			[&](int begin, int end) { scan_cells(lattice_cells, begin, end); }, threads);
+
+	auto lattice_land = [&](int bx, int bz) -> uint8_t {
+		bx = std::max(0, std::min(bx, blocks_x));
+		bz = std::max(0, std::min(bz, blocks_z));
+		return land_mask[lattice_z(bz) * grid_width + lattice_x(bx)];
+	};
+
+	// --- Pass 2: refine blocks near a coastline, fill the rest ---
+	// A block is the K x K cells between lattice points (bx, bz) and
+	// (bx + 1, bz + 1).  It is refined when the surrounding 4x4 lattice
+	// window mixes land and water, or when it sees only water but overlaps a
+	// shape footprint.  Uniform blocks copy the lattice state, with land
+	// heights interpolated from the corner hits.
+	std::vector<int> refine_cells;
+	int refined_blocks = 0;
+	for (int bz = 0; bz < blocks_z; bz++) {
+		for (int bx = 0; bx < blocks_x; bx++) {
+			uint8_t corner = lattice_land(bx, bz);
+			bool mixed = false;
+			for (int wz = bz - 1; wz <= bz + 2 && !mixed; wz++) {
+				for (int wx = bx - 1; wx <= bx + 2; wx++) {
+					if (lattice_land(wx, wz) != corner) {
+						mixed = true;
+						break;
+					}
+				}
+			}
+
+			int x0 = bx * K, x1 = std::min((bx + 1) * K, grid_width);
+			int z0 = bz * K, z1 = std::min((bz + 1) * K, grid_height);
+			if (!mixed && !corner) {
+				float wx0, wz0, wx1, wz1;
+				grid_to_world(x0, z0, wx0, wz0);
+				grid_to_world(x1, z1, wx1, wz1);
+				Rect2 block(wx0, wz0, wx1 - wx0, wz1 - wz0);
+				for (const Rect2 &footprint : shape_footprints) {
+					if (footprint.intersects(block, true)) {
+						mixed = true;
+						break;
+					}
+				}
+			}
+
+			if (mixed) {
+				refined_blocks++;
+				for (int iz = z0; iz < z1; iz++) {
+					for (int ix = x0; ix < x1; ix++) {
+						if (ix % K == 0 && iz % K == 0) continue;  // already on the lattice
+						refine_cells.push_back(iz * grid_width + ix);
+					}
+				}
+				continue;
+			}
+			if (!corner) continue;  // open water: mask and height already 0
+
+			// Interior land: bilinear height between the four lattice hits
+			int lx0 = lattice_x(bx), lx1 = lattice_x(bx + 1);
+			int lz0 = lattice_z(bz), lz1 = lattice_z(bz + 1);
+			float h00 = height_grid[lz0 * grid_width + lx0];
+			float h10 = height_grid[lz0 * grid_width + lx1];
+			float h01 = height_grid[lz1 * grid_width + lx0];
+			float h11 = height_grid[lz1 * grid_width + lx1];
+			for (int iz = z0; iz < z1; iz++) {
+				float fz = lz1 > lz0 ? static_cast<float>(iz - lz0) / (lz1 - lz0) : 0.0f;
+				for (int ix = x0; ix < x1; ix++) {
+					float fx = lx1 > lx0 ? static_cast<float>(ix - lx0) / (lx1 - lx0) : 0.0f;
+					int idx = iz * grid_width + ix;
+					land_mask[idx] = 1;
+					height_grid[idx] = (h00 * (1.0f - fx) + h10 * fx) * (1.0f - fz) +
+									   (h01 * (1.0f - fx) + h11 * fx) * fz;
+				}
+			}
+		}
+	}
+	nav_parallel_for(static_cast<int>(refine_cells.size()), 256,
+			[&](int begin, int end) { scan_cells(refine_cells, begin, end); }, threads);
+
+	int land_cells = 0;
+	for (int i = 0; i < total_cells; i++) {
+		if (land_mask[i]) land_cells++;
 	}
+	UtilityFunctions::print("[NavigationMap] Raycast scan: ", rays_cast.load(), " rays (",
+							refined_blocks, " / ", blocks_x * blocks_z, " blocks refined)");
 
 	UtilityFunctions::print("[NavigationMap] Raycast scan complete. Land cells: ", land_cells,
 							" / ", total_cells, " (", (land_cells * 100.0f / total_cells), "%)");
@@ -428,11 +648,16 @@ void NavigationMap::build_from_raycast_scan(PhysicsDirectSpaceState3D *space_sta
 	compute_sdf_from_mask(land_mask);
 	extract_islands(land_mask);
 	compute_regions();
+	int tree_cells = compute_clearance_tree();
+	UtilityFunctions::print("[NavigationMap] Clearance tree: ", static_cast<int64_t>(ctree_value.size()),
+							" nodes over ", tree_cells, " water cells.");
 
 	// Allocate reusable A* buffers
 	allocate_astar_buffers();
 
+	finish_land_build(std::move(land_mask));
 	this->height_grid = std::move(height_grid);
+	set_grid_layout(DEFAULT_GRID_TILE_SHIFT);
 	built = true;
 	UtilityFunctions::print("[NavigationMap] Raycast build complete. ", islands.size(), " islands detected, ",
 							region_count, " navigable regions.");
@@ -443,7 +668,7 @@ void NavigationMap::build_from_raycast_scan(PhysicsDirectSpaceState3D *space_sta
 // ============================================================================
 
 void NavigationMap::rasterize_triangle(const Vector3 &v0, const Vector3 &v1, const Vector3 &v2,
-									   std::vector<bool> &land_mask, std::vector<float> &height_grid) {
+									   std::vector<uint8_t> &land_mask, std::vector<float> &height_grid) {
 	// Project triangle to XZ plane and rasterize onto the grid.
 	// AGGRESSIVE rasterization: mark ANY cell that the triangle touches, even partially.
 	// This ensures no land above water is ever treated as empty/navigable.
@@ -584,7 +809,7 @@ void NavigationMap::rasterize_triangle(const Vector3 &v0, const Vector3 &v1, con
 			if (overlaps) {
 				if (all_above) {
 					int idx = iz * grid_width + ix;
-					land_mask[idx] = true;
+					land_mask[idx] = 1;
 					height_grid[idx] = std::max(height_grid[idx], max_y);
 				} else {
 					// Mixed triangle: interpolate Y at cell center using barycentric coords.
@@ -612,7 +837,7 @@ void NavigationMap::rasterize_triangle(const Vector3 &v0, const Vector3 &v1, con
 						float y_at_cell = w0 * v0.y + w1 * v1.y + w2 * v2.y;
 						if (y_at_cell > 0.0f) {
 							int idx = iz * grid_width + ix;
-							land_mask[idx] = true;
+							land_mask[idx] = 1;
 							height_grid[idx] = std::max(height_grid[idx], y_at_cell);
 						}
 					} else {
@@ -640,7 +865,7 @@ void NavigationMap::rasterize_triangle(const Vector3 &v0, const Vector3 &v1, con
 						float y_at_nearest = w0 * v0.y + w1 * v1.y + w2 * v2.y;
 						if (y_at_nearest > 0.0f) {
 							int idx = iz * grid_width + ix;
-							land_mask[idx] = true;
+							land_mask[idx] = 1;
 							height_grid[idx] = std::max(height_grid[idx], y_at_nearest);
 						}
 					}
@@ -651,7 +876,7 @@ void NavigationMap::rasterize_triangle(const Vector3 &v0, const Vector3 &v1, con
 }
 
 void NavigationMap::rasterize_box(const Vector3 &center, const Vector3 &half_extents,
-								  const Transform3D &transform, std::vector<bool> &land_mask, std::vector<float> &height_grid) {
+								  const Transform3D &transform, std::vector<uint8_t> &land_mask, std::vector<float> &height_grid) {
 	// Generate 8 corners of the box, transform to world, project to XZ.
 	// Only mark cells as land if the box extends above the waterline (Y > 0).
 	Vector3 corners[8];
@@ -711,7 +936,7 @@ void NavigationMap::rasterize_box(const Vector3 &center, const Vector3 &half_ext
 				Vector3 world_top = transform.xform(local_top);
 				if (world_top.y > 0.0f) {
 					int idx = iz * grid_width + ix;
-					land_mask[idx] = true;
+					land_mask[idx] = 1;
 					height_grid[idx] = std::max(height_grid[idx], world_top.y);
 				}
 			}
@@ -720,7 +945,7 @@ void NavigationMap::rasterize_box(const Vector3 &center, const Vector3 &half_ext
 }
 
 void NavigationMap::rasterize_sphere(const Vector3 &center, float radius,
-									 const Transform3D &transform, std::vector<bool> &land_mask, std::vector<float> &height_grid) {
+									 const Transform3D &transform, std::vector<uint8_t> &land_mask, std::vector<float> &height_grid) {
 	Vector3 world_center = transform.xform(center);
 
 	// Skip if the entire sphere is below the waterline
@@ -762,7 +987,7 @@ void NavigationMap::rasterize_sphere(const Vector3 &center, float radius,
 				float dist_sq = cell_dx * cell_dx + cell_dz * cell_dz;
 				float top_y = world_center.y + std::sqrt(std::max(0.0f, radius * radius - dist_sq));
 				int idx = iz * grid_width + ix;
-				land_mask[idx] = true;
+				land_mask[idx] = 1;
 				height_grid[idx] = std::max(height_grid[idx], top_y);
 			}
 		}
@@ -770,7 +995,7 @@ void NavigationMap::rasterize_sphere(const Vector3 &center, float radius,
 }
 
 void NavigationMap::rasterize_cylinder(const Vector3 &center, float radius, float height,
-									   const Transform3D &transform, std::vector<bool> &land_mask, std::vector<float> &height_grid) {
+									   const Transform3D &transform, std::vector<uint8_t> &land_mask, std::vector<float> &height_grid) {
 	// Check if the top of the cylinder is above the waterline
 	Vector3 world_top = transform.xform(center + Vector3(0, height * 0.5f, 0));
 	if (world_top.y <= 0.0f) return; // Entire cylinder is below water
@@ -795,7 +1020,7 @@ void NavigationMap::rasterize_cylinder(const Vector3 &center, float radius, floa
 			float dz = static_cast<float>(iz) - gz_center;
 			if (dx * dx + dz * dz <= grid_radius * grid_radius) {
 				int idx = iz * grid_width + ix;
-				land_mask[idx] = true;
+				land_mask[idx] = 1;
 				height_grid[idx] = std::max(height_grid[idx], world_top.y);
 			}
 		}
@@ -806,146 +1031,266 @@ void NavigationMap::rasterize_cylinder(const Vector3 &center, float radius, floa
 // SDF computation (from binary land mask)
 // ============================================================================
 
-void NavigationMap::compute_sdf_from_mask(const std::vector<bool> &land_mask) {
-	int total_cells = grid_width * grid_height;
-	sdf_grid.resize(total_cells);
+namespace {
+
+// Squared-distance sentinel for cells with no seed along a 1D line.  Finite so
+// the final sqrt stays finite; larger than any real squared grid distance.
+constexpr float EDT_INF = 1.0e20f;
+
+// Felzenszwalb–Huttenlocher 1D squared distance transform of f (stride 1,
+// length n) into d: d[q] = min_p (q - p)^2 + f[p].  v and z are scratch of
+// size n and n + 1.  Sites with f >= EDT_INF never join the lower envelope.
+void edt_1d(const float *f, float *d, int n, int *v, double *z) {
+	int k = -1;
+	for (int q = 0; q < n; q++) {
+		if (f[q] >= EDT_INF) continue;
+		double fq = static_cast<double>(f[q]) + static_cast<double>(q) * q;
+		double s = -std::numeric_limits<double>::infinity();
+		while (k >= 0) {
+			int p = v[k];
+			double fp = static_cast<double>(f[p]) + static_cast<double>(p) * p;
+			s = (fq - fp) / (2.0 * (q - p));
+			if (s > z[k]) break;
+			k--;
+		}
+		if (k < 0) s = -std::numeric_limits<double>::infinity();
+		k++;
+		v[k] = q;
+		z[k] = s;
+		z[k + 1] = std::numeric_limits<double>::infinity();
+	}
 
-	// We'll use a two-pass distance transform (8SSEDT approximation)
-	// For each cell, we store the squared distance to the nearest boundary cell.
-	// Then we take the square root and apply the sign.
+	if (k < 0) {
+		std::fill(d, d + n, EDT_INF);
+		return;
+	}
 
-	const float INF_DIST = static_cast<float>(grid_width + grid_height);
+	int j = 0;
+	for (int q = 0; q < n; q++) {
+		while (z[j + 1] < q) j++;
+		float dq = static_cast<float>(q - v[j]);
+		d[q] = dq * dq + f[v[j]];
+	}
+}
 
-	// Store nearest boundary coordinates for each cell
-	std::vector<int> nearest_x(total_cells, -1);
-	std::vector<int> nearest_z(total_cells, -1);
+// A boundary cell is one whose land status differs from at least one
+// 4-neighbour; the map edge counts as water, so land on it is a boundary.
+inline bool mask_boundary(const uint8_t *mask, int w, int h, int ix, int iz) {
+	const uint8_t *row = mask + static_cast<size_t>(iz) * w;
+	uint8_t is_land = row[ix];
+	if (ix == 0 || ix == w - 1 || iz == 0 || iz == h - 1) {
+		return is_land != 0 ||
+				(ix > 0 && row[ix - 1] != is_land) ||
+				(ix < w - 1 && row[ix + 1] != is_land) ||
+				(iz > 0 && row[ix - w] != is_land) ||
+				(iz < h - 1 && row[ix + w] != is_land);
+	}
+	return row[ix - 1] != is_land || row[ix + 1] != is_land ||
+			row[ix - w] != is_land || row[ix + w] != is_land;
+}
 
-	// Initialize: boundary cells get distance 0, others get INF
-	// A boundary cell is one where its land status differs from at least one 4-neighbor
-	std::vector<float> dist_sq(total_cells, INF_DIST * INF_DIST);
+// Exact squared distance (in cells) from every cell of the window
+// [x0, x1) x [z0, z1) of a w x h row-major mask to the nearest boundary cell
+// inside the window, via the separable Felzenszwalb–Huttenlocher transform:
+// a 1D pass along every row, then along every column of the result.  Rows
+// and columns are independent, so each pass runs in parallel.  out is
+// window-local row-major; cells without any seed stay at EDT_INF.
+void edt_window(const uint8_t *mask, int w, int h, int x0, int z0, int x1, int z1,
+				std::vector<float> &out) {
+	const int ww = x1 - x0;
+	const int wh = z1 - z0;
+	out.resize(static_cast<size_t>(ww) * wh);
+
+	// Seed + row pass
+	nav_parallel_for(wh, 32, [&](int z_begin, int z_end) {
+		std::vector<float> f(ww);
+		std::vector<int> v(ww);
+		std::vector<double> zb(ww + 1);
+		for (int lz = z_begin; lz < z_end; lz++) {
+			for (int lx = 0; lx < ww; lx++) {
+				f[lx] = mask_boundary(mask, w, h, x0 + lx, z0 + lz) ? 0.0f : EDT_INF;
+			}
+			edt_1d(f.data(), out.data() + static_cast<size_t>(lz) * ww, ww, v.data(), zb.data());
+		}
+	});
+
+	// Column pass (gather each column into contiguous scratch)
+	nav_parallel_for(ww, 32, [&](int x_begin, int x_end) {
+		std::vector<float> f(wh);
+		std::vector<float> d(wh);
+		std::vector<int> v(wh);
+		std::vector<double> zb(wh + 1);
+		for (int lx = x_begin; lx < x_end; lx++) {
+			for (int lz = 0; lz < wh; lz++) {
+				f[lz] = out[static_cast<size_t>(lz) * ww + lx];
+			}
+			edt_1d(f.data(), d.data(), wh, v.data(), zb.data());
+			for (int lz = 0; lz < wh; lz++) {
+				out[static_cast<size_t>(lz) * ww + lx] = d[lz];
+			}
+		}
+	});
+}
 
-	// Seed with boundary cells (land cells adjacent to water or vice versa)
-	std::queue<int> bfs_queue;
+} // namespace
 
-	for (int iz = 0; iz < grid_height; iz++) {
-		for (int ix = 0; ix < grid_width; ix++) {
-			int idx = iz * grid_width + ix;
-			bool is_land = land_mask[idx];
-
-			// Check 4-neighbors for a boundary
-			bool is_boundary = false;
-			const int dx4[] = {1, -1, 0, 0};
-			const int dz4[] = {0, 0, 1, -1};
-			for (int d = 0; d < 4; d++) {
-				int nx = ix + dx4[d];
-				int nz = iz + dz4[d];
-				if (nx >= 0 && nx < grid_width && nz >= 0 && nz < grid_height) {
-					if (land_mask[nz * grid_width + nx] != is_land) {
-						is_boundary = true;
-						break;
-					}
-				} else {
-					// Edge of map is a boundary (treated as water)
-					if (is_land) {
-						is_boundary = true;
-						break;
-					}
-				}
-			}
+void NavigationMap::compute_sdf_from_mask(const std::vector<uint8_t> &land_mask) {
+	const int w = grid_width;
+	const int h = grid_height;
+	int total_cells = w * h;
+	sdf_grid.resize(total_cells);
 
-			if (is_boundary) {
-				dist_sq[idx] = 0.0f;
-				nearest_x[idx] = ix;
-				nearest_z[idx] = iz;
-				bfs_queue.push(idx);
-			}
+	// Exact Euclidean distance (in cells) from every cell to the nearest
+	// boundary cell; the whole grid is one window.
+	std::vector<float> dist_sq;
+	edt_window(land_mask.data(), w, h, 0, 0, w, h, dist_sq);
+
+	// Convert squared grid distances to world-space signed distances.
+	// Cells with no boundary at all (a map without land) get the grid span.
+	const float max_dist_sq = static_cast<float>(w + h) * static_cast<float>(w + h);
+	nav_parallel_for(total_cells, 4096, [&](int begin, int end) {
+		for (int i = begin; i < end; i++) {
+			float dist = std::sqrt(std::min(dist_sq[i], max_dist_sq)) * cell_size;
+			// Positive = water, Negative = land
+			sdf_grid[i] = land_mask[i] ? -dist : dist;
 		}
-	}
+	});
 
-	// BFS-based distance transform using 8-connected neighbors
-	// This is a multi-source BFS that propagates from all boundary cells simultaneously.
-	// We use Chebyshev-ordered BFS with Euclidean distance update.
-	// For better accuracy, we do a sequential two-pass 8SSEDT.
+	UtilityFunctions::print("[NavigationMap] SDF computed. Distance range: ",
+							*std::min_element(sdf_grid.begin(), sdf_grid.end()), " to ",
+							*std::max_element(sdf_grid.begin(), sdf_grid.end()), " meters");
+}
 
-	// Forward pass (top-left to bottom-right)
-	for (int iz = 0; iz < grid_height; iz++) {
-		for (int ix = 0; ix < grid_width; ix++) {
-			int idx = iz * grid_width + ix;
+// ============================================================================
+// Grid memory layout
+// ============================================================================
 
-			// Check neighbors that have already been processed: (-1,-1),(-1,0),(-1,1),(0,-1)
-			const int offsets[][2] = {{-1, -1}, {0, -1}, {1, -1}, {-1, 0}};
-			for (int d = 0; d < 4; d++) {
-				int nx = ix + offsets[d][0];
-				int nz = iz + offsets[d][1];
-				if (nx >= 0 && nx < grid_width && nz >= 0 && nz < grid_height) {
-					int nidx = nz * grid_width + nx;
-					if (nearest_x[nidx] >= 0) {
-						float ddx = static_cast<float>(ix - nearest_x[nidx]);
-						float ddz = static_cast<float>(iz - nearest_z[nidx]);
-						float new_dist_sq = ddx * ddx + ddz * ddz;
-						if (new_dist_sq < dist_sq[idx]) {
-							dist_sq[idx] = new_dist_sq;
-							nearest_x[idx] = nearest_x[nidx];
-							nearest_z[idx] = nearest_z[nidx];
-						}
-					}
-				}
+size_t NavigationMap::grid_storage_size() const {
+	const int tile = 1 << grid_tile_shift;
+	size_t tiles_z = static_cast<size_t>((grid_height + tile - 1) >> grid_tile_shift);
+	return static_cast<size_t>(grid_tiles_x) * tiles_z << (2 * grid_tile_shift);
+}
+
+void NavigationMap::set_grid_layout(int tile_shift) {
+	tile_shift = std::max(0, std::min(tile_shift, 6));
+	const int old_shift = grid_tile_shift;
+	const int old_tiles_x = grid_tiles_x;
+	grid_tile_shift = tile_shift;
+	grid_tiles_x = (grid_width + (1 << tile_shift) - 1) >> tile_shift;
+	const size_t stored = grid_storage_size();
+
+	auto relayout = [&](auto &grid, auto pad) {
+		if (grid.empty()) return;
+		typename std::remove_reference<decltype(grid)>::type out(stored, pad);
+		for (int iz = 0; iz < grid_height; iz++) {
+			for (int ix = 0; ix < grid_width; ix++) {
+				out[cell_index(ix, iz)] = grid[layout_index(ix, iz, old_shift, old_tiles_x)];
 			}
 		}
-	}
+		grid = std::move(out);
+	};
+	relayout(sdf_grid, 0.0f);
+	relayout(height_grid, 0.0f);
+	relayout(region_grid, -1);
+}
 
-	// Backward pass (bottom-right to top-left)
-	for (int iz = grid_height - 1; iz >= 0; iz--) {
-		for (int ix = grid_width - 1; ix >= 0; ix--) {
-			int idx = iz * grid_width + ix;
+// ============================================================================
+// Shoreline refinement tiles
+// ============================================================================
 
-			// Check neighbors that have already been processed: (1,1),(0,1),(-1,1),(1,0)
-			const int offsets[][2] = {{1, 1}, {0, 1}, {-1, 1}, {1, 0}};
-			for (int d = 0; d < 4; d++) {
-				int nx = ix + offsets[d][0];
-				int nz = iz + offsets[d][1];
-				if (nx >= 0 && nx < grid_width && nz >= 0 && nz < grid_height) {
-					int nidx = nz * grid_width + nx;
-					if (nearest_x[nidx] >= 0) {
-						float ddx = static_cast<float>(ix - nearest_x[nidx]);
-						float ddz = static_cast<float>(iz - nearest_z[nidx]);
-						float new_dist_sq = ddx * ddx + ddz * ddz;
-						if (new_dist_sq < dist_sq[idx]) {
-							dist_sq[idx] = new_dist_sq;
-							nearest_x[idx] = nearest_x[nidx];
-							nearest_z[idx] = nearest_z[nidx];
-						}
+void NavigationMap::downsample_land_mask(int factor, int fine_w, int fine_h,
+										 std::vector<uint8_t> &land_mask, std::vector<float> &height_grid) const {
+	int total_cells = grid_width * grid_height;
+	std::vector<uint8_t> coarse_mask(total_cells, 0);
+	std::vector<float> coarse_height(total_cells, 0.0f);
+	const int half = factor / 2;
+
+	nav_parallel_for(grid_height, 16, [&](int z_begin, int z_end) {
+		for (int iz = z_begin; iz < z_end; iz++) {
+			int fz0 = std::max(0, iz * factor - half);
+			int fz1 = std::min(fine_h - 1, iz * factor + half);
+			for (int ix = 0; ix < grid_width; ix++) {
+				int fx0 = std::max(0, ix * factor - half);
+				int fx1 = std::min(fine_w - 1, ix * factor + half);
+				uint8_t land = 0;
+				float height = 0.0f;
+				for (int fz = fz0; fz <= fz1; fz++) {
+					const size_t row = static_cast<size_t>(fz) * fine_w;
+					for (int fx = fx0; fx <= fx1; fx++) {
+						land |= land_mask[row + fx];
+						height = std::max(height, height_grid[row + fx]);
 					}
 				}
+				coarse_mask[iz * grid_width + ix] = land;
+				coarse_height[iz * grid_width + ix] = height;
 			}
 		}
-	}
+	});
 
-	// Convert squared grid distances to world-space signed distances
-	for (int i = 0; i < total_cells; i++) {
-		float dist = std::sqrt(dist_sq[i]) * cell_size;
-		// Positive = water, Negative = land
-		if (land_mask[i]) {
-			sdf_grid[i] = -dist;  // Inside land: negative
-		} else {
-			sdf_grid[i] = dist;   // Open water: positive
+	land_mask = std::move(coarse_mask);
+	height_grid = std::move(coarse_height);
+}
+
+void NavigationMap::build_shore_tiles(const std::vector<float> &fine_sdf, int fine_w, int fine_h) {
+	const int T = SHORE_TILE_CELLS;
+	const int R = shore_refinement;
+	const int stride = shore_tile_stride();
+
+	shore_tiles_x = std::max(1, (grid_width - 1 + T - 1) / T);
+	shore_tiles_z = std::max(1, (grid_height - 1 + T - 1) / T);
+	shore_tile_index.assign(shore_tiles_x * shore_tiles_z, -1);
+	shore_tile_data.clear();
+
+	std::vector<float> tile(static_cast<size_t>(stride) * stride);
+	int slot = 0;
+	for (int tz = 0; tz < shore_tiles_z; tz++) {
+		for (int tx = 0; tx < shore_tiles_x; tx++) {
+			// Samples past the grid edge repeat the edge sample
+			float min_abs = std::numeric_limits<float>::max();
+			for (int j = 0; j < stride; j++) {
+				int fz = std::min(fine_h - 1, tz * T * R + j);
+				for (int i = 0; i < stride; i++) {
+					int fx = std::min(fine_w - 1, tx * T * R + i);
+					float v = fine_sdf[static_cast<size_t>(fz) * fine_w + fx];
+					tile[static_cast<size_t>(j) * stride + i] = v;
+					min_abs = std::min(min_abs, std::abs(v));
+				}
+			}
+			if (min_abs > shore_band) continue;
+
+			shore_tile_index[tz * shore_tiles_x + tx] = slot++;
+			shore_tile_data.insert(shore_tile_data.end(), tile.begin(), tile.end());
 		}
 	}
 
-	UtilityFunctions::print("[NavigationMap] SDF computed. Distance range: ",
-							*std::min_element(sdf_grid.begin(), sdf_grid.end()), " to ",
-							*std::max_element(sdf_grid.begin(), sdf_grid.end()), " meters");
+	UtilityFunctions::print("[NavigationMap] Shoreline tiles: ", slot, " / ", shore_tiles_x * shore_tiles_z,
+							" at ", cell_size / R, "m (", (shore_tile_data.size() * sizeof(float)) / 1024, " KiB)");
+}
+
+const float *NavigationMap::find_shore_tile(float gx, float gz, float &lx, float &lz) const {
+	if (shore_tile_index.empty()) return nullptr;
+
+	int tx = std::min(static_cast<int>(gx) / SHORE_TILE_CELLS, shore_tiles_x - 1);
+	int tz = std::min(static_cast<int>(gz) / SHORE_TILE_CELLS, shore_tiles_z - 1);
+	int32_t slot = shore_tile_index[tz * shore_tiles_x + tx];
+	if (slot < 0) return nullptr;
+
+	lx = (gx - static_cast<float>(tx * SHORE_TILE_CELLS)) * static_cast<float>(shore_refinement);
+	lz = (gz - static_cast<float>(tz * SHORE_TILE_CELLS)) * static_cast<float>(shore_refinement);
+	const int stride = shore_tile_stride();
+	return shore_tile_data.data() + static_cast<size_t>(slot) * stride * stride;
 }
 
 // ============================================================================
 // Island extraction
 // ============================================================================
 
-void NavigationMap::extract_islands(const std::vector<bool> &land_mask) {
+void NavigationMap::extract_islands(const std::vector<uint8_t> &land_mask) {
 	islands.clear();
 
 	int total_cells = grid_width * grid_height;
-	std::vector<int> visited(total_cells, -1);  // -1 = unvisited, >=0 = island_id
+	std::vector<uint8_t> visited(total_cells, 0);
+	std::vector<int> island_cells;
 
 	int island_id = 0;
 
@@ -953,111 +1298,117 @@ void NavigationMap::extract_islands(const std::vector<bool> &land_mask) {
 	for (int iz = 0; iz < grid_height; iz++) {
 		for (int ix = 0; ix < grid_width; ix++) {
 			int idx = iz * grid_width + ix;
-			if (!land_mask[idx] || visited[idx] >= 0) continue;
+			if (!land_mask[idx] || visited[idx]) continue;
 
 			// New island found — BFS flood fill
 			IslandData island;
-			island.id = island_id;
+			island.id = island_id++;
+			if (!collect_island(land_mask, ix, iz, visited, island_cells, island)) {
+				continue;
+			}
 
-			std::queue<std::pair<int, int>> queue;
-			queue.push({ix, iz});
-			visited[idx] = island_id;
+			UtilityFunctions::print("[NavigationMap]   Island ", island.id,
+									": center=(", island.center.x, ", ", island.center.y,
+									"), radius=", island.radius, "m, area=", island.area, "m², ",
+									island.edge_points.size(), " edge points");
 
-			double sum_x = 0, sum_z = 0;
-			int cell_count = 0;
-			std::vector<std::pair<int, int>> island_cells;
+			islands.push_back(island);
+		}
+	}
+}
 
-			while (!queue.empty()) {
-				auto [cx, cz] = queue.front();
-				queue.pop();
+bool NavigationMap::collect_island(const std::vector<uint8_t> &land_mask, int ix, int iz,
+								   std::vector<uint8_t> &visited, std::vector<int> &cells,
+								   IslandData &island) const {
+	// BFS over 8-connected land; cells doubles as the queue (row-major)
+	cells.clear();
+	cells.push_back(iz * grid_width + ix);
+	visited[iz * grid_width + ix] = 1;
 
-				float wx, wz;
-				grid_to_world(cx, cz, wx, wz);
-				sum_x += wx;
-				sum_z += wz;
-				cell_count++;
-				island_cells.push_back({cx, cz});
-
-				// Check 8-connected neighbors
-				const int dx8[] = {-1, 0, 1, -1, 1, -1, 0, 1};
-				const int dz8[] = {-1, -1, -1, 0, 0, 1, 1, 1};
-				for (int d = 0; d < 8; d++) {
-					int nx = cx + dx8[d];
-					int nz = cz + dz8[d];
-					if (nx >= 0 && nx < grid_width && nz >= 0 && nz < grid_height) {
-						int nidx = nz * grid_width + nx;
-						if (land_mask[nidx] && visited[nidx] < 0) {
-							visited[nidx] = island_id;
-							queue.push({nx, nz});
-						}
-					}
+	double sum_x = 0, sum_z = 0;
+	for (size_t head = 0; head < cells.size(); head++) {
+		int cx = cells[head] % grid_width;
+		int cz = cells[head] / grid_width;
+
+		float wx, wz;
+		grid_to_world(cx, cz, wx, wz);
+		sum_x += wx;
+		sum_z += wz;
+
+		// Check 8-connected neighbors
+		const int dx8[] = {-1, 0, 1, -1, 1, -1, 0, 1};
+		const int dz8[] = {-1, -1, -1, 0, 0, 1, 1, 1};
+		for (int d = 0; d < 8; d++) {
+			int nx = cx + dx8[d];
+			int nz = cz + dz8[d];
+			if (nx >= 0 && nx < grid_width && nz >= 0 && nz < grid_height) {
+				int nidx = nz * grid_width + nx;
+				if (land_mask[nidx] && !visited[nidx]) {
+					visited[nidx] = 1;
+					cells.push_back(nidx);
 				}
 			}
+		}
+	}
 
-			// Skip tiny islands (noise) — fewer than 4 cells at 50m = 10,000 sq meters
-			if (cell_count < 4) {
-				island_id++;
-				continue;
-			}
+	// Skip tiny islands (noise) — fewer than 4 cells at 50m = 10,000 sq meters
+	int cell_count = static_cast<int>(cells.size());
+	if (cell_count < 4) {
+		return false;
+	}
 
-			island.center = Vector2(
-				static_cast<float>(sum_x / cell_count),
-				static_cast<float>(sum_z / cell_count)
-			);
-			island.area = static_cast<float>(cell_count) * cell_size * cell_size;
+	island.center = Vector2(
+		static_cast<float>(sum_x / cell_count),
+		static_cast<float>(sum_z / cell_count)
+	);
+	island.area = static_cast<float>(cell_count) * cell_size * cell_size;
 
-			// Compute radius (max distance from center to any land cell)
-			float max_dist_sq = 0.0f;
-			for (const auto &[cx, cz] : island_cells) {
+	// Compute radius (max distance from center to any land cell)
+	float max_dist_sq = 0.0f;
+	for (int c : cells) {
+		float wx, wz;
+		grid_to_world(c % grid_width, c / grid_width, wx, wz);
+		float dx = wx - island.center.x;
+		float dz = wz - island.center.y;  // center.y is world Z
+		float d = dx * dx + dz * dz;
+		if (d > max_dist_sq) max_dist_sq = d;
+	}
+	island.radius = std::sqrt(max_dist_sq);
+
+	// Extract edge points (cells on the boundary between land and water)
+	// Sample every few cells to keep the array manageable
+	island.edge_points.clear();
+	int edge_sample_stride = std::max(1, cell_count / 64);
+	int edge_counter = 0;
+	for (int c : cells) {
+		int cx = c % grid_width;
+		int cz = c / grid_width;
+		// Check if this cell has a water neighbor (it's on the edge)
+		bool on_edge = false;
+		const int dx4[] = {1, -1, 0, 0};
+		const int dz4[] = {0, 0, 1, -1};
+		for (int d = 0; d < 4; d++) {
+			int nx = cx + dx4[d];
+			int nz = cz + dz4[d];
+			if (nx < 0 || nx >= grid_width || nz < 0 || nz >= grid_height) {
+				on_edge = true;
+				break;
+			}
+			if (!land_mask[nz * grid_width + nx]) {
+				on_edge = true;
+				break;
+			}
+		}
+		if (on_edge) {
+			edge_counter++;
+			if (edge_counter % edge_sample_stride == 0) {
 				float wx, wz;
 				grid_to_world(cx, cz, wx, wz);
-				float dx = wx - island.center.x;
-				float dz = wz - island.center.y;  // center.y is world Z
-				float d = dx * dx + dz * dz;
-				if (d > max_dist_sq) max_dist_sq = d;
-			}
-			island.radius = std::sqrt(max_dist_sq);
-
-			// Extract edge points (cells on the boundary between land and water)
-			// Sample every few cells to keep the array manageable
-			int edge_sample_stride = std::max(1, cell_count / 64);
-			int edge_counter = 0;
-			for (const auto &[cx, cz] : island_cells) {
-				// Check if this cell has a water neighbor (it's on the edge)
-				bool on_edge = false;
-				const int dx4[] = {1, -1, 0, 0};
-				const int dz4[] = {0, 0, 1, -1};
-				for (int d = 0; d < 4; d++) {
-					int nx = cx + dx4[d];
-					int nz = cz + dz4[d];
-					if (nx < 0 || nx >= grid_width || nz < 0 || nz >= grid_height) {
-						on_edge = true;
-						break;
-					}
-					if (!land_mask[nz * grid_width + nx]) {
-						on_edge = true;
-						break;
-					}
-				}
-				if (on_edge) {
-					edge_counter++;
-					if (edge_counter % edge_sample_stride == 0) {
-						float wx, wz;
-						grid_to_world(cx, cz, wx, wz);
-						island.edge_points.push_back(Vector2(wx, wz));
-					}
-				}
+				island.edge_points.push_back(Vector2(wx, wz));
 			}
-
-			UtilityFunctions::print("[NavigationMap]   Island ", island_id,
-									": center=(", island.center.x, ", ", island.center.y,
-									"), radius=", island.radius, "m, area=", island.area, "m², ",
-									island.edge_points.size(), " edge points");
-
-			islands.push_back(island);
-			island_id++;
 		}
 	}
+	return true;
 }
 
 // ============================================================================
@@ -1065,14 +1416,14 @@ void NavigationMap::extract_islands(const std::vector<bool> &land_mask) {
 // ============================================================================
 
 void NavigationMap::compute_regions() {
-	int total_cells = grid_width * grid_height;
-	region_grid.assign(total_cells, -1);
+	region_grid.assign(grid_storage_size(), -1);
 	region_count = 0;
 
-	// BFS flood-fill over all navigable (water) cells — sdf_grid > 0 means water
+	// BFS flood-fill over all navigable (water) cells — sdf_grid > 0 means water.
+	// The queue holds row-major cell numbers; grids are read via cell_index.
 	for (int iz = 0; iz < grid_height; iz++) {
 		for (int ix = 0; ix < grid_width; ix++) {
-			int idx = iz * grid_width + ix;
+			int idx = cell_index(ix, iz);
 			if (region_grid[idx] >= 0) continue;       // already assigned
 			if (sdf_grid[idx] <= 0.0f) continue;       // land cell
 
@@ -1080,7 +1431,7 @@ void NavigationMap::compute_regions() {
 			int rid = region_count++;
 			std::queue<int> q;
 			region_grid[idx] = rid;
-			q.push(idx);
+			q.push(iz * grid_width + ix);
 
 			while (!q.empty()) {
 				int ci = q.front();
@@ -1094,17 +1445,776 @@ void NavigationMap::compute_regions() {
 					int nx = cx + dx4[d];
 					int nz = cz + dz4[d];
 					if (nx < 0 || nx >= grid_width || nz < 0 || nz >= grid_height) continue;
-					int nidx = nz * grid_width + nx;
+					int nidx = cell_index(nx, nz);
 					if (region_grid[nidx] >= 0) continue;
 					if (sdf_grid[nidx] <= 0.0f) continue;
 					region_grid[nidx] = rid;
-					q.push(nidx);
+					q.push(nz * grid_width + nx);
+				}
+			}
+		}
+	}
+
+	UtilityFunctions::print("[NavigationMap] Computed ", region_count, " navigable water regions.");
+}
+
+// ============================================================================
+// Clearance bottleneck tree (reachability at any clearance)
+// ============================================================================
+
+int NavigationMap::compute_clearance_tree() {
+	const int w = grid_width;
+	const int h = grid_height;
+	const int total = w * h;
+	const float step = cell_size / static_cast<float>(CLEARANCE_TREE_STEPS);
+
+	clearance_node.assign(total, -1);
+	ctree_parent.clear();
+	ctree_value.clear();
+
+	// Bucket water cells by SDF (counting sort, highest bucket first)
+	float max_sdf = 0.0f;
+	for (int iz = 0; iz < h; iz++) {
+		for (int ix = 0; ix < w; ix++) {
+			max_sdf = std::max(max_sdf, sdf_grid[cell_index(ix, iz)]);
+		}
+	}
+	if (max_sdf <= 0.0f) {
+		link_clearance_tree();
+		return 0;
+	}
+	const int buckets = static_cast<int>(max_sdf / step) + 1;
+	auto bucket_of = [&](float d) {
+		return std::min(static_cast<int>(d / step), buckets - 1);
+	};
+	std::vector<int32_t> start(buckets + 1, 0);
+	for (int iz = 0; iz < h; iz++) {
+		for (int ix = 0; ix < w; ix++) {
+			float d = sdf_grid[cell_index(ix, iz)];
+			if (d > 0.0f) start[buckets - bucket_of(d)]++;
+		}
+	}
+	for (int b = 0; b < buckets; b++) {
+		start[b + 1] += start[b];
+	}
+	std::vector<int32_t> order(start[buckets]);
+	for (int iz = 0; iz < h; iz++) {
+		for (int ix = 0; ix < w; ix++) {
+			float d = sdf_grid[cell_index(ix, iz)];
+			if (d > 0.0f) order[start[buckets - 1 - bucket_of(d)]++] = iz * w + ix;
+		}
+	}
+
+	// Union-find over row-major cells; comp_node holds each root's tree node
+	std::vector<int32_t> uf(total, -1);
+	std::vector<int32_t> comp_node(total, -1);
+	auto find = [&](int c) {
+		while (uf[c] != c) {
+			uf[c] = uf[uf[c]];
+			c = uf[c];
+		}
+		return c;
+	};
+
+	const int dx8[] = {-1, 0, 1, -1, 1, -1, 0, 1};
+	const int dz8[] = {-1, -1, -1, 0, 0, 1, 1, 1};
+	for (int c : order) {
+		const int cx = c % w;
+		const int cz = c / w;
+		// Round merge levels up so a pair is never reported disconnected at
+		// a clearance its true bottleneck allows
+		const float level = static_cast<float>(bucket_of(sdf_grid[cell_index(cx, cz)]) + 1) * step;
+
+		int roots[8];
+		int root_count = 0;
+		for (int d = 0; d < 8; d++) {
+			int nx = cx + dx8[d];
+			int nz = cz + dz8[d];
+			if (nx < 0 || nx >= w || nz < 0 || nz >= h) continue;
+			int n = nz * w + nx;
+			if (uf[n] < 0) continue;  // not added yet
+			int r = find(n);
+			bool seen = false;
+			for (int i = 0; i < root_count; i++) {
+				if (roots[i] == r) seen = true;
+			}
+			if (!seen) roots[root_count++] = r;
+		}
+
+		uf[c] = c;
+		int node;
+		if (root_count == 0) {
+			// New local maximum of the SDF
+			node = static_cast<int>(ctree_value.size());
+			ctree_value.push_back(level);
+			ctree_parent.push_back(-1);
+		} else if (root_count == 1) {
+			node = comp_node[roots[0]];
+			uf[c] = roots[0];
+		} else {
+			// Components meet here: their nodes become children of a new one
+			node = static_cast<int>(ctree_value.size());
+			ctree_value.push_back(level);
+			ctree_parent.push_back(-1);
+			for (int i = 0; i < root_count; i++) {
+				ctree_parent[comp_node[roots[i]]] = node;
+				uf[roots[i]] = c;
+			}
+		}
+		comp_node[find(c)] = node;
+		clearance_node[c] = node;
+	}
+
+	link_clearance_tree();
+	return static_cast<int>(order.size());
+}
+
+void NavigationMap::link_clearance_tree() {
+	const int count = static_cast<int>(ctree_parent.size());
+	ctree_jump.assign(count, -1);
+	ctree_depth.assign(count, 0);
+	// Parents have higher indices, so walking down visits them first
+	for (int n = count - 1; n >= 0; n--) {
+		int p = ctree_parent[n];
+		if (p < 0) {
+			ctree_jump[n] = n;
+			continue;
+		}
+		ctree_depth[n] = ctree_depth[p] + 1;
+		int j = ctree_jump[p];
+		ctree_jump[n] = (ctree_depth[p] - ctree_depth[j] == ctree_depth[j] - ctree_depth[ctree_jump[j]])
+				? ctree_jump[j]
+				: p;
+	}
+}
+
+int NavigationMap::clearance_component(int cell, float clearance) const {
+	int n = clearance_node[cell];
+	if (n < 0) return -1;
+	// Values only decrease toward the root, so any ancestor at or above
+	// clearance can be jumped to directly
+	while (true) {
+		int p = ctree_parent[n];
+		if (p < 0 || ctree_value[p] < clearance) return n;
+		int j = ctree_jump[n];
+		n = (ctree_value[j] >= clearance) ? j : p;
+	}
+}
+
+bool NavigationMap::can_reach(int x0, int z0, int x1, int z1, float clearance) const {
+	if (!built || !in_bounds(x0, z0) || !in_bounds(x1, z1)) return true;
+	if (get_cell(x0, z0) < clearance || get_cell(x1, z1) < clearance) return true;
+	return same_region_at(x0, z0, x1, z1, clearance);
+}
+
+bool NavigationMap::same_region_at(int x0, int z0, int x1, int z1, float clearance) const {
+	if (clearance <= 0.0f || clearance_node.empty()) return same_region(x0, z0, x1, z1);
+	if (!in_bounds(x0, z0) || !in_bounds(x1, z1)) return false;
+	if (get_cell(x0, z0) < clearance || get_cell(x1, z1) < clearance) return false;
+	int a = clearance_component(z0 * grid_width + x0, clearance);
+	return a >= 0 && a == clearance_component(z1 * grid_width + x1, clearance);
+}
+
+// ============================================================================
+// Runtime land patches (incremental SDF / region / island updates)
+// ============================================================================
+
+void NavigationMap::finish_land_build(std::vector<uint8_t> &&land_mask) {
+	base_land_mask = std::move(land_mask);
+	live_land_mask.clear();
+	shore_tile_base_index.clear();
+	shore_tile_base_sdf.clear();
+	island_grid.clear();
+	land_patches.clear();
+
+	// A rebuild changes everything; consumers cannot diff across it
+	nav_version++;
+	nav_changes.clear();
+	nav_changes_floor = nav_version;
+	clear_jps_tables();
+}
+
+void NavigationMap::begin_land_patches() {
+	live_land_mask = base_land_mask;
+
+	// Shoreline tiles: remember which slot each tile had and the coarse SDF
+	// around it when its samples were built
+	const int span = SHORE_TILE_CELLS + 3;
+	const size_t slots = shore_tile_data.size() / (static_cast<size_t>(shore_tile_stride()) * shore_tile_stride());
+	shore_tile_base_index = shore_tile_index;
+	shore_tile_base_sdf.assign(slots * span * span, 0.0f);
+	for (int tz = 0; tz < shore_tiles_z; tz++) {
+		for (int tx = 0; tx < shore_tiles_x; tx++) {
+			int32_t slot = shore_tile_index[tz * shore_tiles_x + tx];
+			if (slot < 0) continue;
+			float *cells = shore_tile_base_sdf.data() + static_cast<size_t>(slot) * span * span;
+			int x0, z0, x1, z1;
+			shore_tile_cells(tx, tz, x0, z0, x1, z1);
+			for (int iz = z0; iz <= z1; iz++) {
+				for (int ix = x0; ix <= x1; ix++) {
+					cells[(iz - z0) * span + (ix - x0)] = sdf_grid[cell_index(ix, iz)];
+				}
+			}
+		}
+	}
+
+	// Re-extract the islands (quietly, same order and ids as extract_islands)
+	// so island_grid label k is islands[k] even for a map loaded from a cache
+	const int total_cells = grid_width * grid_height;
+	islands.clear();
+	island_grid.assign(total_cells, -1);
+	std::vector<uint8_t> visited(total_cells, 0);
+	std::vector<int> cells;
+	int island_id = 0;
+	for (int idx = 0; idx < total_cells; idx++) {
+		if (!live_land_mask[idx] || visited[idx]) continue;
+		IslandData island;
+		island.id = island_id++;
+		if (!collect_island(live_land_mask, idx % grid_width, idx / grid_width, visited, cells, island)) {
+			continue;
+		}
+		for (int c : cells) {
+			island_grid[c] = static_cast<int32_t>(islands.size());
+		}
+		islands.push_back(std::move(island));
+	}
+}
+
+void NavigationMap::shore_tile_cells(int tx, int tz, int &x0, int &z0, int &x1, int &z1) const {
+	x0 = std::max(0, tx * SHORE_TILE_CELLS - 1);
+	z0 = std::max(0, tz * SHORE_TILE_CELLS - 1);
+	x1 = std::min(grid_width - 1, (tx + 1) * SHORE_TILE_CELLS + 1);
+	z1 = std::min(grid_height - 1, (tz + 1) * SHORE_TILE_CELLS + 1);
+}
+
+bool NavigationMap::shore_tile_at_base(int tx, int tz, int slot) const {
+	const int span = SHORE_TILE_CELLS + 3;
+	const float *cells = shore_tile_base_sdf.data() + static_cast<size_t>(slot) * span * span;
+	int x0, z0, x1, z1;
+	shore_tile_cells(tx, tz, x0, z0, x1, z1);
+	for (int iz = z0; iz <= z1; iz++) {
+		for (int ix = x0; ix <= x1; ix++) {
+			if (cells[(iz - z0) * span + (ix - x0)] != sdf_grid[cell_index(ix, iz)]) return false;
+		}
+	}
+	return true;
+}
+
+int NavigationMap::apply_land_patch(Rect2 rect, const PackedByteArray &mask, int mask_width) {
+	std::unique_lock<std::shared_mutex> query_lock(query_mutex_);
+	if (!built || base_land_mask.empty()) {
+		UtilityFunctions::push_warning("[NavigationMap] apply_land_patch: map is not built");
+		return -1;
+	}
+	int mask_height = 0;
+	if (!mask.is_empty()) {
+		if (mask_width <= 0 || mask.size() % mask_width != 0) {
+			UtilityFunctions::push_warning("[NavigationMap] apply_land_patch: mask size ", mask.size(),
+										   " is not a multiple of mask_width ", mask_width);
+			return -1;
+		}
+		mask_height = static_cast<int>(mask.size() / mask_width);
+	}
+
+	// Cells whose grid point lies inside the rect; a rect smaller than a
+	// cell still claims the cell nearest its centre
+	rect = rect.abs();
+	float gx0, gz0, gx1, gz1;
+	world_to_grid(rect.position.x, rect.position.y, gx0, gz0);
+	world_to_grid(rect.position.x + rect.size.x, rect.position.y + rect.size.y, gx1, gz1);
+	int x0 = static_cast<int>(std::ceil(gx0));
+	int x1 = static_cast<int>(std::floor(gx1));
+	int z0 = static_cast<int>(std::ceil(gz0));
+	int z1 = static_cast<int>(std::floor(gz1));
+	if (x0 > x1) x0 = x1 = static_cast<int>(std::lround((gx0 + gx1) * 0.5f));
+	if (z0 > z1) z0 = z1 = static_cast<int>(std::lround((gz0 + gz1) * 0.5f));
+	x0 = std::max(x0, 0);
+	z0 = std::max(z0, 0);
+	x1 = std::min(x1, grid_width - 1);
+	z1 = std::min(z1, grid_height - 1);
+	if (x0 > x1 || z0 > z1) {
+		UtilityFunctions::push_warning("[NavigationMap] apply_land_patch: rect lies outside the map");
+		return -1;
+	}
+
+	LandPatch patch;
+	patch.x0 = x0;
+	patch.z0 = z0;
+	patch.x1 = x1;
+	patch.z1 = z1;
+	patch.cells.assign(static_cast<size_t>(x1 - x0 + 1) * (z1 - z0 + 1), PATCH_LAND);
+	if (mask_height > 0) {
+		const uint8_t *src = mask.ptr();
+		size_t i = 0;
+		for (int iz = z0; iz <= z1; iz++) {
+			for (int ix = x0; ix <= x1; ix++, i++) {
+				float wx, wz;
+				grid_to_world(ix, iz, wx, wz);
+				float u = rect.size.x > 0.0f ? (wx - rect.position.x) / rect.size.x : 0.5f;
+				float v = rect.size.y > 0.0f ? (wz - rect.position.y) / rect.size.y : 0.5f;
+				int mx = std::max(0, std::min(mask_width - 1, static_cast<int>(u * mask_width)));
+				int mz = std::max(0, std::min(mask_height - 1, static_cast<int>(v * mask_height)));
+				uint8_t value = src[mz * mask_width + mx];
+				patch.cells[i] = value > PATCH_WATER ? PATCH_LAND : value;
+			}
+		}
+	}
+
+	if (live_land_mask.empty()) {
+		begin_land_patches();
+	}
+
+	int patch_id = next_patch_id++;
+	land_patches.emplace(patch_id, std::move(patch));
+
+	int cx0 = grid_width, cz0 = grid_height, cx1 = -1, cz1 = -1;
+	replay_land_patches(x0, z0, x1, z1, cx0, cz0, cx1, cz1);
+	if (cx0 <= cx1) {
+		update_land_rect(cx0, cz0, cx1, cz1);
+	}
+	return patch_id;
+}
+
+bool NavigationMap::remove_land_patch(int patch_id) {
+	std::unique_lock<std::shared_mutex> query_lock(query_mutex_);
+	auto it = land_patches.find(patch_id);
+	if (it == land_patches.end()) return false;
+
+	int x0 = it->second.x0, z0 = it->second.z0;
+	int x1 = it->second.x1, z1 = it->second.z1;
+	land_patches.erase(it);
+
+	int cx0 = grid_width, cz0 = grid_height, cx1 = -1, cz1 = -1;
+	replay_land_patches(x0, z0, x1, z1, cx0, cz0, cx1, cz1);
+	if (cx0 <= cx1) {
+		update_land_rect(cx0, cz0, cx1, cz1);
+	}
+	return true;
+}
+
+void NavigationMap::clear_land_patches() {
+	std::unique_lock<std::shared_mutex> query_lock(query_mutex_);
+	if (land_patches.empty()) return;
+
+	int x0 = grid_width, z0 = grid_height, x1 = -1, z1 = -1;
+	for (const auto &entry : land_patches) {
+		const LandPatch &p = entry.second;
+		x0 = std::min(x0, p.x0);
+		z0 = std::min(z0, p.z0);
+		x1 = std::max(x1, p.x1);
+		z1 = std::max(z1, p.z1);
+	}
+	land_patches.clear();
+
+	int cx0 = grid_width, cz0 = grid_height, cx1 = -1, cz1 = -1;
+	replay_land_patches(x0, z0, x1, z1, cx0, cz0, cx1, cz1);
+	if (cx0 <= cx1) {
+		update_land_rect(cx0, cz0, cx1, cz1);
+	}
+}
+
+void NavigationMap::replay_land_patches(int x0, int z0, int x1, int z1,
+										int &cx0, int &cz0, int &cx1, int &cz1) {
+	const int rw = x1 - x0 + 1;
+	std::vector<uint8_t> cells(static_cast<size_t>(rw) * (z1 - z0 + 1));
+	for (int iz = z0; iz <= z1; iz++) {
+		std::memcpy(cells.data() + static_cast<size_t>(iz - z0) * rw,
+					base_land_mask.data() + static_cast<size_t>(iz) * grid_width + x0, rw);
+	}
+
+	for (const auto &entry : land_patches) {
+		const LandPatch &p = entry.second;
+		int ox0 = std::max(x0, p.x0), ox1 = std::min(x1, p.x1);
+		int oz0 = std::max(z0, p.z0), oz1 = std::min(z1, p.z1);
+		const int pw = p.x1 - p.x0 + 1;
+		for (int iz = oz0; iz <= oz1; iz++) {
+			for (int ix = ox0; ix <= ox1; ix++) {
+				uint8_t value = p.cells[static_cast<size_t>(iz - p.z0) * pw + (ix - p.x0)];
+				if (value == PATCH_KEEP) continue;
+				cells[static_cast<size_t>(iz - z0) * rw + (ix - x0)] = value == PATCH_LAND ? 1 : 0;
+			}
+		}
+	}
+
+	for (int iz = z0; iz <= z1; iz++) {
+		for (int ix = x0; ix <= x1; ix++) {
+			uint8_t value = cells[static_cast<size_t>(iz - z0) * rw + (ix - x0)];
+			uint8_t &live = live_land_mask[static_cast<size_t>(iz) * grid_width + ix];
+			if (live == value) continue;
+			live = value;
+			cx0 = std::min(cx0, ix);
+			cz0 = std::min(cz0, iz);
+			cx1 = std::max(cx1, ix);
+			cz1 = std::max(cz1, iz);
+		}
+	}
+}
+
+void NavigationMap::update_land_rect(int x0, int z0, int x1, int z1) {
+	const int w = grid_width;
+	const int h = grid_height;
+	const uint8_t *mask = live_land_mask.data();
+
+	// Boundary status can change one cell beyond the changed cells
+	const int rx0 = std::max(0, x0 - 1), rz0 = std::max(0, z0 - 1);
+	const int rx1 = std::min(w - 1, x1 + 1), rz1 = std::min(h - 1, z1 + 1);
+
+	// --- SDF ---
+	// A cell whose old distance is shorter than its distance to the changed
+	// rect kept its nearest boundary, so its value cannot change.  The other
+	// cells ("may change") form a star around the rect.  They are recomputed
+	// with the exact EDT over a window around the rect, which starts at
+	// twice the largest distance inside the rect (the most any value can
+	// move by) and doubles until no may-change cell sits on its border and
+	// every may-change value inside is provably exact.
+	auto rect_dist = [&](int ix, int iz) {
+		float dx = static_cast<float>(ix < rx0 ? rx0 - ix : (ix > rx1 ? ix - rx1 : 0));
+		float dz = static_cast<float>(iz < rz0 ? rz0 - iz : (iz > rz1 ? iz - rz1 : 0));
+		return std::sqrt(dx * dx + dz * dz);
+	};
+	auto may_change = [&](int ix, int iz, float slack) {
+		return std::abs(sdf_grid[cell_index(ix, iz)]) / cell_size + slack >= rect_dist(ix, iz);
+	};
+
+	float max_inside = 0.0f;
+	for (int iz = rz0; iz <= rz1; iz++) {
+		for (int ix = rx0; ix <= rx1; ix++) {
+			max_inside = std::max(max_inside, std::abs(sdf_grid[cell_index(ix, iz)]));
+		}
+	}
+	int margin = 2 * static_cast<int>(std::ceil(max_inside / cell_size)) + 2;
+
+	std::vector<float> dist_sq;
+	int wx0, wz0, wx1, wz1;  // window, exclusive end
+	for (;;) {
+		wx0 = std::max(0, rx0 - margin);
+		wz0 = std::max(0, rz0 - margin);
+		wx1 = std::min(w, rx1 + margin + 1);
+		wz1 = std::min(h, rz1 + margin + 1);
+		const bool whole = wx0 == 0 && wz0 == 0 && wx1 == w && wz1 == h;
+
+		// Open window edges (not on the map edge) must see no may-change cell;
+		// the slack covers the grid's approximation of the star shape
+		bool grow = false;
+		if (!whole) {
+			for (int ix = wx0; ix < wx1 && !grow; ix++) {
+				grow = (wz0 > 0 && may_change(ix, wz0, 1.5f)) || (wz1 < h && may_change(ix, wz1 - 1, 1.5f));
+			}
+			for (int iz = wz0; iz < wz1 && !grow; iz++) {
+				grow = (wx0 > 0 && may_change(wx0, iz, 1.5f)) || (wx1 < w && may_change(wx1 - 1, iz, 1.5f));
+			}
+		}
+
+		if (!grow) {
+			edt_window(mask, w, h, wx0, wz0, wx1, wz1, dist_sq);
+
+			// A window distance is exact when no cell outside the window
+			// can be closer than it
+			const int ww = wx1 - wx0;
+			for (int iz = wz0; iz < wz1 && !grow && !whole; iz++) {
+				for (int ix = wx0; ix < wx1; ix++) {
+					if (!may_change(ix, iz, 0.0f)) continue;
+					float outside = std::numeric_limits<float>::max();
+					if (wx0 > 0) outside = std::min(outside, static_cast<float>(ix - wx0 + 1));
+					if (wx1 < w) outside = std::min(outside, static_cast<float>(wx1 - ix));
+					if (wz0 > 0) outside = std::min(outside, static_cast<float>(iz - wz0 + 1));
+					if (wz1 < h) outside = std::min(outside, static_cast<float>(wz1 - iz));
+					if (dist_sq[static_cast<size_t>(iz - wz0) * ww + (ix - wx0)] > outside * outside) {
+						grow = true;
+						break;
+					}
 				}
 			}
 		}
+		if (!grow) break;
+		margin *= 2;
+	}
+
+	const float max_dist_sq = static_cast<float>(w + h) * static_cast<float>(w + h);
+	const int ww = wx1 - wx0;
+	int sx0 = w, sz0 = h, sx1 = -1, sz1 = -1;  // cells whose SDF changed
+	std::vector<int> nav_flipped;               // row-major, navigability changed
+	for (int iz = wz0; iz < wz1; iz++) {
+		for (int ix = wx0; ix < wx1; ix++) {
+			if (!may_change(ix, iz, 0.0f)) continue;
+			float dist = std::sqrt(std::min(dist_sq[static_cast<size_t>(iz - wz0) * ww + (ix - wx0)], max_dist_sq)) * cell_size;
+			float value = mask[static_cast<size_t>(iz) * w + ix] ? -dist : dist;
+			int idx = cell_index(ix, iz);
+			float old = sdf_grid[idx];
+			if (value == old && std::signbit(value) == std::signbit(old)) continue;
+			sdf_grid[idx] = value;
+			sx0 = std::min(sx0, ix);
+			sz0 = std::min(sz0, iz);
+			sx1 = std::max(sx1, ix);
+			sz1 = std::max(sz1, iz);
+			if ((old > 0.0f) != (value > 0.0f)) {
+				nav_flipped.push_back(iz * w + ix);
+			}
+		}
+	}
+
+	// Shoreline tiles over changed cells fall back to the coarse SDF, unless
+	// their cells are back at the SDF the fine samples were built against
+	// (a removed patch): those get their built slot back
+	if (sx0 <= sx1 && !shore_tile_index.empty()) {
+		int tx0 = std::max(0, (sx0 - 1) / SHORE_TILE_CELLS);
+		int tz0 = std::max(0, (sz0 - 1) / SHORE_TILE_CELLS);
+		int tx1 = std::min(shore_tiles_x - 1, (sx1 + 1) / SHORE_TILE_CELLS);
+		int tz1 = std::min(shore_tiles_z - 1, (sz1 + 1) / SHORE_TILE_CELLS);
+		for (int tz = tz0; tz <= tz1; tz++) {
+			for (int tx = tx0; tx <= tx1; tx++) {
+				int32_t slot = shore_tile_base_index[tz * shore_tiles_x + tx];
+				shore_tile_index[tz * shore_tiles_x + tx] =
+					(slot >= 0 && shore_tile_at_base(tx, tz, slot)) ? slot : -1;
+			}
+		}
+	}
+
+	// --- Regions ---
+	// Only the flipped cells' bounding box, grown by one cell, is flooded.
+	// The window's border cells did not change, so every window component
+	// that reaches outside carries the id of the region it belonged to.
+	// When each component holds at most one old id and each old id lies in
+	// one component, no region split or merged: components keep their id
+	// (water newly enclosed in the window gets a fresh one).  Otherwise the
+	// pieces can only be told apart outside the window, and the regions
+	// touching a flipped cell are re-flooded over the whole grid.
+	if (!nav_flipped.empty()) {
+		const int dx4[] = {1, -1, 0, 0};
+		const int dz4[] = {0, 0, 1, -1};
+		int fx0 = w, fz0 = h, fx1 = -1, fz1 = -1;
+		for (int c : nav_flipped) {
+			fx0 = std::min(fx0, c % w);
+			fz0 = std::min(fz0, c / w);
+			fx1 = std::max(fx1, c % w);
+			fz1 = std::max(fz1, c / w);
+		}
+		fx0 = std::max(0, fx0 - 1);
+		fz0 = std::max(0, fz0 - 1);
+		fx1 = std::min(w - 1, fx1 + 1);
+		fz1 = std::min(h - 1, fz1 + 1);
+		const int fw = fx1 - fx0 + 1;
+		const int fh = fz1 - fz0 + 1;
+
+		std::vector<int32_t> window_comp(static_cast<size_t>(fw) * fh, -1);
+		std::vector<int> comp_region;           // old region id per component, -1 = none
+		std::vector<int> comp_begin;            // per component + 1: range into comp_cells
+		std::vector<int> comp_cells;            // window-local cell numbers
+		std::unordered_map<int, int> region_comp;
+		bool local = true;
+		for (int start = 0; start < fw * fh && local; start++) {
+			if (window_comp[start] >= 0) continue;
+			if (sdf_grid[cell_index(fx0 + start % fw, fz0 + start / fw)] <= 0.0f) continue;
+
+			const int comp = static_cast<int>(comp_region.size());
+			int rid = -1;
+			comp_begin.push_back(static_cast<int>(comp_cells.size()));
+			window_comp[start] = comp;
+			comp_cells.push_back(start);
+			for (size_t head = comp_begin.back(); head < comp_cells.size(); head++) {
+				int lx = comp_cells[head] % fw, lz = comp_cells[head] / fw;
+				int old_id = region_grid[cell_index(fx0 + lx, fz0 + lz)];
+				if (old_id >= 0 && old_id != rid) {
+					auto it = region_comp.emplace(old_id, comp).first;
+					if (rid >= 0 || it->second != comp) {
+						local = false;  // merge, or a region in several pieces
+						break;
+					}
+					rid = old_id;
+				}
+				for (int d = 0; d < 4; d++) {
+					int nx = lx + dx4[d], nz = lz + dz4[d];
+					if (nx < 0 || nx >= fw || nz < 0 || nz >= fh) continue;
+					int n = nz * fw + nx;
+					if (window_comp[n] >= 0 || sdf_grid[cell_index(fx0 + nx, fz0 + nz)] <= 0.0f) continue;
+					window_comp[n] = comp;
+					comp_cells.push_back(n);
+				}
+			}
+			comp_region.push_back(rid);
+		}
+
+		if (local) {
+			comp_begin.push_back(static_cast<int>(comp_cells.size()));
+			for (int i = 0; i < fw * fh; i++) {
+				if (window_comp[i] < 0) region_grid[cell_index(fx0 + i % fw, fz0 + i / fw)] = -1;
+			}
+			for (size_t comp = 0; comp < comp_region.size(); comp++) {
+				int rid = comp_region[comp] >= 0 ? comp_region[comp] : region_count++;
+				for (int k = comp_begin[comp]; k < comp_begin[comp + 1]; k++) {
+					int i = comp_cells[k];
+					region_grid[cell_index(fx0 + i % fw, fz0 + i / fw)] = rid;
+				}
+			}
+		} else {
+			// Each water component touching a flipped cell is re-flooded; the
+			// first one to reach an old region id keeps it, any further piece
+			// of that region gets a new id.
+			std::vector<uint8_t> done(static_cast<size_t>(w) * h, 0);
+			std::vector<int> seeds;
+			for (int c : nav_flipped) {
+				seeds.push_back(c);
+				int cx = c % w, cz = c / w;
+				for (int d = 0; d < 4; d++) {
+					int nx = cx + dx4[d], nz = cz + dz4[d];
+					if (nx >= 0 && nx < w && nz >= 0 && nz < h) seeds.push_back(nz * w + nx);
+				}
+			}
+
+			std::unordered_set<int> reused_ids;
+			std::vector<int> component;
+			for (int seed : seeds) {
+				if (done[seed]) continue;
+				done[seed] = 1;
+				int sidx = cell_index(seed % w, seed / w);
+				if (sdf_grid[sidx] <= 0.0f) {
+					region_grid[sidx] = -1;
+					continue;
+				}
+
+				int rid = -1;
+				component.clear();
+				component.push_back(seed);
+				for (size_t head = 0; head < component.size(); head++) {
+					int cx = component[head] % w, cz = component[head] / w;
+					int old_id = region_grid[cell_index(cx, cz)];
+					if (rid < 0 && old_id >= 0 && reused_ids.insert(old_id).second) rid = old_id;
+					for (int d = 0; d < 4; d++) {
+						int nx = cx + dx4[d], nz = cz + dz4[d];
+						if (nx < 0 || nx >= w || nz < 0 || nz >= h) continue;
+						int n = nz * w + nx;
+						if (done[n] || sdf_grid[cell_index(nx, nz)] <= 0.0f) continue;
+						done[n] = 1;
+						component.push_back(n);
+					}
+				}
+				if (rid < 0) rid = region_count++;
+				for (int c : component) {
+					region_grid[cell_index(c % w, c / w)] = rid;
+				}
+			}
+		}
+	}
+
+	// --- Islands ---
+	// Islands with a cell in (or 8-adjacent to) the changed rect are dropped
+	// and their land re-flooded; untouched islands keep their data and id.
+	{
+		std::vector<uint8_t> affected(islands.size(), 0);
+		std::vector<int> seeds;
+		for (int iz = rz0; iz <= rz1; iz++) {
+			for (int ix = rx0; ix <= rx1; ix++) {
+				int c = iz * w + ix;
+				if (island_grid[c] >= 0) affected[island_grid[c]] = 1;
+				if (mask[c]) seeds.push_back(c);
+			}
+		}
+
+		// Unlabel the dropped islands; their remaining land seeds new floods
+		std::vector<int> stack;
+		for (int iz = rz0; iz <= rz1; iz++) {
+			for (int ix = rx0; ix <= rx1; ix++) {
+				int label = island_grid[iz * w + ix];
+				if (label < 0) continue;
+				stack.push_back(iz * w + ix);
+				island_grid[iz * w + ix] = -1;
+				while (!stack.empty()) {
+					int c = stack.back();
+					stack.pop_back();
+					if (mask[c]) seeds.push_back(c);
+					int cx = c % w, cz = c / w;
+					for (int dz = -1; dz <= 1; dz++) {
+						for (int dx = -1; dx <= 1; dx++) {
+							int nx = cx + dx, nz = cz + dz;
+							if (nx < 0 || nx >= w || nz < 0 || nz >= h) continue;
+							int n = nz * w + nx;
+							if (island_grid[n] != label) continue;
+							island_grid[n] = -1;
+							stack.push_back(n);
+						}
+					}
+				}
+			}
+		}
+
+		std::vector<uint8_t> visited(static_cast<size_t>(w) * h, 0);
+		std::vector<IslandData> added;
+		std::vector<std::vector<int>> added_cells;
+		std::vector<int> cells;
+		int next_id = 0;
+		for (const IslandData &island : islands) {
+			next_id = std::max(next_id, island.id + 1);
+		}
+		for (int seed : seeds) {
+			if (visited[seed]) continue;
+			IslandData island;
+			if (!collect_island(live_land_mask, seed % w, seed / w, visited, cells, island)) continue;
+			island.id = next_id++;
+			added.push_back(std::move(island));
+			added_cells.push_back(cells);
+		}
+
+		// Keep untouched islands in order, then append the new ones
+		std::vector<int> remap(islands.size(), -1);
+		std::vector<IslandData> kept;
+		bool shifted = false;
+		for (size_t i = 0; i < islands.size(); i++) {
+			if (affected[i]) {
+				shifted = true;
+				continue;
+			}
+			remap[i] = static_cast<int>(kept.size());
+			kept.push_back(std::move(islands[i]));
+		}
+		if (shifted) {
+			for (int32_t &label : island_grid) {
+				if (label >= 0) label = remap[label];
+			}
+		}
+		for (size_t i = 0; i < added.size(); i++) {
+			int label = static_cast<int>(kept.size());
+			for (int c : added_cells[i]) {
+				island_grid[c] = label;
+			}
+			kept.push_back(std::move(added[i]));
+		}
+		islands = std::move(kept);
 	}
 
-	UtilityFunctions::print("[NavigationMap] Computed ", region_count, " navigable water regions.");
+	// --- Clearance tree ---
+	// A closed or opened strait moves merge levels anywhere on the map, so
+	// the tree is rebuilt rather than patched; the rebuild is linear.
+	// JPS+ tables are rebuilt on their next use.
+	if (sx0 <= sx1) {
+		compute_clearance_tree();
+		clear_jps_tables();
+	}
+
+	// --- Version ---
+	nav_version++;
+	if (sx0 <= sx1) {
+		if (static_cast<int>(nav_changes.size()) >= MAX_NAV_CHANGES) {
+			nav_changes_floor = nav_changes.front().version;
+			nav_changes.erase(nav_changes.begin());
+		}
+		nav_changes.push_back({ nav_version, sx0, sz0, sx1, sz1 });
+	}
+}
+
+bool NavigationMap::get_changed_cells_since(uint64_t version, int &x0, int &z0, int &x1, int &z1) const {
+	x0 = grid_width;
+	z0 = grid_height;
+	x1 = -1;
+	z1 = -1;
+	if (version < nav_changes_floor) return false;
+	for (const NavChange &change : nav_changes) {
+		if (change.version <= version) continue;
+		x0 = std::min(x0, change.x0);
+		z0 = std::min(z0, change.z0);
+		x1 = std::max(x1, change.x1);
+		z1 = std::max(z1, change.z1);
+	}
+	return true;
 }
 
 // ============================================================================
@@ -1116,6 +2226,21 @@ float NavigationMap::sample_bilinear(float gx, float gz) const {
 	gx = std::max(0.0f, std::min(gx, static_cast<float>(grid_width - 1)));
 	gz = std::max(0.0f, std::min(gz, static_cast<float>(grid_height - 1)));
 
+	// Near a coastline: interpolate the fine tile instead
+	float lx, lz;
+	if (const float *tile = find_shore_tile(gx, gz, lx, lz)) {
+		const int stride = shore_tile_stride();
+		int tx0 = std::min(static_cast<int>(lx), stride - 2);
+		int tz0 = std::min(static_cast<int>(lz), stride - 2);
+		float tfx = lx - static_cast<float>(tx0);
+		float tfz = lz - static_cast<float>(tz0);
+		const float *r0 = tile + tz0 * stride + tx0;
+		const float *r1 = r0 + stride;
+		float t0 = r0[0] * (1.0f - tfx) + r0[1] * tfx;
+		float t1 = r1[0] * (1.0f - tfx) + r1[1] * tfx;
+		return t0 * (1.0f - tfz) + t1 * tfz;
+	}
+
 	int x0 = static_cast<int>(std::floor(gx));
 	int z0 = static_cast<int>(std::floor(gz));
 	int x1 = std::min(x0 + 1, grid_width - 1);
@@ -1147,10 +2272,10 @@ float NavigationMap::sample_height_bilinear(float gx, float gz) const {
 	float fx = gx - static_cast<float>(x0);
 	float fz = gz - static_cast<float>(z0);
 
-	float v00 = height_grid[z0 * grid_width + x0];
-	float v10 = height_grid[z0 * grid_width + x1];
-	float v01 = height_grid[z1 * grid_width + x0];
-	float v11 = height_grid[z1 * grid_width + x1];
+	float v00 = height_grid[cell_index(x0, z0)];
+	float v10 = height_grid[cell_index(x1, z0)];
+	float v01 = height_grid[cell_index(x0, z1)];
+	float v11 = height_grid[cell_index(x1, z1)];
 
 	float v0 = v00 * (1.0f - fx) + v10 * fx;
 	float v1 = v01 * (1.0f - fx) + v11 * fx;
@@ -1197,11 +2322,21 @@ float NavigationMap::get_terrain_height(float x, float z) const {
 	return sample_height_bilinear(gx, gz);
 }
 
+float NavigationMap::gradient_step(float x, float z) const {
+	float h = cell_size * 0.5f;
+	float gx, gz, lx, lz;
+	world_to_grid(x, z, gx, gz);
+	if (gx >= 0.0f && gz >= 0.0f && find_shore_tile(gx, gz, lx, lz)) {
+		h /= static_cast<float>(shore_refinement);
+	}
+	return h;
+}
+
 Vector2 NavigationMap::get_gradient(float x, float z) const {
 	if (!built) return Vector2(0, 0);
 
-	// Central differences for gradient
-	float h = cell_size * 0.5f;
+	// Central differences for gradient, at the fine spacing near a coastline
+	float h = gradient_step(x, z);
 	float dx = get_distance(x + h, z) - get_distance(x - h, z);
 	float dz = get_distance(x, z + h) - get_distance(x, z - h);
 
@@ -1213,10 +2348,90 @@ Vector2 NavigationMap::get_gradient(float x, float z) const {
 	return grad;
 }
 
+void NavigationMap::sample_distances(const Vector2 *pts, int n, float *out) const {
+	if (!built) {
+		std::fill(out, out + n, 10000.0f);  // Unbounded water, as get_distance
+		return;
+	}
+
+	const float w = static_cast<float>(grid_width);
+	const float h = static_cast<float>(grid_height);
+	for (int i = 0; i < n; i++) {
+		float gx, gz;
+		world_to_grid(pts[i].x, pts[i].y, gx, gz);
+		if (gx < 0.0f || gx >= w || gz < 0.0f || gz >= h) {
+			out[i] = get_distance(pts[i].x, pts[i].y);  // outside the map: wall distance
+			continue;
+		}
+		out[i] = sample_bilinear(gx, gz);
+	}
+}
+
+void NavigationMap::sample_gradients(const Vector2 *pts, int n, Vector2 *out) const {
+	if (!built) {
+		std::fill(out, out + n, Vector2(0, 0));
+		return;
+	}
+
+	// Four central-difference taps per point, sampled in one batch
+	std::vector<Vector2> taps(static_cast<size_t>(n) * 4);
+	std::vector<float> d(taps.size());
+	for (int i = 0; i < n; i++) {
+		float step = gradient_step(pts[i].x, pts[i].y);
+		taps[i * 4 + 0] = pts[i] + Vector2(step, 0.0f);
+		taps[i * 4 + 1] = pts[i] - Vector2(step, 0.0f);
+		taps[i * 4 + 2] = pts[i] + Vector2(0.0f, step);
+		taps[i * 4 + 3] = pts[i] - Vector2(0.0f, step);
+	}
+	sample_distances(taps.data(), n * 4, d.data());
+
+	for (int i = 0; i < n; i++) {
+		Vector2 grad(d[i * 4 + 0] - d[i * 4 + 1], d[i * 4 + 2] - d[i * 4 + 3]);
+		float len = grad.length();
+		if (len > 0.0001f) {
+			grad /= len;
+		}
+		out[i] = grad;
+	}
+}
+
+PackedFloat32Array NavigationMap::get_distances(const PackedVector2Array &points) const {
+	PackedFloat32Array result;
+	result.resize(points.size());
+	sample_distances(points.ptr(), static_cast<int>(points.size()), result.ptrw());
+	return result;
+}
+
+PackedVector2Array NavigationMap::get_gradients(const PackedVector2Array &points) const {
+	PackedVector2Array result;
+	result.resize(points.size());
+	sample_gradients(points.ptr(), static_cast<int>(points.size()), result.ptrw());
+	return result;
+}
+
 bool NavigationMap::is_navigable(float x, float z, float clearance) const {
 	return get_distance(x, z) >= clearance;
 }
 
+bool NavigationMap::is_reachable(Vector2 from, Vector2 to, float clearance) const {
+	if (!built) return false;
+
+	float fx = from.x, fz = from.y, tx = to.x, tz = to.y;
+	clamp_world_to_bounds(fx, fz);
+	clamp_world_to_bounds(tx, tz);
+	float gx0, gz0, gx1, gz1;
+	world_to_grid(fx, fz, gx0, gz0);
+	world_to_grid(tx, tz, gx1, gz1);
+	int sx = std::max(0, std::min(static_cast<int>(std::round(gx0)), grid_width - 1));
+	int sz = std::max(0, std::min(static_cast<int>(std::round(gz0)), grid_height - 1));
+	int ex = std::max(0, std::min(static_cast<int>(std::round(gx1)), grid_width - 1));
+	int ez = std::max(0, std::min(static_cast<int>(std::round(gz1)), grid_height - 1));
+	if (!find_nearest_navigable(sx, sz, clearance) || !find_nearest_navigable(ex, ez, clearance)) {
+		return false;
+	}
+	return same_region(sx, sz, ex, ez) && same_region_at(sx, sz, ex, ez, clearance);
+}
+
 // ============================================================================
 // Raycasting
 // ============================================================================
@@ -1451,9 +2666,9 @@ bool NavigationMap::find_nearest_navigable(int &ix, int &iz, float clearance) co
 }
 
 PackedVector2Array NavigationMap::find_path(Vector2 from, Vector2 to, float clearance,
-										   float turning_radius) const {
+										   float turning_radius, int planner) const {
 	PackedVector2Array result;
-	PathResult pr = find_path_internal(from, to, clearance, turning_radius);
+	PathResult pr = find_path_internal(from, to, clearance, turning_radius, planner);
 
 	if (pr.valid) {
 		for (const auto &wp : pr.waypoints) {
@@ -1465,8 +2680,8 @@ PackedVector2Array NavigationMap::find_path(Vector2 from, Vector2 to, float clea
 }
 
 PathResult NavigationMap::find_path_internal(Vector2 from, Vector2 to, float clearance,
-											 float turning_radius) const {
-	if (begin_path_search(sync_search_, from, to, clearance, turning_radius)) {
+											 float turning_radius, int planner) const {
+	if (begin_path_search(sync_search_, from, to, clearance, turning_radius, planner)) {
 		return sync_search_.result;
 	}
 	continue_path_search(sync_search_, sync_search_.max_iterations);
@@ -1478,7 +2693,7 @@ PathResult NavigationMap::find_path_internal(Vector2 from, Vector2 to, float cle
 // ============================================================================
 
 bool NavigationMap::begin_path_search(PathSearch &search, Vector2 from, Vector2 to,
-									  float clearance, float turning_radius) const {
+									  float clearance, float turning_radius, int planner) const {
 	search.reset();
 	search.result.valid = false;
 	search.result.total_distance = 0.0f;
@@ -1535,6 +2750,11 @@ bool NavigationMap::begin_path_search(PathSearch &search, Vector2 from, Vector2
 		search.complete = true;
 		return true;
 	}
+	if (!same_region_at(search.sx, search.sz, search.ex, search.ez, search.clearance_world)) {
+		UtilityFunctions::print("[NavigationMap] find_path: no water route wide enough for clearance ", clearance, " (unreachable)");
+		search.complete = true;
+		return true;
+	}
 
 	// Trivial case: start == end
 	if (search.sx == search.ex && search.sz == search.ez) {
@@ -1574,6 +2794,16 @@ bool NavigationMap::begin_path_search(PathSearch &search, Vector2 from, Vector2
 	search.end_idx = cell_idx(search.ex, search.ez);
 	search.start_idx = cell_idx(search.sx, search.sz);
 
+	// JPS+ needs both endpoints open at the table's (rounded-up) clearance
+	if (planner == PLANNER_JPS_PLUS) {
+		std::shared_ptr<const JpsTable> table = get_jps_table(clearance);
+		if (table && get_cell(search.sx, search.sz) >= table->clearance &&
+				get_cell(search.ex, search.ez) >= table->clearance) {
+			search.planner = CELL_PLANNER_JPS_PLUS;
+			search.jps = std::move(table);
+		}
+	}
+
 	// Allocate and reset generation counter
 	search.allocate(total_cells);
 	search.current_gen++;
@@ -1585,7 +2815,9 @@ bool NavigationMap::begin_path_search(PathSearch &search, Vector2 from, Vector2
 
 	search.g_cost[search.start_idx] = 0.0f;
 	search.open_gen[search.start_idx] = search.current_gen;
-	search.open_set.push({heuristic(search.sx, search.sz, search.ex, search.ez), search.start_idx});
+	search.open_set.push(search.start_idx,
+						 search.jps ? octile(search.sx, search.sz, search.ex, search.ez)
+									: heuristic(search.sx, search.sz, search.ex, search.ez));
 
 	search.parent[search.start_idx] = search.start_idx;
 	search.parent_dir[search.start_idx] = -1;
@@ -1609,6 +2841,7 @@ bool NavigationMap::begin_path_search(PathSearch &search, Vector2 from, Vector2
 
 bool NavigationMap::continue_path_search(PathSearch &search, int max_iterations) const {
 	if (!search.active || search.complete) return true;
+	if (search.planner == CELL_PLANNER_JPS_PLUS) return continue_jps_search(search, max_iterations);
 
 	auto cell_idx = [&search](int x, int z) -> int {
 		return z * search.grid_width + x;
@@ -1625,8 +2858,7 @@ bool NavigationMap::continue_path_search(PathSearch &search, int max_iterations)
 		budget--;
 		search.iterations++;
 
-		auto [f, ci] = search.open_set.top();
-		search.open_set.pop();
+		auto [f, ci] = search.open_set.pop();
 
 		if (search.closed_gen[ci] == search.current_gen) continue;
 		search.closed_gen[ci] = search.current_gen;
@@ -1720,7 +2952,7 @@ bool NavigationMap::continue_path_search(PathSearch &search, int max_iterations)
 					search.open_gen[nidx] = search.current_gen;
 					search.parent[nidx] = ci;
 					search.parent_dir[nidx] = static_cast<int8_t>(d);
-					search.open_set.push({new_g + heuristic(nx, nz, search.ex, search.ez), nidx});
+					search.open_set.push(nidx, new_g + heuristic(nx, nz, search.ex, search.ez));
 				}
 			}
 		}
@@ -1816,6 +3048,213 @@ PathResult NavigationMap::finish_path_search(PathSearch &search) const {
 	return result;
 }
 
+// ============================================================================
+// JPS+ (Jump Point Search over precomputed jump distances)
+// ============================================================================
+//
+// Moves follow the cell A* rules: 8-connected, a cell is open when its SDF
+// is at least the clearance, and a diagonal step needs both orthogonal
+// neighbours open (no corner cutting).  With those rules a straight run
+// only needs to stop where a side cell opens up behind a closed one (a
+// "forced" neighbour), and a diagonal run stops where either straight run
+// from it would reach such a cell.  The table stores, per cell and
+// direction, the distance to that stop or to the first closed cell, so an
+// expansion costs a table read per direction instead of a scan.
+
+std::shared_ptr<const JpsTable> NavigationMap::get_jps_table(float clearance) const {
+	const float step = cell_size / static_cast<float>(JPS_CLEARANCE_STEPS);
+	const float bucket = std::ceil(std::max(clearance, 0.0f) / step - 1e-4f) * step;
+
+	std::lock_guard<std::mutex> lock(jps_mutex_);
+	for (size_t i = 0; i < jps_tables_.size(); i++) {
+		if (jps_tables_[i]->clearance == bucket) {
+			std::shared_ptr<const JpsTable> table = jps_tables_[i];
+			jps_tables_.erase(jps_tables_.begin() + i);
+			jps_tables_.push_back(table);
+			return table;
+		}
+	}
+
+	std::shared_ptr<const JpsTable> table = build_jps_table(bucket);
+	if (!table) return table;
+	if (static_cast<int>(jps_tables_.size()) >= JPS_MAX_TABLES) {
+		jps_tables_.erase(jps_tables_.begin());
+	}
+	jps_tables_.push_back(table);
+	return table;
+}
+
+std::shared_ptr<JpsTable> NavigationMap::build_jps_table(float clearance) const {
+	const int w = grid_width;
+	const int h = grid_height;
+	if (!built || std::max(w, h) >= std::numeric_limits<int16_t>::max()) {
+		return nullptr;
+	}
+
+	std::vector<uint8_t> open(static_cast<size_t>(w) * h);
+	for (int iz = 0; iz < h; iz++) {
+		for (int ix = 0; ix < w; ix++) {
+			open[iz * w + ix] = sdf_grid[cell_index(ix, iz)] >= clearance;
+		}
+	}
+	auto is_open = [&](int x, int z) {
+		return x >= 0 && x < w && z >= 0 && z < h && open[z * w + x];
+	};
+
+	auto table = std::make_shared<JpsTable>();
+	table->clearance = clearance;
+	table->width = w;
+	table->height = h;
+	table->dist.assign(static_cast<size_t>(w) * h * 8, 0);
+	int16_t *dist = table->dist.data();
+
+	const int dx8[] = {-1, 0, 1, -1, 1, -1, 0, 1};
+	const int dz8[] = {-1, -1, -1, 0, 0, 1, 1, 1};
+	// Straight directions first: diagonal runs read them
+	const int order[] = {1, 3, 4, 6, 0, 2, 5, 7};
+
+	for (int d : order) {
+		const int dx = dx8[d];
+		const int dz = dz8[d];
+		const bool diag = (dx != 0 && dz != 0);
+		const int dir_x = dir_from_offset(dx, 0);
+		const int dir_z = dir_from_offset(0, dz);
+
+		// Sweep against the direction so each cell's successor is done first
+		for (int zi = 0; zi < h; zi++) {
+			const int z = (dz > 0) ? h - 1 - zi : zi;
+			for (int xi = 0; xi < w; xi++) {
+				const int x = (dx > 0) ? w - 1 - xi : xi;
+				const int nx = x + dx;
+				const int nz = z + dz;
+				int16_t v = 0;
+				if (!is_open(nx, nz) || (diag && (!is_open(nx, z) || !is_open(x, nz)))) {
+					v = 0;
+				} else {
+					const int16_t *next = dist + (static_cast<size_t>(nz) * w + nx) * 8;
+					bool stop;
+					if (diag) {
+						stop = next[dir_x] > 0 || next[dir_z] > 0;
+					} else {
+						// Forced neighbour: a side cell open here but closed one step back
+						stop = (is_open(nx + dz, nz + dx) && !is_open(x + dz, z + dx)) ||
+							   (is_open(nx - dz, nz - dx) && !is_open(x - dz, z - dx));
+					}
+					if (stop) {
+						v = 1;
+					} else {
+						v = (next[d] > 0) ? static_cast<int16_t>(next[d] + 1) : static_cast<int16_t>(next[d] - 1);
+					}
+				}
+				dist[(static_cast<size_t>(z) * w + x) * 8 + d] = v;
+			}
+		}
+	}
+	return table;
+}
+
+void NavigationMap::clear_jps_tables() {
+	std::lock_guard<std::mutex> lock(jps_mutex_);
+	jps_tables_.clear();
+}
+
+bool NavigationMap::continue_jps_search(PathSearch &search, int max_iterations) const {
+	const JpsTable &table = *search.jps;
+	const int w = search.grid_width;
+
+	const int dx8[] = {-1, 0, 1, -1, 1, -1, 0, 1};
+	const int dz8[] = {-1, -1, -1, 0, 0, 1, 1, 1};
+	int budget = max_iterations;
+
+	while (!search.open_set.empty() && search.iterations < search.max_iterations && budget > 0) {
+		budget--;
+		search.iterations++;
+
+		auto [f, ci] = search.open_set.pop();
+
+		if (search.closed_gen[ci] == search.current_gen) continue;
+		search.closed_gen[ci] = search.current_gen;
+
+		if (ci == search.end_idx) {
+			search.found = true;
+			break;
+		}
+
+		const int cx = ci % w;
+		const int cz = ci / w;
+		const float cg = search.g_cost[ci];
+		const int16_t *jumps = table.dist.data() + static_cast<size_t>(ci) * 8;
+
+		// Pruned directions: all 8 at the start; straight arrivals keep going
+		// and may turn 45 or 90 degrees; diagonal arrivals keep the diagonal
+		// and its two straight components
+		uint8_t dirs = 0xFF;
+		const int pd = search.parent_dir[ci];
+		if (pd >= 0) {
+			const int pdx = dx8[pd];
+			const int pdz = dz8[pd];
+			if (pdx != 0 && pdz != 0) {
+				dirs = static_cast<uint8_t>((1 << pd) | (1 << dir_from_offset(pdx, 0)) | (1 << dir_from_offset(0, pdz)));
+			} else {
+				dirs = static_cast<uint8_t>((1 << pd) |
+						(1 << dir_from_offset(pdz, pdx)) | (1 << dir_from_offset(-pdz, -pdx)) |
+						(1 << dir_from_offset(pdx + pdz, pdz + pdx)) | (1 << dir_from_offset(pdx - pdz, pdz - pdx)));
+			}
+		}
+
+		const int goal_dx = search.ex - cx;
+		const int goal_dz = search.ez - cz;
+
+		for (int d = 0; d < 8; d++) {
+			if (!(dirs & (1 << d))) continue;
+			const int dx = dx8[d];
+			const int dz = dz8[d];
+			const int jump = jumps[d];
+			const int reach = std::abs(jump);
+			const bool is_diag = (dx != 0 && dz != 0);
+
+			// Stop on the goal (straight) or on its row/column (diagonal) when
+			// that comes before the jump point or the blocking cell
+			int steps = 0;
+			if (is_diag) {
+				if (dx * goal_dx > 0 && dz * goal_dz > 0) {
+					int m = std::min(std::abs(goal_dx), std::abs(goal_dz));
+					if (m <= reach) steps = m;
+				}
+			} else if (dx == 0 ? (goal_dx == 0 && dz * goal_dz > 0 && std::abs(goal_dz) <= reach)
+							   : (goal_dz == 0 && dx * goal_dx > 0 && std::abs(goal_dx) <= reach)) {
+				steps = std::abs(goal_dx) + std::abs(goal_dz);
+			}
+			if (steps == 0 && jump > 0) steps = jump;
+			if (steps == 0) continue;
+
+			const int nx = cx + dx * steps;
+			const int nz = cz + dz * steps;
+			const int nidx = nz * w + nx;
+			if (search.closed_gen[nidx] == search.current_gen) continue;
+
+			float new_g = cg + (is_diag ? (steps * 1.414f) : static_cast<float>(steps));
+			bool is_better = (search.open_gen[nidx] != search.current_gen)
+							 || (new_g < search.g_cost[nidx]);
+			if (is_better) {
+				search.g_cost[nidx] = new_g;
+				search.open_gen[nidx] = search.current_gen;
+				search.parent[nidx] = ci;
+				search.parent_dir[nidx] = static_cast<int8_t>(d);
+				search.open_set.push(nidx, new_g + octile(nx, nz, search.ex, search.ez));
+			}
+		}
+	}
+
+	if (search.found || search.open_set.empty() || search.iterations >= search.max_iterations) {
+		search.complete = true;
+		search.active = false;
+		return true;
+	}
+
+	return false;
+}
+
 // ============================================================================
 // Post-process a raw path: push waypoints away from land, then simplify
 // ============================================================================
@@ -2601,19 +4040,28 @@ TypedArray<Dictionary> NavigationMap::find_cover_candidates(
 // ============================================================================
 
 PackedFloat32Array NavigationMap::get_sdf_data() const {
+	// Always row-major, independent of the storage layout
 	PackedFloat32Array result;
-	result.resize(static_cast<int>(sdf_grid.size()));
-	for (size_t i = 0; i < sdf_grid.size(); i++) {
-		result[static_cast<int>(i)] = sdf_grid[i];
+	if (sdf_grid.empty()) return result;
+	result.resize(grid_width * grid_height);
+	float *out = result.ptrw();
+	for (int iz = 0; iz < grid_height; iz++) {
+		for (int ix = 0; ix < grid_width; ix++) {
+			out[iz * grid_width + ix] = sdf_grid[cell_index(ix, iz)];
+		}
 	}
 	return result;
 }
 
 PackedFloat32Array NavigationMap::get_height_data() const {
 	PackedFloat32Array result;
-	result.resize(static_cast<int>(height_grid.size()));
-	for (size_t i = 0; i < height_grid.size(); i++) {
-		result[static_cast<int>(i)] = height_grid[i];
+	if (height_grid.empty()) return result;
+	result.resize(grid_width * grid_height);
+	float *out = result.ptrw();
+	for (int iz = 0; iz < grid_height; iz++) {
+		for (int ix = 0; ix < grid_width; ix++) {
+			out[iz * grid_width + ix] = height_grid[cell_index(ix, iz)];
+		}
 	}
 	return result;
 }
@@ -2634,8 +4082,511 @@ bool NavigationMap::is_built() const {
 	return built;
 }
 
+int NavigationMap::get_shore_refinement() const {
+	return shore_refinement;
+}
+
+int NavigationMap::get_shore_tile_count() const {
+	int count = 0;
+	for (int32_t slot : shore_tile_index) {
+		if (slot >= 0) count++;
+	}
+	return count;
+}
+
 int NavigationMap::get_island_count() const {
 	return static_cast<int>(islands.size());
 }
 
 
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+Dictionary NavigationMap::benchmark_grid_layouts(int samples) {
+	// Swaps the grid storage under any planner query
+	std::unique_lock<std::shared_mutex> query_lock(query_mutex_);
+	Dictionary result;
+	if (!built) {
+		UtilityFunctions::push_error("[NavigationMap] benchmark_grid_layouts: map is not built");
+		return result;
+	}
+	samples = std::max(1, samples);
+	const int ray_samples = std::max(1, samples / 20);  // rays/LOS walk many cells
+
+	// One query set shared by every layout: uniform random points, and a
+	// coherent walk (short steps, slowly turning) like a ship or a raymarch
+	std::mt19937 rng(12345);
+	std::uniform_real_distribution<float> ux(min_x, max_x);
+	std::uniform_real_distribution<float> uz(min_z, max_z);
+	std::uniform_real_distribution<float> turn(-0.2f, 0.2f);
+
+	std::vector<Vector2> random_pts(samples);
+	std::vector<Vector2> coherent_pts(samples);
+	Vector2 walk(ux(rng), uz(rng));
+	float heading = 0.0f;
+	for (int i = 0; i < samples; i++) {
+		random_pts[i] = Vector2(ux(rng), uz(rng));
+		heading += turn(rng);
+		walk += Vector2(std::cos(heading), std::sin(heading)) * (cell_size * 0.37f);
+		if (walk.x < min_x || walk.x > max_x || walk.y < min_z || walk.y > max_z) {
+			heading += Math_PI;
+			clamp_world_to_bounds(walk.x, walk.y);
+		}
+		coherent_pts[i] = walk;
+	}
+
+	const float ray_length = cell_size * 60.0f;
+	auto ray_end = [&](const Vector2 &from, int i) {
+		float a = static_cast<float>(i) * 2.39996323f;  // golden angle spread
+		Vector2 to = from + Vector2(std::cos(a), std::sin(a)) * ray_length;
+		clamp_world_to_bounds(to.x, to.y);
+		return to;
+	};
+	auto to_cell = [&](const Vector2 &p, int &ix, int &iz) {
+		float gx, gz;
+		world_to_grid(p.x, p.y, gx, gz);
+		ix = std::max(0, std::min(grid_width - 1, static_cast<int>(gx)));
+		iz = std::max(0, std::min(grid_height - 1, static_cast<int>(gz)));
+	};
+
+	using Clock = std::chrono::steady_clock;
+	auto ns_per = [](Clock::time_point t0, Clock::time_point t1, int n) {
+		return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+	};
+
+	const int original_shift = grid_tile_shift;
+	struct Layout { const char *name; int shift; };
+	const Layout layouts[] = { { "row_major", 0 }, { "tiled_8x8", DEFAULT_GRID_TILE_SHIFT } };
+
+	for (const Layout &layout : layouts) {
+		set_grid_layout(layout.shift);
+		Dictionary d;
+		// Checksum of all query results: must match across layouts
+		double checksum = 0.0;
+
+		for (const auto &set : { std::make_pair("random", &random_pts), std::make_pair("coherent", &coherent_pts) }) {
+			const std::vector<Vector2> &pts = *set.second;
+			String suffix = String("_") + set.first + "_ns";
+
+			auto t0 = Clock::now();
+			float dist_sum = 0.0f;
+			for (int i = 0; i < samples; i++) {
+				dist_sum += get_distance(pts[i].x, pts[i].y);
+			}
+			auto t1 = Clock::now();
+			d[String("get_distance") + suffix] = ns_per(t0, t1, samples);
+			checksum += dist_sum;
+
+			t0 = Clock::now();
+			float ray_sum = 0.0f;
+			for (int i = 0; i < ray_samples; i++) {
+				RayResult ray = raycast_internal(pts[i], ray_end(pts[i], i), 0.0f);
+				ray_sum += ray.hit ? ray.distance : ray_length;
+			}
+			t1 = Clock::now();
+			d[String("raycast") + suffix] = ns_per(t0, t1, ray_samples);
+			checksum += ray_sum;
+
+			t0 = Clock::now();
+			int los_clear = 0;
+			for (int i = 0; i < ray_samples; i++) {
+				int x0, z0, x1, z1;
+				to_cell(pts[i], x0, z0);
+				to_cell(ray_end(pts[i], i), x1, z1);
+				los_clear += line_of_sight(x0, z0, x1, z1, 0.0f) ? 1 : 0;
+			}
+			t1 = Clock::now();
+			d[String("line_of_sight") + suffix] = ns_per(t0, t1, ray_samples);
+			checksum += los_clear;
+		}
+
+		d["samples"] = samples;
+		d["ray_samples"] = ray_samples;
+		d["checksum"] = checksum;
+		result[layout.name] = d;
+	}
+
+	set_grid_layout(original_shift);
+	return result;
+}
+
+std::vector<std::pair<Vector2, Vector2>> NavigationMap::benchmark_query_pairs(int queries, float clearance) const {
+	// Reachable pairs that need a search (no direct line of sight)
+	std::mt19937 rng(12345);
+	std::uniform_real_distribution<float> ux(min_x, max_x);
+	std::uniform_real_distribution<float> uz(min_z, max_z);
+	std::vector<std::pair<Vector2, Vector2>> pairs;
+	PathSearch probe;
+	for (int attempt = 0; attempt < queries * 50 && static_cast<int>(pairs.size()) < queries; attempt++) {
+		Vector2 a(ux(rng), uz(rng));
+		Vector2 b(ux(rng), uz(rng));
+		if (!is_navigable(a.x, a.y, clearance) || !is_navigable(b.x, b.y, clearance)) continue;
+		if (!is_reachable(a, b, clearance)) continue;
+		if (begin_path_search(probe, a, b, clearance)) continue;
+		pairs.push_back({ a, b });
+	}
+	return pairs;
+}
+
+Dictionary NavigationMap::benchmark_cell_planners(int queries, float clearance) {
+	Dictionary result;
+	if (!built) {
+		UtilityFunctions::push_error("[NavigationMap] benchmark_cell_planners: map is not built");
+		return result;
+	}
+	queries = std::max(1, queries);
+
+	using Clock = std::chrono::steady_clock;
+	clear_jps_tables();
+	auto t_build0 = Clock::now();
+	std::shared_ptr<const JpsTable> table = get_jps_table(clearance);
+	auto t_build1 = Clock::now();
+	if (!table) {
+		UtilityFunctions::push_error("[NavigationMap] benchmark_cell_planners: grid too large for JPS+");
+		return result;
+	}
+
+	std::vector<std::pair<Vector2, Vector2>> pairs = benchmark_query_pairs(queries, table->clearance);
+	PathSearch search;
+
+	const struct { const char *name; int planner; } planners[] = {
+		{ "sdf_jump", PLANNER_SDF_JUMP }, { "jps_plus", PLANNER_JPS_PLUS }
+	};
+	std::vector<float> lengths[2];
+	for (int p = 0; p < 2; p++) {
+		double total_us = 0.0;
+		int64_t expansions = 0;
+		int failures = 0;
+		double length_sum = 0.0;
+		for (const auto &pair : pairs) {
+			auto t0 = Clock::now();
+			PathResult r;
+			if (begin_path_search(search, pair.first, pair.second, clearance, 0.0f, planners[p].planner)) {
+				r = search.result;
+			} else {
+				continue_path_search(search, search.max_iterations);
+				r = finish_path_search(search);
+			}
+			auto t1 = Clock::now();
+			total_us += std::chrono::duration<double, std::micro>(t1 - t0).count();
+			expansions += search.iterations;
+			if (!r.valid) failures++;
+			length_sum += r.total_distance;
+			lengths[p].push_back(r.valid ? r.total_distance : 0.0f);
+		}
+		const double n = std::max<size_t>(pairs.size(), 1);
+		Dictionary d;
+		d["avg_us"] = total_us / n;
+		d["avg_expansions"] = static_cast<double>(expansions) / n;
+		d["avg_length"] = length_sum / n;
+		d["failures"] = failures;
+		result[planners[p].name] = d;
+	}
+
+	// Path quality after LOS simplification: JPS+ length / SDF-jump length
+	float worst_ratio = 1.0f;
+	for (size_t i = 0; i < pairs.size(); i++) {
+		if (lengths[0][i] > 0.0f && lengths[1][i] > 0.0f) {
+			worst_ratio = std::max(worst_ratio, lengths[1][i] / lengths[0][i]);
+		}
+	}
+	result["queries"] = static_cast<int>(pairs.size());
+	result["clearance_bucket"] = table->clearance;
+	result["jps_table_build_ms"] = std::chrono::duration<double, std::milli>(t_build1 - t_build0).count();
+	result["jps_table_mb"] = static_cast<double>(table->dist.size() * sizeof(int16_t)) / (1024.0 * 1024.0);
+	result["worst_length_ratio"] = worst_ratio;
+	UtilityFunctions::print("[NavigationMap] benchmark_cell_planners: ", result);
+	return result;
+}
+
+Dictionary NavigationMap::benchmark_open_lists(int queries, float clearance) {
+	Dictionary result;
+	if (!built) {
+		UtilityFunctions::push_error("[NavigationMap] benchmark_open_lists: map is not built");
+		return result;
+	}
+	std::vector<std::pair<Vector2, Vector2>> pairs = benchmark_query_pairs(std::max(1, queries), clearance);
+
+	const int w = grid_width;
+	const int total = grid_width * grid_height;
+	std::vector<float> g(total);
+	std::vector<uint32_t> open_gen(total, 0);
+	std::vector<uint32_t> closed_gen(total, 0);
+	uint32_t gen = 0;
+
+	// Operation trace of every search, replayed on the bare open lists:
+	// id >= 0 = relax(id, key), id < 0 = pop
+	struct Op { int id; float key; };
+	std::vector<Op> trace;
+
+	// Plain 8-neighbour grid A* (the constrained_cell_astar loop), generic
+	// over the open list: push(id, key), pop() -> (key, id), empty(), clear()
+	auto run = [&](auto &open, bool record, int64_t &pushes, int64_t &pops) -> double {
+		const int dx8[] = {-1, 0, 1, -1, 1, -1, 0, 1};
+		const int dz8[] = {-1, -1, -1, 0, 0, 1, 1, 1};
+		double cost_sum = 0.0;
+		for (const auto &pair : pairs) {
+			float gx0, gz0, gx1, gz1;
+			world_to_grid(pair.first.x, pair.first.y, gx0, gz0);
+			world_to_grid(pair.second.x, pair.second.y, gx1, gz1);
+			int sx = std::max(0, std::min(static_cast<int>(std::round(gx0)), grid_width - 1));
+			int sz = std::max(0, std::min(static_cast<int>(std::round(gz0)), grid_height - 1));
+			int ex = std::max(0, std::min(static_cast<int>(std::round(gx1)), grid_width - 1));
+			int ez = std::max(0, std::min(static_cast<int>(std::round(gz1)), grid_height - 1));
+			if (!find_nearest_navigable(sx, sz, clearance) || !find_nearest_navigable(ex, ez, clearance)) continue;
+
+			gen++;
+			open.clear();
+			const int start = sz * w + sx;
+			const int goal = ez * w + ex;
+			g[start] = 0.0f;
+			open_gen[start] = gen;
+			open.push(start, heuristic(sx, sz, ex, ez));
+			pushes++;
+			if (record) trace.push_back({ start, heuristic(sx, sz, ex, ez) });
+
+			while (!open.empty()) {
+				auto [f, cur] = open.pop();
+				pops++;
+				if (record) trace.push_back({ -1, 0.0f });
+				if (closed_gen[cur] == gen) continue;
+				closed_gen[cur] = gen;
+				if (cur == goal) break;
+
+				const int cx = cur % w;
+				const int cz = cur / w;
+				for (int d = 0; d < 8; d++) {
+					const int nx = cx + dx8[d];
+					const int nz = cz + dz8[d];
+					if (!in_bounds(nx, nz) || get_cell(nx, nz) < clearance) continue;
+					const int nidx = nz * w + nx;
+					if (closed_gen[nidx] == gen) continue;
+					const bool is_diag = (dx8[d] != 0 && dz8[d] != 0);
+					if (is_diag && (get_cell(cx + dx8[d], cz) < clearance || get_cell(cx, cz + dz8[d]) < clearance)) continue;
+					const float ng = g[cur] + (is_diag ? 1.41421356f : 1.0f);
+					if (open_gen[nidx] != gen || ng < g[nidx]) {
+						g[nidx] = ng;
+						open_gen[nidx] = gen;
+						const float key = ng + heuristic(nx, nz, ex, ez);
+						open.push(nidx, key);
+						pushes++;
+						if (record) trace.push_back({ nidx, key });
+					}
+				}
+			}
+			cost_sum += (closed_gen[goal] == gen) ? g[goal] : 0.0f;
+		}
+		return cost_sum;
+	};
+
+	// The std::priority_queue open list the planners used before NavQuadHeap:
+	// a binary heap with lazy deletion (stale entries are popped and skipped)
+	struct BinaryHeap {
+		std::priority_queue<std::pair<float, int>, std::vector<std::pair<float, int>>, std::greater<std::pair<float, int>>> pq;
+		void clear() { pq = decltype(pq)(); }
+		bool empty() const { return pq.empty(); }
+		void push(int id, float key) { pq.push({ key, id }); }
+		std::pair<float, int> pop() {
+			std::pair<float, int> top = pq.top();
+			pq.pop();
+			return top;
+		}
+	};
+
+	using Clock = std::chrono::steady_clock;
+	BinaryHeap binary;
+	NavQuadHeap quad;
+	quad.reserve_ids(total);
+
+	int64_t bin_pushes = 0, bin_pops = 0, quad_pushes = 0, quad_pops = 0;
+	auto t0 = Clock::now();
+	double bin_cost = run(binary, false, bin_pushes, bin_pops);
+	auto t1 = Clock::now();
+	double quad_cost = run(quad, true, quad_pushes, quad_pops);
+	auto t2 = Clock::now();
+
+	// Heap work alone: replay the recorded relax/pop sequence
+	auto t3 = Clock::now();
+	binary.clear();
+	double bin_sum = 0.0;
+	for (const Op &op : trace) {
+		if (op.id >= 0) binary.push(op.id, op.key);
+		else if (!binary.empty()) bin_sum += binary.pop().first;
+	}
+	auto t4 = Clock::now();
+	quad.clear();
+	double quad_sum = 0.0;
+	for (const Op &op : trace) {
+		if (op.id >= 0) quad.push(op.id, op.key);
+		else if (!quad.empty()) quad_sum += quad.pop().first;
+	}
+	auto t5 = Clock::now();
+
+	const double n = static_cast<double>(std::max<size_t>(pairs.size(), 1));
+	auto us = [](Clock::time_point a, Clock::time_point b) {
+		return std::chrono::duration<double, std::micro>(b - a).count();
+	};
+	Dictionary bin;
+	bin["avg_search_us"] = us(t0, t1) / n;
+	bin["avg_pushes"] = static_cast<double>(bin_pushes) / n;
+	bin["avg_pops"] = static_cast<double>(bin_pops) / n;
+	bin["replay_ns_per_op"] = us(t3, t4) * 1000.0 / std::max<size_t>(trace.size(), 1);
+	Dictionary qd;
+	qd["avg_search_us"] = us(t1, t2) / n;
+	qd["avg_pushes"] = static_cast<double>(quad_pushes) / n;
+	qd["avg_pops"] = static_cast<double>(quad_pops) / n;
+	qd["replay_ns_per_op"] = us(t4, t5) * 1000.0 / std::max<size_t>(trace.size(), 1);
+
+	result["binary_heap"] = bin;
+	result["quad_heap"] = qd;
+	result["queries"] = static_cast<int>(pairs.size());
+	result["replay_ops"] = static_cast<int64_t>(trace.size());
+	// Both open lists must find equal-cost paths
+	result["cost_match"] = std::abs(bin_cost - quad_cost) <= 1e-3 * std::max(1.0, bin_cost);
+	result["checksum"] = bin_sum + quad_sum;
+	UtilityFunctions::print("[NavigationMap] benchmark_open_lists: ", result);
+	return result;
+}
+
+// ============================================================================
+// Cache serialization
+// ============================================================================
+
+void NavigationMap::write_cache(NavCacheWriter &w) const {
+	w.write<int32_t>(grid_width);
+	w.write<int32_t>(grid_height);
+	w.write<float>(cell_size);
+	w.write<float>(min_x);
+	w.write<float>(min_z);
+	w.write<float>(max_x);
+	w.write<float>(max_z);
+	w.write<int32_t>(region_count);
+	w.write<int32_t>(grid_tile_shift);
+
+	w.write_vector(sdf_grid);
+	w.write_vector(height_grid);
+	w.write_vector(region_grid);
+	// Active patches are baked in: the cache stores the land as it is now
+	w.write_vector(live_land_mask.empty() ? base_land_mask : live_land_mask);
+	w.write_vector(clearance_node);
+	w.write_vector(ctree_parent);
+	w.write_vector(ctree_value);
+
+	w.write<int32_t>(shore_refinement);
+	w.write<float>(shore_band);
+	w.write<int32_t>(shore_tiles_x);
+	w.write<int32_t>(shore_tiles_z);
+	w.write_vector(shore_tile_index);
+	w.write_vector(shore_tile_data);
+
+	w.write<uint64_t>(islands.size());
+	for (const IslandData &island : islands) {
+		w.write<int32_t>(island.id);
+		w.write<Vector2>(island.center);
+		w.write<float>(island.radius);
+		w.write<float>(island.area);
+		w.write_vector(island.edge_points);
+	}
+}
+
+bool NavigationMap::read_cache(NavCacheReader &r) {
+	std::unique_lock<std::shared_mutex> query_lock(query_mutex_);
+	built = false;
+
+	int32_t w = 0, h = 0, regions = 0, tile_shift = 0;
+	r.read(w);
+	r.read(h);
+	r.read(cell_size);
+	r.read(min_x);
+	r.read(min_z);
+	r.read(max_x);
+	r.read(max_z);
+	r.read(regions);
+	r.read(tile_shift);
+	if (!r.ok || w <= 0 || h <= 0 || cell_size <= 0.0f || tile_shift < 0 || tile_shift > 6) {
+		return false;
+	}
+
+	grid_width = w;
+	grid_height = h;
+	grid_tile_shift = tile_shift;
+	grid_tiles_x = (w + (1 << tile_shift) - 1) >> tile_shift;
+
+	uint64_t total = static_cast<uint64_t>(w) * static_cast<uint64_t>(h);
+	uint64_t stored = grid_storage_size();
+	r.read_vector(sdf_grid, stored);
+	r.read_vector(height_grid, stored);
+	r.read_vector(region_grid, stored);
+	std::vector<uint8_t> land_mask;
+	r.read_vector(land_mask, total);
+	if (!r.ok || sdf_grid.size() != stored || height_grid.size() != stored || region_grid.size() != stored ||
+			land_mask.size() != total) {
+		return false;
+	}
+	r.read_vector(clearance_node, total);
+	r.read_vector(ctree_parent, total);
+	r.read_vector(ctree_value, total);
+	if (!r.ok || clearance_node.size() != total || ctree_value.size() != ctree_parent.size()) {
+		return false;
+	}
+	for (size_t n = 0; n < ctree_parent.size(); n++) {
+		if (ctree_parent[n] >= 0 && (static_cast<size_t>(ctree_parent[n]) <= n ||
+				static_cast<size_t>(ctree_parent[n]) >= ctree_parent.size())) {
+			return false;
+		}
+	}
+	for (int32_t node : clearance_node) {
+		if (node >= static_cast<int64_t>(ctree_parent.size())) return false;
+	}
+	link_clearance_tree();
+
+	int32_t refinement = 1, tiles_x = 0, tiles_z = 0;
+	r.read(refinement);
+	r.read(shore_band);
+	r.read(tiles_x);
+	r.read(tiles_z);
+	if (!r.ok || refinement < 1 || tiles_x < 0 || tiles_z < 0) {
+		return false;
+	}
+	uint64_t tile_count = static_cast<uint64_t>(tiles_x) * static_cast<uint64_t>(tiles_z);
+	uint64_t tile_samples = static_cast<uint64_t>(SHORE_TILE_CELLS * refinement + 1) * (SHORE_TILE_CELLS * refinement + 1);
+	r.read_vector(shore_tile_index, tile_count);
+	r.read_vector(shore_tile_data, tile_count * tile_samples);
+	if (!r.ok || shore_tile_index.size() != tile_count || shore_tile_data.size() % tile_samples != 0) {
+		return false;
+	}
+	uint64_t slots = shore_tile_data.size() / tile_samples;
+	for (int32_t slot : shore_tile_index) {
+		if (slot >= static_cast<int64_t>(slots)) return false;
+	}
+	shore_refinement = refinement;
+	shore_tiles_x = tiles_x;
+	shore_tiles_z = tiles_z;
+
+	uint64_t island_count = 0;
+	if (!r.read(island_count) || island_count > total) {
+		return false;
+	}
+	islands.assign(static_cast<size_t>(island_count), IslandData());
+	for (IslandData &island : islands) {
+		int32_t id = -1;
+		r.read(id);
+		r.read(island.center);
+		r.read(island.radius);
+		r.read(island.area);
+		r.read_vector(island.edge_points, total);
+		island.id = id;
+	}
+	if (!r.ok) {
+		islands.clear();
+		return false;
+	}
+
+	region_count = regions;
+	allocate_astar_buffers();
+	finish_land_build(std::move(land_mask));
+	built = true;
+	return true;
+}
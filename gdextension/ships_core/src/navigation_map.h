@@ -12,23 +12,70 @@
 #include <godot_cpp/variant/typed_array.hpp>
 #include <godot_cpp/variant/packed_float32_array.hpp>
 #include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/rect2.hpp>
 
+#include <cstdint>
 #include <vector>
 #include <queue>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 #include <cmath>
 #include <algorithm>
 #include <limits>
 
 #include "nav_types.h"
+#include "nav_cache_io.h"
 
 namespace godot {
 
 class NavigationMap : public RefCounted {
 	GDCLASS(NavigationMap, RefCounted)
 
+public:
+	// Shoreline refinement defaults (see set_shore_refinement)
+	static constexpr int SHORE_TILE_CELLS = 8;
+	static constexpr int DEFAULT_SHORE_REFINEMENT = 4;
+	static constexpr float DEFAULT_SHORE_BAND = 400.0f;
+	// Upper bound on the temporary fine raster; the refinement factor is
+	// lowered until the fine grid fits.
+	static constexpr int64_t MAX_SHORE_RASTER_CELLS = 16 * 1024 * 1024;
+
+	// Grid tiles are 8x8 cells (one 256-byte block of floats)
+	static constexpr int DEFAULT_GRID_TILE_SHIFT = 3;
+
+	// build_from_raycast_scan casts rays every RAYCAST_COARSE_STRIDE cells
+	// first and only fills in the blocks next to a coastline
+	static constexpr int RAYCAST_COARSE_STRIDE = 4;
+
+	// apply_land_patch mask values
+	static constexpr uint8_t PATCH_KEEP = 0;   // leave the cell as it is
+	static constexpr uint8_t PATCH_LAND = 1;   // obstacle / new land
+	static constexpr uint8_t PATCH_WATER = 2;  // carve land away
+
+	// Land changes remembered for get_changed_cells_since
+	static constexpr int MAX_NAV_CHANGES = 64;
+
+	// Clearance tree merge levels are quantized to cell_size / CLEARANCE_TREE_STEPS
+	static constexpr int CLEARANCE_TREE_STEPS = 16;
+
+	// Cell planners (find_path / begin_path_search), see CellPlanner
+	static constexpr int PLANNER_SDF_JUMP = CELL_PLANNER_SDF_JUMP;
+	static constexpr int PLANNER_JPS_PLUS = CELL_PLANNER_JPS_PLUS;
+
+	// JPS+ tables are built per clearance rounded up to cell_size /
+	// JPS_CLEARANCE_STEPS; the JPS_MAX_TABLES most recently used are kept
+	// (8 x int16 per cell each)
+	static constexpr int JPS_CLEARANCE_STEPS = 8;
+	static constexpr int JPS_MAX_TABLES = 4;
+
 private:
 	// --- SDF Grid ---
+	// sdf_grid, height_grid and region_grid share one memory layout (see
+	// cell_index); never index them as iz * grid_width + ix.
 	std::vector<float> sdf_grid;  // Signed distance values; positive = water, negative = land
 	std::vector<float> height_grid;  // Max terrain height per cell; 0.0f = water
 	int grid_width;
@@ -40,12 +87,97 @@ private:
 	// --- Region connectivity (computed at build time) ---
 	// Each navigable cell gets a region ID; cells in the same connected water region share an ID.
 	// Non-navigable cells get -1. Used for O(1) reachability checks before pathfinding.
-	std::vector<int> region_grid;  // size = grid_width * grid_height, -1 = non-navigable
+	std::vector<int> region_grid;  // one entry per cell (cell_index layout), -1 = non-navigable
 	int region_count;
 
+	// --- Clearance connectivity (bottleneck tree, computed at build time) ---
+	// Water cells are added in descending SDF order and 8-connected
+	// components merged as they meet.  Every merge of two or more components
+	// is a tree node whose value is the SDF at which they joined (rounded up
+	// to CLEARANCE_TREE_STEPS per cell, so the test never rejects a reachable
+	// pair).  Two cells are connected for a ship needing clearance c iff their
+	// highest ancestors with value >= c coincide.
+	std::vector<int32_t> clearance_node;   // per cell (row-major): node current when the cell joined, -1 = land
+	std::vector<int32_t> ctree_parent;     // -1 = root; parents always have higher indices
+	std::vector<float> ctree_value;        // non-increasing toward the root
+	std::vector<int32_t> ctree_jump;       // skew-binary jump pointer (O(log depth) climbs)
+	std::vector<int32_t> ctree_depth;
+
+	// --- Grid memory layout ---
+	// Cells are stored in (1 << grid_tile_shift)-wide square tiles, tiles in
+	// row-major order and cells row-major inside a tile, so bilinear taps and
+	// raymarch/LOS walks stay within one or two cache lines.  Shift 0 is
+	// plain row-major.  Storage is padded to whole tiles.
+	int grid_tile_shift;
+	int grid_tiles_x;  // tiles per row
+
+	static inline int layout_index(int ix, int iz, int tile_shift, int tiles_x) {
+		const int mask = (1 << tile_shift) - 1;
+		return ((((iz >> tile_shift) * tiles_x + (ix >> tile_shift)) << (2 * tile_shift)) |
+				((iz & mask) << tile_shift) | (ix & mask));
+	}
+
+	inline int cell_index(int ix, int iz) const {
+		return layout_index(ix, iz, grid_tile_shift, grid_tiles_x);
+	}
+
+	// Number of stored cells for the current layout (>= grid_width * grid_height)
+	size_t grid_storage_size() const;
+
+	// Re-store sdf_grid, height_grid and region_grid with a new tile shift
+	void set_grid_layout(int tile_shift);
+
+	// --- Shoreline refinement tiles (multi-resolution SDF) ---
+	// sdf_grid covers the whole map at cell_size.  Coarse tiles of
+	// SHORE_TILE_CELLS x SHORE_TILE_CELLS cells that come within shore_band
+	// of a coastline additionally store the SDF at cell_size / shore_refinement
+	// ((SHORE_TILE_CELLS * R + 1)^2 samples, corners shared with neighbours).
+	// sample_bilinear prefers a fine tile when one exists; open ocean stays coarse.
+	// Grid-cell queries (A*, LOS, regions) keep using the coarse grid.
+	int shore_refinement;                  // fine samples per coarse cell (1 = off)
+	float shore_band;                      // metres from the coast that get fine tiles
+	int shore_tiles_x;
+	int shore_tiles_z;
+	std::vector<int32_t> shore_tile_index; // per coarse tile: slot in shore_tile_data, -1 = coarse only
+	std::vector<float> shore_tile_data;
+	// Land patches switch tiles they change to the coarse SDF.  The data
+	// stays in shore_tile_data; the built index and each slot's coarse cells
+	// ((SHORE_TILE_CELLS + 3)^2, taken by begin_land_patches) let a tile
+	// whose cells are back at their built SDF return to its fine samples.
+	std::vector<int32_t> shore_tile_base_index;
+	std::vector<float> shore_tile_base_sdf;
+
+	int scan_thread_count;                 // raycast scan workers (0 = serial)
+
 	// --- Island data ---
 	std::vector<IslandData> islands;
 
+	// --- Runtime land patches (apply_land_patch) ---
+	// base_land_mask is the land mask the map was built with; live_land_mask
+	// is that mask with every active patch applied in id order (empty until
+	// the first patch).  Both are row-major.  island_grid labels each land
+	// cell with its index in islands (-1 = water or a too-small island); it
+	// is filled on the first patch.
+	struct LandPatch {
+		int x0, z0, x1, z1;          // inclusive cell rect
+		std::vector<uint8_t> cells;  // PATCH_* per cell, row-major over the rect
+	};
+
+	struct NavChange {
+		uint64_t version;
+		int x0, z0, x1, z1;          // inclusive rect of cells whose SDF changed
+	};
+
+	std::vector<uint8_t> base_land_mask;
+	std::vector<uint8_t> live_land_mask;
+	std::vector<int32_t> island_grid;
+	std::map<int, LandPatch> land_patches;
+	int next_patch_id;
+
+	uint64_t nav_version;                 // bumped on every build and land change
+	uint64_t nav_changes_floor;           // oldest version nav_changes can describe
+	std::vector<NavChange> nav_changes;   // last MAX_NAV_CHANGES land changes
+
 	// --- Reusable A* buffers (mutable for use in const pathfinding methods) ---
 	mutable std::vector<float> astar_g_cost_;
 	mutable std::vector<int> astar_parent_;        // cell index for path reconstruction
@@ -57,6 +189,15 @@ private:
 	// Pre-allocated search state for synchronous find_path_internal calls
 	mutable PathSearch sync_search_;
 
+	// Held shared by queries that can run off the main thread (HpaGraph
+	// searches on PathPlanner workers), exclusively while a build, cache
+	// load or land patch rewrites the grids they read.
+	mutable std::shared_mutex query_mutex_;
+
+	// JPS+ jump tables, most recently used last (see get_jps_table)
+	mutable std::mutex jps_mutex_;
+	mutable std::vector<std::shared_ptr<const JpsTable>> jps_tables_;
+
 	// Precomputed turn angle (radians) between each pair of 8-connected directions
 	float turn_angle_lut_[8][8];
 
@@ -107,48 +248,116 @@ private:
 	// Get raw SDF value at a grid cell (no interpolation)
 	inline float get_cell(int ix, int iz) const {
 		if (!in_bounds(ix, iz)) return 0.0f;  // Out of bounds = wall
-		return sdf_grid[iz * grid_width + ix];
+		return sdf_grid[cell_index(ix, iz)];
 	}
 
 	// Set raw SDF value at a grid cell
 	inline void set_cell(int ix, int iz, float value) {
 		if (in_bounds(ix, iz)) {
-			sdf_grid[iz * grid_width + ix] = value;
+			sdf_grid[cell_index(ix, iz)] = value;
 		}
 	}
 
 	// Bilinear interpolation of SDF at fractional grid coordinates
+	// (from the fine shoreline tile when the point lies in one)
 	float sample_bilinear(float gx, float gz) const;
+
+	// Samples per side of a fine shoreline tile
+	inline int shore_tile_stride() const { return SHORE_TILE_CELLS * shore_refinement + 1; }
+
+	// Central-difference step for get_gradient at a world position
+	// (half a cell, of the fine tile near a coastline)
+	float gradient_step(float x, float z) const;
+
+	// Fine shoreline tile covering coarse grid coords (gx, gz), or nullptr.
+	// On success (lx, lz) are the coordinates inside the tile in fine cells.
+	const float *find_shore_tile(float gx, float gz, float &lx, float &lz) const;
 	float sample_height_bilinear(float gx, float gz) const;
 
 	// --- SDF construction internals ---
 
 	// Rasterize a triangle onto the binary land/water grid
 	void rasterize_triangle(const Vector3 &v0, const Vector3 &v1, const Vector3 &v2,
-							std::vector<bool> &land_mask, std::vector<float> &height_grid);
+							std::vector<uint8_t> &land_mask, std::vector<float> &height_grid);
 
 	// Rasterize a box shape onto the land mask
 	void rasterize_box(const Vector3 &center, const Vector3 &half_extents,
-					   const Transform3D &transform, std::vector<bool> &land_mask, std::vector<float> &height_grid);
+					   const Transform3D &transform, std::vector<uint8_t> &land_mask, std::vector<float> &height_grid);
 
 	// Rasterize a sphere shape onto the land mask
 	void rasterize_sphere(const Vector3 &center, float radius,
-						  const Transform3D &transform, std::vector<bool> &land_mask, std::vector<float> &height_grid);
+						  const Transform3D &transform, std::vector<uint8_t> &land_mask, std::vector<float> &height_grid);
 
 	// Rasterize a cylinder shape onto the land mask
 	void rasterize_cylinder(const Vector3 &center, float radius, float height,
-							const Transform3D &transform, std::vector<bool> &land_mask, std::vector<float> &height_grid);
+							const Transform3D &transform, std::vector<uint8_t> &land_mask, std::vector<float> &height_grid);
+
+	// Compute exact signed distances from a byte land mask (separable
+	// Felzenszwalb–Huttenlocher EDT, rows and columns in parallel)
+	void compute_sdf_from_mask(const std::vector<uint8_t> &land_mask);
 
-	// Compute exact signed distances from a binary land mask using jump flood algorithm
-	void compute_sdf_from_mask(const std::vector<bool> &land_mask);
+	// Reduce a land mask / height grid rasterized at cell_size / factor on a
+	// (w - 1) * factor + 1 grid to the coarse grid.  A coarse cell is land if
+	// any fine sample within half a coarse cell is (keeps rasterization
+	// conservative); its height is the max of those samples.
+	void downsample_land_mask(int factor, int fine_w, int fine_h,
+							  std::vector<uint8_t> &land_mask, std::vector<float> &height_grid) const;
+
+	// Keep the fine SDF for every coarse tile within shore_band of the coast
+	void build_shore_tiles(const std::vector<float> &fine_sdf, int fine_w, int fine_h);
 
 	// Extract islands from the land mask via flood fill
-	void extract_islands(const std::vector<bool> &land_mask);
+	void extract_islands(const std::vector<uint8_t> &land_mask);
+
+	// Flood the 8-connected land component at (ix, iz), marking visited
+	// cells, and fill island metadata from it.  Returns false for noise
+	// islands (fewer than 4 cells); cells receives the component either way.
+	bool collect_island(const std::vector<uint8_t> &land_mask, int ix, int iz,
+						std::vector<uint8_t> &visited, std::vector<int> &cells,
+						IslandData &island) const;
+
+	// Record the land mask a build produced and start a new map version
+	void finish_land_build(std::vector<uint8_t> &&land_mask);
+
+	// Before the first patch: copy the built mask to live_land_mask,
+	// snapshot the shoreline tiles and re-extract the islands, labelling
+	// island_grid
+	void begin_land_patches();
+
+	// Inclusive cells a shoreline tile's samples span, plus the one-cell
+	// ring update_land_rect treats as affecting it
+	void shore_tile_cells(int tx, int tz, int &x0, int &z0, int &x1, int &z1) const;
+
+	// True when every cell of shore_tile_cells still has the SDF
+	// begin_land_patches recorded for the tile's slot
+	bool shore_tile_at_base(int tx, int tz, int slot) const;
+
+	// Write patch cells into live_land_mask over the patch rect, replaying
+	// base_land_mask and every patch in id order.  Grows the inclusive
+	// rect (cx0, cz0, cx1, cz1) to cover cells whose land state changed.
+	void replay_land_patches(int x0, int z0, int x1, int z1,
+							 int &cx0, int &cz0, int &cx1, int &cz1);
+
+	// Incrementally bring the SDF, regions, islands and shoreline tiles in
+	// line with live_land_mask after the cells in the inclusive rect changed
+	void update_land_rect(int x0, int z0, int x1, int z1);
 
 	// Compute connected regions of navigable water cells for O(1) reachability checks.
 	// Must be called after compute_sdf_from_mask. Uses a minimum clearance of 0 (any water cell).
 	void compute_regions();
 
+	// Build the clearance bottleneck tree from sdf_grid.  Must be called after
+	// compute_sdf_from_mask; linear in the cell count (bucketed by SDF).
+	// Returns the number of water cells in the tree.
+	int compute_clearance_tree();
+
+	// Fill ctree_jump / ctree_depth from ctree_parent
+	void link_clearance_tree();
+
+	// Highest tree node above the row-major cell whose value is >= clearance,
+	// or -1 when the cell itself has less clearance
+	int clearance_component(int cell, float clearance) const;
+
 	// --- SDF jump helpers for accelerated A* pathfinding ---
 	// The SDF at any cell gives the exact distance to nearest obstacle.
 	// By the triangle inequality, if sdf(A) = d, then every point within
@@ -205,17 +414,42 @@ private:
 		return std::sqrt(dx * dx + dz * dz);
 	}
 
+	// Octile distance in grid cells (JPS+ heuristic; exact on an open grid)
+	static inline float octile(int x0, int z0, int x1, int z1) {
+		int dx = std::abs(x1 - x0);
+		int dz = std::abs(z1 - z0);
+		return static_cast<float>(std::max(dx, dz) - std::min(dx, dz)) + 1.414f * static_cast<float>(std::min(dx, dz));
+	}
+
 	// Find the nearest navigable cell to the given grid position
 	bool find_nearest_navigable(int &ix, int &iz, float clearance) const;
 
+	// --- JPS+ ---
+
+	// Jump table for `clearance` (rounded up to a bucket), built on first use.
+	// Thread-safe.  Returns null when the grid is too large for int16 distances.
+	std::shared_ptr<const JpsTable> get_jps_table(float clearance) const;
+	std::shared_ptr<JpsTable> build_jps_table(float clearance) const;
+
+	// Drop all cached tables (SDF changed)
+	void clear_jps_tables();
+
+	// JPS+ counterpart of the continue_path_search loop
+	bool continue_jps_search(PathSearch &search, int max_iterations) const;
+
 	// Check if two grid cells are in the same navigable region (O(1) reachability test)
 	inline bool same_region(int x0, int z0, int x1, int z1) const {
 		if (!in_bounds(x0, z0) || !in_bounds(x1, z1)) return false;
-		int r0 = region_grid[z0 * grid_width + x0];
-		int r1 = region_grid[z1 * grid_width + x1];
+		int r0 = region_grid[cell_index(x0, z0)];
+		int r1 = region_grid[cell_index(x1, z1)];
 		return r0 >= 0 && r0 == r1;
 	}
 
+	// Check if two grid cells are connected through water with at least
+	// `clearance` SDF everywhere (8-connected).  False when either cell has
+	// less clearance itself.  Clearance <= 0 falls back to same_region.
+	bool same_region_at(int x0, int z0, int x1, int z1, float clearance) const;
+
 protected:
 	static void _bind_methods();
 
@@ -231,14 +465,30 @@ public:
 	// Set the cell size in world units (default 50.0)
 	void set_cell_size(float p_cell_size);
 
+	// Store the SDF at cell_size / factor within band_m metres of every
+	// coastline (build_from_collision_shapes only; factor 1 disables)
+	void set_shore_refinement(int factor, float band_m);
+	int get_shore_refinement() const;
+
+	// Number of coarse tiles that carry a fine shoreline SDF
+	int get_shore_tile_count() const;
+
 	// Build SDF from collision shapes of island StaticBody3D nodes
 	// island_bodies: Array of Node3D (StaticBody3D) with CollisionShape3D children
 	void build_from_collision_shapes(TypedArray<Node3D> island_bodies);
 
+	// Worker threads for build_from_raycast_scan.  0 or 1 = serial (default).
+	// Only raise it for a physics backend whose direct space state allows
+	// concurrent ray queries; GodotPhysics does not.
+	void set_scan_thread_count(int count);
+
 	// Build SDF by casting downward rays through the physics engine.
-	// Simpler than collision-shape parsing: for each grid cell, cast a ray straight
-	// down from just above the tallest island AABB. If the ray hits geometry and the
-	// hit point's Y coordinate is above the waterline (Y > 0), the cell is land.
+	// Simpler than collision-shape parsing: cast rays straight down from just
+	// above the tallest island AABB. If the ray hits geometry and the hit
+	// point's Y coordinate is above the waterline (Y > 0), the cell is land.
+	// Rays go out on a RAYCAST_COARSE_STRIDE lattice first; only blocks whose
+	// lattice neighbourhood mixes land and water (or that overlap an island
+	// shape) get one ray per cell.
 	// space_state: PhysicsDirectSpaceState3D obtained from get_world_3d().direct_space_state
 	// island_bodies: Array of Node3D whose AABBs determine the ray origin height
 	// collision_mask: physics collision mask for the ray (default 1 = terrain layer)
@@ -255,9 +505,30 @@ public:
 	// Get gradient of the SDF at world position (points away from nearest land)
 	Vector2 get_gradient(float x, float z) const;
 
+	// Batched get_distance / get_gradient over n XZ points (same results as
+	// the single-point calls).  For arc and edge checks: one call per arc
+	// instead of one cross-object call per sample.
+	void sample_distances(const Vector2 *pts, int n, float *out) const;
+	void sample_gradients(const Vector2 *pts, int n, Vector2 *out) const;
+
+	// GDScript wrappers for the batched queries
+	PackedFloat32Array get_distances(const PackedVector2Array &points) const;
+	PackedVector2Array get_gradients(const PackedVector2Array &points) const;
+
 	// Check if a circle of given radius can navigate at this position
 	bool is_navigable(float x, float z, float clearance) const;
 
+	// Check whether a ship needing `clearance` can get from one position to
+	// the other at all (both snapped to the nearest navigable cell, as
+	// find_path does).  O(log depth) via the clearance tree; no search.
+	bool is_reachable(Vector2 from, Vector2 to, float clearance) const;
+
+	// Grid-cell form for planners that do not snap their endpoints: false
+	// only when both cells have `clearance` and the clearance tree proves no
+	// route between them.  A cell below clearance (ship pressed against a
+	// coast) is not judged, so this never rejects a query A* could solve.
+	bool can_reach(int x0, int z0, int x1, int z1, float clearance) const;
+
 	// --- Raycasting ---
 
 	// March along a line segment testing clearance at each step
@@ -274,12 +545,13 @@ public:
 	// When turning_radius > 0, applies curvature-aware cost function that
 	// penalizes sharp turns and proximity to land relative to the ship's
 	// turning circle, producing paths the ship can actually follow.
+	// `planner` picks the cell search (PLANNER_SDF_JUMP or PLANNER_JPS_PLUS).
 	PackedVector2Array find_path(Vector2 from, Vector2 to, float clearance,
-								float turning_radius = 0.0f) const;
+								float turning_radius = 0.0f, int planner = PLANNER_SDF_JUMP) const;
 
 	// Internal pathfinding returning PathResult struct (MR-accelerated 8-direction A*)
 	PathResult find_path_internal(Vector2 from, Vector2 to, float clearance,
-								  float turning_radius = 0.0f) const;
+								  float turning_radius = 0.0f, int planner = PLANNER_SDF_JUMP) const;
 
 	// Line-of-sight check on the SDF grid with clearance (Bresenham supercover).
 	// Grid coordinates; used internally and by HpaGraph for path simplification.
@@ -291,9 +563,11 @@ public:
 	// checks reachability and LOS. Returns true if path found immediately
 	// (direct LOS or trivial), in which case search.result is populated.
 	// Otherwise sets search.active = true and the caller should call
-	// continue_path_search() each frame.
+	// continue_path_search() each frame.  PLANNER_JPS_PLUS falls back to the
+	// SDF-jump A* when the endpoints sit below the table's clearance bucket.
 	bool begin_path_search(PathSearch &search, Vector2 from, Vector2 to,
-						   float clearance, float turning_radius = 0.0f) const;
+						   float clearance, float turning_radius = 0.0f,
+						   int planner = PLANNER_SDF_JUMP) const;
 
 	// Run up to max_iterations of the A* loop. Returns true when the search
 	// is complete (path found or exhausted). Call finish_path_search() to
@@ -435,6 +709,66 @@ public:
 
 	// Get the number of detected islands
 	int get_island_count() const;
+
+	// --- Runtime land changes (obstacles, destructible terrain) ---
+
+	// Stamp a patch over the world XZ rect and update the SDF, regions and
+	// islands around it.  mask is mask_width x (size / mask_width) PATCH_*
+	// values stretched over the rect; an empty mask makes the whole rect
+	// land.  Heights are not changed.  Returns the patch id, or -1.
+	int apply_land_patch(Rect2 rect, const PackedByteArray &mask = PackedByteArray(), int mask_width = 0);
+
+	// Undo a patch (later patches over the same cells stay applied)
+	bool remove_land_patch(int patch_id);
+
+	// Remove every patch and restore the built land mask
+	void clear_land_patches();
+
+	int get_land_patch_count() const { return static_cast<int>(land_patches.size()); }
+
+	// Lock a query that may run on another thread holds shared while it
+	// reads the grids; builds and land patches hold it exclusively.
+	std::shared_mutex &get_query_mutex() const { return query_mutex_; }
+
+	// Bumped on every build and land patch change.  Consumers (HpaGraph,
+	// ShipNavigator) remember the version they last synced to.
+	int64_t get_version() const { return static_cast<int64_t>(nav_version); }
+
+	// Inclusive cell rect covering every SDF change after 'version' (empty,
+	// x0 > x1, when there is none).  Returns false when the history does not
+	// reach back that far (e.g. across a rebuild); refresh everything then.
+	bool get_changed_cells_since(uint64_t version, int &x0, int &z0, int &x1, int &z1) const;
+
+	// Time get_distance, raycast_internal and line_of_sight on random and
+	// coherent (short-step walk) queries for the row-major and tiled grid
+	// layouts.  The map's layout is restored afterwards.
+	// Returns { row_major: {...}, tiled_8x8: {...} } with ns per query.
+	Dictionary benchmark_grid_layouts(int samples = 100000);
+
+	// Run the same random reachable queries through the SDF-jump A* and
+	// JPS+ at `clearance`.  Returns { sdf_jump: {...}, jps_plus: {...} } with
+	// average wall time, expansions and simplified path length per query,
+	// plus the JPS+ table build time and the worst length ratio.
+	Dictionary benchmark_cell_planners(int queries = 200, float clearance = 150.0f);
+
+	// Run the same grid A* queries with the old binary-heap open list
+	// (std::priority_queue, lazy deletion) and NavQuadHeap, then replay the
+	// recorded push/pop sequence on each heap alone.  Returns per-heap
+	// average search time, pushes, pops and ns per heap operation.
+	Dictionary benchmark_open_lists(int queries = 200, float clearance = 150.0f);
+
+	// Random reachable query pairs at `clearance` that need a search
+	std::vector<std::pair<Vector2, Vector2>> benchmark_query_pairs(int queries, float clearance) const;
+
+	// --- Cache serialization (C++ only, used by NavigationCache) ---
+
+	// Append bounds, grid layout, SDF, height and region grids, land mask,
+	// shoreline tiles and islands to the writer
+	void write_cache(NavCacheWriter &w) const;
+
+	// Restore a map written by write_cache. Returns false (map left unbuilt)
+	// if the data is truncated or inconsistent.
+	bool read_cache(NavCacheReader &r);
 };
 
 } // namespace godot
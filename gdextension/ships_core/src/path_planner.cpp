@@ -0,0 +1,268 @@
+#include "path_planner.h"
+
+#include "ship_navigator.h"
+
+#include <godot_cpp/core/object.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+namespace godot {
+
+// ============================================================================
+// _bind_methods
+// ============================================================================
+
+void PathPlanner::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_hpa_graph", "graph"), &PathPlanner::set_hpa_graph);
+	ClassDB::bind_method(D_METHOD("get_hpa_graph"), &PathPlanner::get_hpa_graph);
+	ClassDB::bind_method(D_METHOD("set_thread_count", "count"), &PathPlanner::set_thread_count);
+	ClassDB::bind_method(D_METHOD("get_thread_count"), &PathPlanner::get_thread_count);
+	ClassDB::bind_method(D_METHOD("set_latency_frames", "frames"), &PathPlanner::set_latency_frames);
+	ClassDB::bind_method(D_METHOD("get_latency_frames"), &PathPlanner::get_latency_frames);
+	ClassDB::bind_method(D_METHOD("start"), &PathPlanner::start);
+	ClassDB::bind_method(D_METHOD("stop"), &PathPlanner::stop);
+	ClassDB::bind_method(D_METHOD("is_running"), &PathPlanner::is_running);
+	ClassDB::bind_method(D_METHOD("dispatch"), &PathPlanner::dispatch);
+	ClassDB::bind_method(D_METHOD("drain"), &PathPlanner::drain);
+	ClassDB::bind_method(D_METHOD("get_stats"), &PathPlanner::get_stats);
+}
+
+PathPlanner::PathPlanner() = default;
+
+PathPlanner::~PathPlanner() {
+	stop();
+}
+
+// ============================================================================
+// Setup
+// ============================================================================
+
+void PathPlanner::set_hpa_graph(Ref<HpaGraph> graph) {
+	bool was_running = is_running();
+	stop();
+	hpa_graph_ = graph;
+	if (was_running) start();
+}
+
+void PathPlanner::set_thread_count(int count) {
+	thread_count_ = std::max(0, count);
+}
+
+void PathPlanner::set_latency_frames(int frames) {
+	latency_frames_ = std::max(0, frames);
+}
+
+void PathPlanner::start() {
+	if (is_running()) return;
+	if (!hpa_graph_.is_valid()) {
+		UtilityFunctions::push_warning("[PathPlanner] start: no HpaGraph set");
+		return;
+	}
+
+	int count = thread_count_;
+	if (count <= 0) {
+		count = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopping_ = false;
+	}
+	workers_.reserve(count);
+	for (int i = 0; i < count; i++) {
+		workers_.emplace_back([this]() { worker_loop(); });
+	}
+	UtilityFunctions::print("[PathPlanner] started ", count, " workers");
+}
+
+// Queued jobs stay queued; dispatch() runs them inline until start() again.
+void PathPlanner::stop() {
+	if (!is_running()) return;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopping_ = true;
+	}
+	work_cv_.notify_all();
+	for (std::thread &t : workers_) {
+		t.join();
+	}
+	workers_.clear();
+}
+
+// ============================================================================
+// Submission
+// ============================================================================
+
+uint64_t PathPlanner::submit(ObjectID navigator, Request request) {
+	auto job = std::make_shared<Job>();
+	job->navigator = static_cast<uint64_t>(navigator);
+	job->request = std::move(request);
+	if (hpa_graph_.is_valid()) {
+		job->obstacles = hpa_graph_->snapshot_obstacles();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		job->ticket = next_ticket_++;
+		job->frame = frame_;
+
+		auto it = latest_.find(job->navigator);
+		if (it != latest_.end()) {
+			it->second->cancelled = true;
+			stat_superseded_++;
+			it->second = job;
+		} else {
+			latest_.emplace(job->navigator, job);
+		}
+		jobs_.push_back(job);
+		queue_.push_back(job);
+		stat_submitted_++;
+	}
+	work_cv_.notify_one();
+	return job->ticket;
+}
+
+void PathPlanner::cancel(ObjectID navigator) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto it = latest_.find(static_cast<uint64_t>(navigator));
+	if (it == latest_.end()) return;
+	it->second->cancelled = true;
+	latest_.erase(it);
+}
+
+// ============================================================================
+// Workers
+// ============================================================================
+
+void PathPlanner::worker_loop() {
+	while (true) {
+		std::shared_ptr<Job> job;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			work_cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+			if (stopping_) return;
+			job = queue_.front();
+			queue_.pop_front();
+			if (job->cancelled) {
+				job->state = JOB_DONE;
+				done_cv_.notify_all();
+				continue;
+			}
+			job->state = JOB_RUNNING;
+			running_++;
+		}
+
+		run_job(*job);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			job->state = JOB_DONE;
+			running_--;
+		}
+		done_cv_.notify_all();
+	}
+}
+
+void PathPlanner::run_job(Job &job) const {
+	auto t0 = std::chrono::steady_clock::now();
+	const Request &req = job.request;
+
+	std::shared_ptr<const HpaThreatSet> threats = hpa_graph_->get_threat_set(
+			req.threat_team_id, req.threat_radius_bin, req.threat_version, req.threats);
+	HpaBlockView view;
+	view.obstacles = job.obstacles.get();
+	view.threats = threats.get();
+	view.speed = req.speed;
+	job.result = hpa_graph_->find_path(req.from, req.to, req.clearance, view);
+
+	job.plan_us = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// ============================================================================
+// dispatch / drain
+// ============================================================================
+
+int PathPlanner::dispatch() {
+	auto t0 = std::chrono::steady_clock::now();
+	std::vector<std::shared_ptr<Job>> due;
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		frame_++;
+		while (!jobs_.empty() && jobs_.front()->frame + static_cast<uint64_t>(latency_frames_) < frame_) {
+			std::shared_ptr<Job> job = jobs_.front();
+			jobs_.pop_front();
+			if (job->state == JOB_QUEUED && (job->cancelled || workers_.empty())) {
+				auto qit = std::find(queue_.begin(), queue_.end(), job);
+				if (qit != queue_.end()) queue_.erase(qit);
+			}
+			if (job->cancelled) continue;
+
+			if (job->state == JOB_QUEUED) {
+				// No workers — plan it here
+				job->state = JOB_RUNNING;
+				lock.unlock();
+				run_job(*job);
+				lock.lock();
+				job->state = JOB_DONE;
+			}
+			done_cv_.wait(lock, [&job]() { return job->state == JOB_DONE; });
+			if (job->cancelled) continue;  // superseded while we waited
+
+			auto lit = latest_.find(job->navigator);
+			if (lit != latest_.end() && lit->second == job) latest_.erase(lit);
+
+			stat_avg_plan_us_ = (stat_applied_ == 0) ? job->plan_us
+					: stat_avg_plan_us_ * 0.95f + job->plan_us * 0.05f;
+			stat_max_plan_us_ = std::max(stat_max_plan_us_, job->plan_us);
+			stat_applied_++;
+			due.push_back(std::move(job));
+		}
+		stat_last_dispatch_wait_us_ =
+			std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - t0).count();
+	}
+
+	// Outside the lock: applying a path may submit a new request
+	for (const std::shared_ptr<Job> &job : due) {
+		ShipNavigator *nav = Object::cast_to<ShipNavigator>(ObjectDB::get_instance(job->navigator));
+		if (nav) {
+			nav->apply_planned_path(job->result, job->request.clearance, job->request.threat_version);
+		}
+	}
+	return static_cast<int>(due.size());
+}
+
+void PathPlanner::drain() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	if (workers_.empty()) return;
+	done_cv_.wait(lock, [this]() {
+		if (running_ > 0) return false;
+		for (const std::shared_ptr<Job> &job : queue_) {
+			if (!job->cancelled) return false;
+		}
+		return true;
+	});
+}
+
+// ============================================================================
+// get_stats
+// ============================================================================
+
+Dictionary PathPlanner::get_stats() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	Dictionary d;
+	d["workers"] = static_cast<int64_t>(workers_.size());
+	d["latency_frames"] = latency_frames_;
+	d["submitted"] = static_cast<int64_t>(stat_submitted_);
+	d["applied"] = static_cast<int64_t>(stat_applied_);
+	d["superseded"] = static_cast<int64_t>(stat_superseded_);
+	d["pending"] = static_cast<int64_t>(jobs_.size());
+	d["queued"] = static_cast<int64_t>(queue_.size());
+	d["running"] = running_;
+	d["avg_plan_us"] = stat_avg_plan_us_;
+	d["max_plan_us"] = stat_max_plan_us_;
+	d["last_dispatch_wait_us"] = stat_last_dispatch_wait_us_;
+	return d;
+}
+
+} // namespace godot
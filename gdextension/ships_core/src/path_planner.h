@@ -0,0 +1,158 @@
+#ifndef PATH_PLANNER_H
+#define PATH_PLANNER_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/object_id.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "hpa_graph.h"
+#include "nav_types.h"
+
+namespace godot {
+
+class ShipNavigator;
+
+// ---------------------------------------------------------------------------
+// PathPlanner — runs ShipNavigator HPA* queries on worker threads.
+//
+// A navigator submits (from, to, clearance, speed, threat bin + version) and
+// keeps following its current path.  The request carries copies of the
+// threat circles and of the HpaGraph obstacles taken at submit time, so
+// workers never read state the main thread is still changing; the circles
+// are only rasterized when the graph has no cached set for that bin version.
+// A newer submit from the same navigator cancels the one it supersedes.
+//
+// dispatch() is called once per physics frame on the main thread.  It
+// applies every request submitted at least latency_frames dispatches ago,
+// in submission order, waiting for any that is still running — so when a
+// result lands depends only on the frame it was submitted in, never on how
+// fast the workers were.
+//
+// Land patches may land while queries run: HpaGraph searches hold the
+// NavigationMap's query mutex shared, so a patch waits for the running
+// searches and the searches after it see the patched grids.
+// ---------------------------------------------------------------------------
+
+class PathPlanner : public RefCounted {
+	GDCLASS(PathPlanner, RefCounted)
+
+public:
+	static constexpr int DEFAULT_LATENCY_FRAMES = 1;
+
+	PathPlanner();
+	~PathPlanner();
+
+	// --- Setup (GDScript) ---
+
+	/// Graph the workers search.  Restarts running workers.
+	void set_hpa_graph(Ref<HpaGraph> graph);
+	Ref<HpaGraph> get_hpa_graph() const { return hpa_graph_; }
+
+	/// Worker count for the next start(); 0 = one less than the hardware
+	/// thread count (at least one).
+	void set_thread_count(int count);
+	int get_thread_count() const { return thread_count_; }
+
+	/// Dispatches between submit and apply (0 = the next dispatch).
+	void set_latency_frames(int frames);
+	int get_latency_frames() const { return latency_frames_; }
+
+	void start();
+	void stop();
+	bool is_running() const { return !workers_.empty(); }
+
+	/// Apply finished requests that are due.  Returns the number applied.
+	int dispatch();
+
+	/// Block until no request is queued or running (results stay pending).
+	void drain();
+
+	Dictionary get_stats() const;
+
+	// --- C++ API (ShipNavigator) ---
+
+	struct Request {
+		Vector2 from;
+		Vector2 to;
+		float clearance = 0.0f;
+		float speed = 0.0f;  // m/s, for obstacle arrival times (HpaBlockView)
+		// ThreatRegistry bin the threats came from (HpaGraph::get_threat_set key)
+		int threat_team_id = -1;
+		int threat_radius_bin = 0;
+		uint64_t threat_version = 0;
+		std::vector<ThreatCircle> threats;
+	};
+
+	/// Queue a request for the navigator, cancelling its previous one.
+	/// Returns the request's ticket (submission order).
+	uint64_t submit(ObjectID navigator, Request request);
+
+	/// Drop the navigator's pending request, if any.
+	void cancel(ObjectID navigator);
+
+protected:
+	static void _bind_methods();
+
+private:
+	enum JobState : uint8_t {
+		JOB_QUEUED,
+		JOB_RUNNING,
+		JOB_DONE,
+	};
+
+	struct Job {
+		uint64_t ticket = 0;
+		uint64_t navigator = 0;  // ObjectID of the submitting ShipNavigator
+		uint64_t frame = 0;      // dispatch count at submit
+		Request request;
+		std::shared_ptr<const HpaObstacleSet> obstacles;
+		JobState state = JOB_QUEUED;
+		bool cancelled = false;
+		PathResult result;
+		float plan_us = 0.0f;
+	};
+
+	Ref<HpaGraph> hpa_graph_;
+	int thread_count_ = 0;
+	int latency_frames_ = DEFAULT_LATENCY_FRAMES;
+
+	std::vector<std::thread> workers_;
+	mutable std::mutex mutex_;
+	std::condition_variable work_cv_;   // a job was queued, or stopping
+	std::condition_variable done_cv_;   // a job finished
+	bool stopping_ = false;
+
+	// All guarded by mutex_
+	std::deque<std::shared_ptr<Job>> jobs_;     // submission order, until applied
+	std::deque<std::shared_ptr<Job>> queue_;    // waiting for a worker
+	std::unordered_map<uint64_t, std::shared_ptr<Job>> latest_;  // navigator -> newest job
+	uint64_t next_ticket_ = 1;
+	uint64_t frame_ = 0;
+	int running_ = 0;
+
+	// Stats (mutex_)
+	uint64_t stat_submitted_ = 0;
+	uint64_t stat_applied_ = 0;
+	uint64_t stat_superseded_ = 0;
+	float stat_avg_plan_us_ = 0.0f;
+	float stat_max_plan_us_ = 0.0f;
+	float stat_last_dispatch_wait_us_ = 0.0f;
+
+	void worker_loop();
+	void run_job(Job &job) const;
+};
+
+} // namespace godot
+
+#endif // PATH_PLANNER_H
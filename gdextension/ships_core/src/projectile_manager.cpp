@@ -19,8 +19,11 @@
 #include <godot_cpp/classes/multiplayer_api.hpp>
 #include <godot_cpp/classes/multiplayer_peer.hpp>
 #include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 using namespace godot;
 
@@ -171,6 +174,11 @@ _ProjectileManager::_ProjectileManager() {
 	navigation_map = Ref<NavigationMap>();
 	tcp_thread_pool = nullptr;
 	sound_effect_manager = nullptr;
+	hit_effects = nullptr;
+	client_time = 0.0;
+	gpu_next_slot = 0;
+	particles_batch_updates = false;
+	particles_batch_frees = false;
 
 	ray_query.instantiate();
 	mesh_ray_query.instantiate();
@@ -196,23 +204,27 @@ void _ProjectileManager::clear_all() {
 		}
 
 		// Remove GPU renderer shell sprite
-		int gpu_id = p->get_frame_count();
-		if (gpu_renderer != nullptr && gpu_id >= 0) {
-			gpu_renderer->call("destroy_shell", gpu_id);
-		}
+		queue_shell_destroy(p->get_frame_count());
 
 		// Free trail emitter
-		int emitter_id = p->get_emitter_id();
-		if (compute_particle_system != nullptr && emitter_id >= 0) {
-			compute_particle_system->call("free_emitter", emitter_id);
-		}
+		queue_emitter_free(p->get_emitter_id());
 	}
+	flush_trail_updates(client_time);
+	flush_emitter_frees();
 
 	// Clear all projectile data
 	projectiles.clear();
 	projectiles.resize(1); // Match initial state from _ready
 	ids_reuse.clear();
 	shell_param_ids.clear();
+	trail_param_ids.clear();
+	trail_cpu_slots.clear();
+	splash_batch.clear();
+	explosion_batch.clear();
+	sparks_batch.clear();
+	explosion_sound_batch.clear();
+	gpu_free_slots.clear();
+	gpu_next_slot = 0;
 	next_id = 0;
 	bullet_id = 0;
 	_next_shell_uid = 1;
@@ -297,6 +309,14 @@ void _ProjectileManager::_ready() {
 			UtilityFunctions::push_warning("SoundEffectManager autoload not found!");
 		}
 
+		// Cache HitEffects autoload reference
+		if (has_node("/root/HitEffects")) {
+			hit_effects = get_node<Node>("/root/HitEffects");
+			UtilityFunctions::print("Cached HitEffects autoload");
+		} else {
+			UtilityFunctions::push_warning("HitEffects autoload not found!");
+		}
+
 		// Initialize GPU-based renderer
 		Ref<Resource> gpu_renderer_script = ResourceLoader::get_singleton()->load(
 			"res://src/artillary/GPUProjectileRenderer.gd");
@@ -344,6 +364,7 @@ void _ProjectileManager::_init_compute_trails() {
 
 	// Find the UnifiedParticleSystem in the scene tree
 	compute_particle_system = _find_particle_system();
+	cache_particle_batch_support();
 
 	if (compute_particle_system == nullptr) {
 		UtilityFunctions::push_warning("ProjectileManager: UnifiedParticleSystem not found, trails disabled");
@@ -512,6 +533,9 @@ void _ProjectileManager::_process(double delta) {
 	// Update shell positions in GPU renderer and trail particles
 	_process_trails_only(client_time);
 
+	// Play this frame's coalesced hit effects
+	flush_hit_effects();
+
 	// if (abs(client_time - current_time) < 1.0 / physics_fps) {
 	//     client_time += delta;
 	// } else
@@ -527,6 +551,17 @@ void _ProjectileManager::_process(double delta) {
 void _ProjectileManager::_process_trails_only(double time) {
 	int physics_fps = ProjectSettings::get_singleton()->get_setting("physics/common/physics_ticks_per_second");
 	double step_size = 1.0 / physics_fps;
+
+	// Fire/launch/destroy records queued since the last frame go out first so
+	// the position batch below only touches claimed slots
+	flush_trail_updates(time);
+	flush_emitter_frees();
+
+	cpu_shell_ids.clear();
+	cpu_shell_positions.clear();
+	emitter_update_ids.clear();
+	emitter_update_positions.clear();
+
 	for (int i = 0; i < projectiles.size(); i++) {
 		Variant p_var = projectiles[i];
 		if (p_var.get_type() == Variant::NIL) {
@@ -557,10 +592,12 @@ void _ProjectileManager::_process_trails_only(double time) {
 
 		p->set_position(new_position);
 
-		// Update GPU renderer with new position
+		// The GPU renderer evaluates the trajectory itself; only shells that
+		// could not get a param row are still positioned from here
 		int gpu_id = p->get_frame_count();  // GPU slot ID stored in frame_count
-		if (gpu_renderer != nullptr && gpu_id >= 0) {
-			gpu_renderer->call("update_shell_position", gpu_id, new_position);
+		if (gpu_id >= 0 && !trail_cpu_slots.empty() && trail_cpu_slots.count(gpu_id)) {
+			cpu_shell_ids.push_back(gpu_id);
+			cpu_shell_positions.push_back(new_position);
 		}
 
 		if (p->get_emitter_id() < 0 &&
@@ -595,12 +632,184 @@ void _ProjectileManager::_process_trails_only(double time) {
 		// 	continue;
 		// }
 
-		// Use GPU emitter system for trails if available
+		// Use GPU emitter system for trails if available - GPU handles emission automatically
 		if (compute_particle_system != nullptr && p->get_emitter_id() >= 0) {
-			// Simply update the emitter position - GPU handles emission automatically
-			compute_particle_system->call("update_emitter_position", p->get_emitter_id(), p->get_position());
+			emitter_update_ids.push_back(p->get_emitter_id());
+			emitter_update_positions.push_back(new_position);
 		}
 	}
+
+	// One call per subsystem for the whole frame
+	if (gpu_renderer != nullptr && !cpu_shell_ids.empty()) {
+		gpu_renderer->call("update_shell_positions", to_packed_ids(cpu_shell_ids), to_packed_positions(cpu_shell_positions));
+	}
+
+	if (compute_particle_system != nullptr && !emitter_update_ids.empty()) {
+		if (particles_batch_updates) {
+			compute_particle_system->call("update_emitter_positions",
+				to_packed_ids(emitter_update_ids), to_packed_positions(emitter_update_positions));
+		} else {
+			for (size_t i = 0; i < emitter_update_ids.size(); i++) {
+				compute_particle_system->call("update_emitter_position", emitter_update_ids[i], emitter_update_positions[i]);
+			}
+		}
+	}
+}
+
+PackedInt32Array _ProjectileManager::to_packed_ids(const std::vector<int32_t> &ids) {
+	PackedInt32Array out;
+	out.resize((int64_t)ids.size());
+	std::memcpy(out.ptrw(), ids.data(), ids.size() * sizeof(int32_t));
+	return out;
+}
+
+PackedVector3Array _ProjectileManager::to_packed_positions(const std::vector<Vector3> &positions) {
+	PackedVector3Array out;
+	out.resize((int64_t)positions.size());
+	Vector3 *dst = out.ptrw();
+	for (size_t i = 0; i < positions.size(); i++) {
+		dst[i] = positions[i];
+	}
+	return out;
+}
+
+PackedFloat32Array _ProjectileManager::to_packed_floats(const std::vector<float> &values) {
+	PackedFloat32Array out;
+	out.resize((int64_t)values.size());
+	std::memcpy(out.ptrw(), values.data(), values.size() * sizeof(float));
+	return out;
+}
+
+void _ProjectileManager::cache_particle_batch_support() {
+	particles_batch_updates = compute_particle_system != nullptr &&
+			compute_particle_system->has_method("update_emitter_positions");
+	particles_batch_frees = compute_particle_system != nullptr &&
+			compute_particle_system->has_method("free_emitters");
+}
+
+void _ProjectileManager::queue_emitter_free(int emitter_id) {
+	if (emitter_id >= 0 && compute_particle_system != nullptr) {
+		emitter_free_ids.push_back(emitter_id);
+	}
+}
+
+void _ProjectileManager::flush_emitter_frees() {
+	if (emitter_free_ids.empty()) {
+		return;
+	}
+	if (compute_particle_system != nullptr) {
+		if (particles_batch_frees) {
+			compute_particle_system->call("free_emitters", to_packed_ids(emitter_free_ids));
+		} else {
+			for (int32_t emitter_id : emitter_free_ids) {
+				compute_particle_system->call("free_emitter", emitter_id);
+			}
+		}
+	}
+	emitter_free_ids.clear();
+}
+
+int _ProjectileManager::allocate_gpu_slot() {
+	if (!gpu_free_slots.empty()) {
+		int slot = gpu_free_slots.back();
+		gpu_free_slots.pop_back();
+		return slot;
+	}
+	if (gpu_next_slot < GPU_MAX_SHELLS) {
+		return gpu_next_slot++;
+	}
+	return -1;
+}
+
+void _ProjectileManager::queue_shell_fire(int gpu_id, const Color &color, double size, int shell_type) {
+	float *rec = push_trail_record(TRAIL_RECORD_FIRE, gpu_id);
+	rec[2] = color.r;
+	rec[3] = color.g;
+	rec[4] = color.b;
+	rec[5] = color.a;
+	rec[6] = (float)size;
+	rec[7] = (float)shell_type;
+}
+
+void _ProjectileManager::queue_shell_destroy(int gpu_id) {
+	if (gpu_id < 0) {
+		return;
+	}
+	// Records apply in order, so the slot can be handed out again right away
+	push_trail_record(TRAIL_RECORD_DESTROY, gpu_id);
+	gpu_free_slots.push_back(gpu_id);
+	trail_cpu_slots.erase(gpu_id);
+}
+
+float *_ProjectileManager::push_trail_record(int kind, int index) {
+	size_t base = trail_updates.size();
+	trail_updates.resize(base + TRAIL_RECORD_STRIDE, 0.0f);
+	float *rec = trail_updates.data() + base;
+	rec[0] = (float)kind;
+	rec[1] = (float)index;
+	return rec;
+}
+
+int _ProjectileManager::trail_param_id(const Ref<Resource> &shell) {
+	if (!shell.is_valid()) {
+		return -1;
+	}
+
+	uint64_t key = (uint64_t)shell->get_instance_id();
+	auto it = trail_param_ids.find(key);
+	if (it != trail_param_ids.end()) {
+		return it->second;
+	}
+
+	if ((int)trail_param_ids.size() >= TRAIL_MAX_PARAMS) {
+		return -1;
+	}
+
+	int param_id = (int)trail_param_ids.size();
+	trail_param_ids[key] = param_id;
+
+	float *rec = push_trail_record(TRAIL_RECORD_PARAMS, param_id);
+	rec[2] = (float)(double)shell->get("drag");
+	rec[3] = (float)(double)shell->get("vt");
+	rec[4] = (float)(double)shell->get("tau");
+	return param_id;
+}
+
+void _ProjectileManager::queue_trail_launch(int gpu_id, const Vector3 &pos, const Vector3 &vel, double t,
+											const Ref<Resource> &shell) {
+	int param_id = trail_param_id(shell);
+	if (param_id < 0) {
+		// No drag parameters on the GPU for this shell, keep positioning it from the CPU
+		trail_cpu_slots.insert(gpu_id);
+		return;
+	}
+	trail_cpu_slots.erase(gpu_id);
+
+	float *rec = push_trail_record(TRAIL_RECORD_LAUNCH, gpu_id);
+	rec[2] = pos.x;
+	rec[3] = pos.y;
+	rec[4] = pos.z;
+	rec[5] = (float)t;
+	rec[6] = vel.x;
+	rec[7] = vel.y;
+	rec[8] = vel.z;
+	rec[9] = (float)param_id;
+}
+
+void _ProjectileManager::flush_trail_updates(double time) {
+	if (gpu_renderer == nullptr) {
+		trail_updates.clear();
+		return;
+	}
+
+	// One call per frame: advances the shader clock and uploads any queued records
+	PackedFloat32Array updates;
+	if (!trail_updates.empty()) {
+		updates.resize((int64_t)trail_updates.size());
+		std::memcpy(updates.ptrw(), trail_updates.data(), trail_updates.size() * sizeof(float));
+		trail_updates.clear();
+	}
+	gpu_renderer->call("apply_shell_updates", time, updates);
 }
 
 void _ProjectileManager::sync_time(double server_time) {
@@ -960,16 +1169,21 @@ void _ProjectileManager::fire_bullet_client(const Vector3 &pos, const Vector3 &v
 		shell_color = Color(1.0, 0.2, 0.05, 1.0); // Orange for HE
 	}
 
-	// Fire shell through GPU renderer (it manages its own IDs internally)
+	// Queue the shell for the GPU renderer; slots are assigned here and the
+	// fire/launch records reach the renderer in the next frame's batch
 	int gpu_id = -1;
 	if (gpu_renderer != nullptr) {
-		double drag = 0.009;
 		double size = 1.0;
 		if (shell.is_valid()) {
-			drag = shell->get("drag");
 			size = shell->get("size");
 		}
-		gpu_id = gpu_renderer->call("fire_shell", pos, vel, drag, size, shell_type, shell_color);
+		gpu_id = allocate_gpu_slot();
+		if (gpu_id >= 0) {
+			queue_shell_fire(gpu_id, shell_color, size, shell_type);
+			queue_trail_launch(gpu_id, pos, vel, t, shell);
+		} else {
+			UtilityFunctions::push_warning("ProjectileManager: No available GPU shell slots!");
+		}
 	}
 
 	// Still track in projectiles array for trail emission and ID mapping
@@ -985,8 +1199,7 @@ void _ProjectileManager::fire_bullet_client(const Vector3 &pos, const Vector3 &v
 
 	if (muzzle_blast) {
 		// Call HitEffects.muzzle_blast_effect - this is a GDScript autoload
-		if (has_node("/root/HitEffects")) {
-			Node *hit_effects = get_node<Node>("/root/HitEffects");
+		if (hit_effects != nullptr) {
 			double size = 1.0;
 			if (shell.is_valid()) {
 				size = shell->get("size");
@@ -1077,64 +1290,134 @@ void _ProjectileManager::destroy_bullet_rpc2(int id, const Vector3 &pos, int hit
 		radius = params->get("size");
 	}
 
-	// Free the GPU emitter if one was allocated
-	if (bullet->get_emitter_id() >= 0 && compute_particle_system != nullptr) {
-		compute_particle_system->call("free_emitter", bullet->get_emitter_id());
+	// Free the GPU emitter if one was allocated (batched with this frame's frees)
+	if (bullet->get_emitter_id() >= 0) {
+		queue_emitter_free(bullet->get_emitter_id());
 		bullet->set_emitter_id(-1);
 	}
 
-	// Destroy in GPU renderer
-	int gpu_id = bullet->get_frame_count(); // GPU renderer ID was stored here
-	if (gpu_renderer != nullptr) {
-		gpu_renderer->call("destroy_shell", gpu_id);
-	}
+	// Destroy in GPU renderer (batched with this frame's records)
+	queue_shell_destroy(bullet->get_frame_count()); // GPU renderer ID was stored here
 
 	projectiles[id] = Variant();
 
-	// Create hit effects
-	if (has_node("/root/HitEffects")) {
-		// UtilityFunctions::print("Creating hit effects for bullet id: ", id);
-		Node *hit_effects = get_node<Node>("/root/HitEffects");
-
-		switch (hit_result) {
-			case WATER:
-				hit_effects->call("splash_effect", pos, radius);
-				break;
-			case PENETRATION:
-				hit_effects->call("he_explosion_effect", pos, radius * 0.8, normal);
-				hit_effects->call("sparks_effect", pos, radius * 0.5, normal);
-				if (sound_effect_manager != nullptr) {
-					float volume = (radius) / 8.0 / 10.0;
-					float pitch = 1.3 / (radius * 0.4);
-					sound_effect_manager->call("play_explosion", pos, pitch, volume);
-				}
-				break;
-			case CITADEL:
-				hit_effects->call("he_explosion_effect", pos, radius * 1.2, normal);
-				hit_effects->call("sparks_effect", pos, radius * 0.6, normal);
-				if (sound_effect_manager != nullptr) {
-					float volume = (radius) / 4.0 / 10.0;
-					float pitch = 1.0 / (radius * 0.45);
-					sound_effect_manager->call("play_explosion", pos, pitch, volume);
-				}
-				break;
-			case RICOCHET:
-			case OVERPENETRATION:
-			case SHATTER:
-				hit_effects->call("sparks_effect", pos, radius * 0.5, normal);
-				if (sound_effect_manager != nullptr) {
-					float volume = (0.1 + (radius) / 15.0) / 15.0;
-					float pitch = 2.0 / (radius * 0.4);
-					sound_effect_manager->call("play_explosion", pos, pitch, volume);
-				}
-				break;
-			case NOHIT:
-				// No explosion for NOHIT
-				break;
+	// Queue hit effects; merged with the rest of this frame's hits in flush_hit_effects
+	queue_hit_effects(hit_result, pos, radius, normal);
+}
+
+// =============================================================================
+// Client hit effects
+// =============================================================================
+
+void _ProjectileManager::HitEffectBatch::add(const Vector3 &pos, float size, const Vector3 &normal) {
+	for (size_t i = 0; i < positions.size(); i++) {
+		if (positions[i].distance_squared_to(pos) < HIT_EFFECT_MERGE_DIST * HIT_EFFECT_MERGE_DIST) {
+			real_t n = (real_t)counts[i];
+			positions[i] = (positions[i] * n + pos) / (n + 1.0f);
+			sizes[i] = std::max(sizes[i], size);
+			normals[i] += normal;
+			counts[i]++;
+			return;
 		}
-	} else {
-		UtilityFunctions::push_warning("HitEffects not found, cannot create hit effects");
 	}
+	positions.push_back(pos);
+	sizes.push_back(size);
+	normals.push_back(normal);
+	counts.push_back(1);
+}
+
+void _ProjectileManager::HitEffectBatch::clear() {
+	positions.clear();
+	sizes.clear();
+	normals.clear();
+	counts.clear();
+}
+
+void _ProjectileManager::HitSoundBatch::add(const Vector3 &pos, float pitch, float volume) {
+	for (size_t i = 0; i < positions.size(); i++) {
+		if (std::abs(pitches[i] - pitch) <= 0.1f * pitches[i] &&
+				positions[i].distance_squared_to(pos) < HIT_SOUND_MERGE_DIST * HIT_SOUND_MERGE_DIST) {
+			real_t n = (real_t)counts[i];
+			positions[i] = (positions[i] * n + pos) / (n + 1.0f);
+			volumes[i] = std::max(volumes[i], volume);
+			counts[i]++;
+			return;
+		}
+	}
+	positions.push_back(pos);
+	pitches.push_back(pitch);
+	volumes.push_back(volume);
+	counts.push_back(1);
+}
+
+void _ProjectileManager::HitSoundBatch::clear() {
+	positions.clear();
+	pitches.clear();
+	volumes.clear();
+	counts.clear();
+}
+
+void _ProjectileManager::queue_hit_effects(int hit_result, const Vector3 &pos, double radius, const Vector3 &normal) {
+	float r = (float)radius;
+
+	switch (hit_result) {
+		case WATER:
+			splash_batch.add(pos, r, Vector3());
+			break;
+		case PENETRATION:
+			explosion_batch.add(pos, r * 0.8f, normal);
+			sparks_batch.add(pos, r * 0.5f, normal);
+			explosion_sound_batch.add(pos, 1.3f / (r * 0.4f), r / 8.0f / 10.0f);
+			break;
+		case CITADEL:
+			explosion_batch.add(pos, r * 1.2f, normal);
+			sparks_batch.add(pos, r * 0.6f, normal);
+			explosion_sound_batch.add(pos, 1.0f / (r * 0.45f), r / 4.0f / 10.0f);
+			break;
+		case RICOCHET:
+		case OVERPENETRATION:
+		case SHATTER:
+			sparks_batch.add(pos, r * 0.5f, normal);
+			explosion_sound_batch.add(pos, 2.0f / (r * 0.4f), (0.1f + r / 15.0f) / 15.0f);
+			break;
+		case NOHIT:
+			// No explosion for NOHIT
+			break;
+	}
+}
+
+void _ProjectileManager::flush_hit_effects() {
+	if (hit_effects != nullptr) {
+		if (!splash_batch.positions.empty()) {
+			hit_effects->call("splash_effects", to_packed_positions(splash_batch.positions),
+				to_packed_floats(splash_batch.sizes));
+		}
+
+		// Merged normals are sums; HitEffects normalizes them
+		if (!explosion_batch.positions.empty()) {
+			hit_effects->call("he_explosion_effects", to_packed_positions(explosion_batch.positions),
+				to_packed_floats(explosion_batch.sizes), to_packed_positions(explosion_batch.normals));
+		}
+		if (!sparks_batch.positions.empty()) {
+			hit_effects->call("sparks_effects", to_packed_positions(sparks_batch.positions),
+				to_packed_floats(sparks_batch.sizes), to_packed_positions(sparks_batch.normals));
+		}
+	}
+
+	if (sound_effect_manager != nullptr && !explosion_sound_batch.positions.empty()) {
+		// A merged explosion gets louder with the number of hits it stands for, up to HIT_SOUND_MAX_GAIN
+		std::vector<float> &volumes = explosion_sound_batch.volumes;
+		for (size_t i = 0; i < volumes.size(); i++) {
+			volumes[i] *= std::min(std::sqrt((float)explosion_sound_batch.counts[i]), HIT_SOUND_MAX_GAIN);
+		}
+		sound_effect_manager->call("play_explosions", to_packed_positions(explosion_sound_batch.positions),
+			to_packed_floats(explosion_sound_batch.pitches), to_packed_floats(volumes));
+	}
+
+	splash_batch.clear();
+	explosion_batch.clear();
+	sparks_batch.clear();
+	explosion_sound_batch.clear();
 }
 
 void _ProjectileManager::destroy_bullet_rpc3(const PackedByteArray &data) {
@@ -1363,6 +1646,9 @@ Camera3D *_ProjectileManager::get_camera() const {
 // Setters
 void _ProjectileManager::set_shell_time_multiplier(double value) {
 	shell_time_multiplier = value;
+	if (gpu_renderer != nullptr) {
+		gpu_renderer->call("set_time_multiplier", shell_time_multiplier);
+	}
 }
 
 void _ProjectileManager::set_next_id(int value) {
@@ -1391,6 +1677,7 @@ void _ProjectileManager::set_gpu_renderer(Node *value) {
 
 void _ProjectileManager::set_compute_particle_system(Node *value) {
 	compute_particle_system = value;
+	cache_particle_batch_support();
 }
 
 Ref<Resource> _ProjectileManager::get_trail_template() const {
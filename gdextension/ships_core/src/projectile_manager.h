@@ -10,12 +10,16 @@
 #include <godot_cpp/variant/array.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
 #include <godot_cpp/variant/basis.hpp>
 #include <godot_cpp/variant/color.hpp>
 
 #include <cstdint>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <godot_cpp/variant/vector2.hpp>
 
 #include "projectile_data.h"
@@ -72,6 +76,40 @@ private:
 	Ref<NavigationMap> navigation_map;
 	Node *tcp_thread_pool;
 	Node *sound_effect_manager;
+	Node *hit_effects;
+
+	// --- Client hit effects (coalesced per frame, one call per effect type) ---
+	static constexpr float HIT_EFFECT_MERGE_DIST = 8.0f;  // same-type visuals closer than this play once
+	static constexpr float HIT_SOUND_MERGE_DIST = 60.0f;  // explosions closer than this (and of similar pitch) play once
+	static constexpr float HIT_SOUND_MAX_GAIN = 2.0f;     // volume cap for a merged explosion
+
+	struct HitEffectBatch {
+		std::vector<Vector3> positions;
+		std::vector<float> sizes;
+		std::vector<Vector3> normals;
+		std::vector<int> counts;
+
+		void add(const Vector3 &pos, float size, const Vector3 &normal);
+		void clear();
+	};
+
+	struct HitSoundBatch {
+		std::vector<Vector3> positions;
+		std::vector<float> pitches;
+		std::vector<float> volumes;
+		std::vector<int> counts;
+
+		void add(const Vector3 &pos, float pitch, float volume);
+		void clear();
+	};
+
+	HitEffectBatch splash_batch;
+	HitEffectBatch explosion_batch;
+	HitEffectBatch sparks_batch;
+	HitSoundBatch explosion_sound_batch;
+
+	void queue_hit_effects(int hit_result, const Vector3 &pos, double radius, const Vector3 &normal);
+	void flush_hit_effects();
 
 	// --- Shell landing spatial grid (for bot shell dodging) ---
 	struct ShellLandingEntry {
@@ -101,6 +139,51 @@ private:
 	};
 	std::unordered_map<uint64_t, ArmorRayCacheEntry> armor_ray_cache;
 
+	// --- Client shell sprite uploads (trajectory evaluated in GPUProjectileShader) ---
+	// Record layout must match GPUProjectileRenderer.gd (UPDATE_* constants).
+	static constexpr int TRAIL_RECORD_STRIDE = 12;
+	static constexpr int TRAIL_RECORD_PARAMS = 1;  // [kind, param_id, drag, vt, tau, ...]
+	static constexpr int TRAIL_RECORD_LAUNCH = 2;  // [kind, slot, start.xyz, start_time, vel.xyz, param_id, ...]
+	static constexpr int TRAIL_RECORD_FIRE = 3;    // [kind, slot, color.rgba, size, shell_type, ...]
+	static constexpr int TRAIL_RECORD_DESTROY = 4; // [kind, slot, ...]
+	static constexpr int TRAIL_MAX_PARAMS = 1024;  // GPUProjectileRenderer.MAX_SHELL_PARAMS
+	static constexpr int GPU_MAX_SHELLS = 16384;   // GPUProjectileRenderer.MAX_SHELLS
+
+	std::vector<float> trail_updates;                   // flushed once per frame
+	std::unordered_map<uint64_t, int> trail_param_ids;  // ShellParams instance id -> GPU param row
+	std::unordered_set<int> trail_cpu_slots;            // GPU slots positioned from the CPU (param table full)
+
+	// Renderer slots are assigned here so fire/destroy can be batched
+	std::vector<int> gpu_free_slots;
+	int gpu_next_slot;
+
+	// Per-frame batches, reused to keep their capacity
+	std::vector<int32_t> cpu_shell_ids;
+	std::vector<Vector3> cpu_shell_positions;
+	std::vector<int32_t> emitter_update_ids;
+	std::vector<Vector3> emitter_update_positions;
+	std::vector<int32_t> emitter_free_ids;
+
+	// Batched entry points the particle system provides (checked once it is found)
+	bool particles_batch_updates;
+	bool particles_batch_frees;
+
+	int  trail_param_id(const Ref<Resource> &shell);
+	float *push_trail_record(int kind, int index);
+	void queue_trail_launch(int gpu_id, const Vector3 &pos, const Vector3 &vel, double t, const Ref<Resource> &shell);
+	void queue_shell_fire(int gpu_id, const Color &color, double size, int shell_type);
+	void queue_shell_destroy(int gpu_id);
+	int  allocate_gpu_slot();
+	void flush_trail_updates(double time);
+
+	void cache_particle_batch_support();
+	void queue_emitter_free(int emitter_id);
+	void flush_emitter_frees();
+
+	static PackedInt32Array to_packed_ids(const std::vector<int32_t> &ids);
+	static PackedVector3Array to_packed_positions(const std::vector<Vector3> &positions);
+	static PackedFloat32Array to_packed_floats(const std::vector<float> &values);
+
 	uint64_t armor_ray_cache_key(const Ref<ProjectileData> &projectile) const;
 	NativeArmorInteraction::RaycastCache &get_armor_ray_cache(const Ref<ProjectileData> &projectile);
 
@@ -5,9 +5,12 @@
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/array.hpp>
 #include <godot_cpp/variant/vector3.hpp>
+#include "ballistics_core.h"
 
 namespace godot {
 
+/// Drag-free ballistics, implemented with BallisticSolver<VacuumDrag>
+/// (see ballistics_core.h).
 class ProjectilePhysics : public Node {
 	GDCLASS(ProjectilePhysics, Node)
 
@@ -45,6 +48,9 @@ public:
 	/// Calculate the required launch angle to achieve a specific maximum range
 	/// Returns the angle in radians or -1 if the range exceeds the physical limit
 	static double calculate_angle_from_max_range(double max_range, double projectile_speed);
+
+private:
+	using Solver = BallisticSolver<VacuumDrag>;
 };
 
 } // namespace godot
@@ -6,9 +6,13 @@
 #include <godot_cpp/variant/array.hpp>
 #include <godot_cpp/variant/vector3.hpp>
 #include <godot_cpp/classes/resource.hpp>
+#include "ballistics_core.h"
 
 namespace godot {
 
+/// Legacy linear-drag ballistics (deprecated, use ProjectilePhysicsWithDragV2).
+/// Kept for script compatibility; all solves go through BallisticSolver<LinearDrag>
+/// (see ballistics_core.h), so it shares V2's closed-form/Newton solver.
 class ProjectilePhysicsWithDrag : public Node {
 	GDCLASS(ProjectilePhysicsWithDrag, Node)
 
@@ -36,6 +40,8 @@ public:
 	static constexpr int MAX_ITERATIONS = 16;
 	// Angle adjustment step for binary search (in radians)
 	static constexpr double INITIAL_ANGLE_STEP = 0.1;
+	// Newton iterations when refining the launch elevation
+	static constexpr int REFINE_ITERATIONS = 4;
 
 protected:
 	static void _bind_methods();
@@ -74,9 +80,8 @@ public:
 	static Array calculate_launch_vector(const Vector3 &start_pos, const Vector3 &target_pos,
 		Ref<Resource> shell_params);
 
-	/// Calculate the impact position where y = 0 using advanced analytical approximation
-	/// This function uses Newton-Raphson refinement with a high-accuracy initial guess
-	/// to solve the transcendental equation for projectile motion with drag
+	/// Calculate the impact position where y = 0
+	/// Newton-Raphson on the closed-form height, seeded with the drag-free impact time
 	static Vector3 calculate_impact_position(const Vector3 &start_pos, const Vector3 &launch_velocity,
 		double drag_coefficient);
 
@@ -99,6 +104,8 @@ public:
 	/// Calculate the required launch angle to achieve a specific range with drag
 	static double calculate_angle_from_max_range(double max_range, Ref<Resource> shell_params);
 
+private:
+	using Solver = BallisticSolver<LinearDrag>;
 };
 
 } // namespace godot
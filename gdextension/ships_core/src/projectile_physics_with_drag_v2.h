@@ -12,6 +12,7 @@
 #include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/variant/typed_array.hpp>
 #include <godot_cpp/variant/rid.hpp>
+#include "ballistics_core.h"
 #include "navigation_map.h"
 
 namespace godot {
@@ -19,6 +20,7 @@ namespace godot {
 /// Analytical ballistics with quadratic drag.
 /// Supports angles from -PI/2 to PI/2 (downward to upward, forward only).
 /// All methods are static and take ShellParams as an argument.
+/// Thin wrapper over BallisticSolver<QuadraticDrag> (see ballistics_core.h).
 class ProjectilePhysicsWithDragV2 : public RefCounted {
 	GDCLASS(ProjectilePhysicsWithDragV2, RefCounted)
 
@@ -164,35 +166,29 @@ public:
 		const Array &exclude_rids
 	);
 
-private:
 	//==========================================================================
-	// Internal Helper Functions - 2D Analytical
+	// Benchmark
 	//==========================================================================
 
-	// Horizontal motion
-	static double _horizontal_position(double cos_theta, double t, double v0, double beta);
-	static double _horizontal_velocity(double cos_theta, double t, double v0, double beta);
-
-	// Vertical motion
-	static double _vertical_position(double sin_theta, double t, double v0, double vt, double tau);
-	static double _vertical_velocity(double sin_theta, double t, double v0, double vt, double tau);
-
-	// Inverse problem helpers
-	static double _time_from_x(double x, double theta, double v0, double beta);
-	static double _vacuum_angle(double x, double y, double v0, bool high_arc);
-	static double _newton_refine_angle(double theta, double target_x, double target_y, int max_iter, double v0, double beta, double vt, double tau);
-
-	// Derivatives for Newton refinement
-	static double _total_deriv_y_theta(double theta, double x, double t, double v0, double beta, double vt, double tau);
-	static double _time_deriv_theta(double x, double theta, double t, double v0, double beta);
-	static double _vertical_position_deriv_s(double sin_theta, double t, double v0, double vt, double tau);
+	/// Time the shared launch solver for every drag model on the same shell.
+	/// @param shell_params Resource with speed, drag, vt, tau properties
+	/// @param samples Number of targets spread over each model's reach
+	/// @return Dictionary { vacuum, linear, quadratic } of
+	///         { samples, failures, max_range, ns_per_call, max_error, mean_error }
+	static Dictionary benchmark_drag_models(const Ref<Resource> &shell_params, int samples = 1000);
 
 	//==========================================================================
-	// Internal Helper Functions - 3D
+	// C++-only helpers (shared with other native samplers, not bound)
 	//==========================================================================
 
+	/// Model with GRAVITY and placeholder drag terms, filled by _extract_params
+	static QuadraticDrag _default_model();
+
 	/// Extract shell parameters from resource
-	static bool _extract_params(const Ref<Resource> &shell_params, double &v0, double &beta, double &vt, double &tau);
+	static bool _extract_params(const Ref<Resource> &shell_params, double &v0, QuadraticDrag &model);
+
+private:
+	using Solver = BallisticSolver<QuadraticDrag>;
 };
 
 } // namespace godot
@@ -10,11 +10,15 @@
 #include "projectile_physics.h"
 #include "projectile_physics_with_drag.h"
 #include "projectile_physics_with_drag_v2.h"
+#include "dispersion_sampler.h"
 
 // From navigation
 #include "navigation_map.h"
 #include "waypoint_graph.h"
 #include "hpa_graph.h"
+#include "navigation_cache.h"
+#include "nav_parallel.h"
+#include "path_planner.h"
 #include "ship_navigator.h"
 #include "threat_registry.h"
 
@@ -34,6 +38,7 @@ void initialize_ships_core_module(ModuleInitializationLevel p_level) {
 	GDREGISTER_CLASS(ProjectilePhysics);
 	GDREGISTER_CLASS(ProjectilePhysicsWithDrag);
 	GDREGISTER_CLASS(ProjectilePhysicsWithDragV2);
+	GDREGISTER_CLASS(DispersionSampler);
 
 	// Register data classes (they are dependencies)
 	GDREGISTER_CLASS(ProjectileData);
@@ -45,7 +50,9 @@ void initialize_ships_core_module(ModuleInitializationLevel p_level) {
 	GDREGISTER_CLASS(NavigationMap);
 	GDREGISTER_CLASS(WaypointGraph);
 	GDREGISTER_CLASS(HpaGraph);
+	GDREGISTER_CLASS(NavigationCache);
 	GDREGISTER_CLASS(ThreatRegistry);
+	GDREGISTER_CLASS(PathPlanner);
 	GDREGISTER_CLASS(ShipNavigator);
 }
 
@@ -53,6 +60,9 @@ void uninitialize_ships_core_module(ModuleInitializationLevel p_level) {
 	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
 		return;
 	}
+
+	// Join the build workers before the library can be unloaded
+	NavThreadPool::shutdown();
 }
 
 extern "C" {
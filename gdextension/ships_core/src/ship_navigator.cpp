@@ -21,6 +21,10 @@ void ShipNavigator::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_map", "map"), &ShipNavigator::set_map);
 	ClassDB::bind_method(D_METHOD("set_hpa_graph", "graph"), &ShipNavigator::set_hpa_graph);
 	ClassDB::bind_method(D_METHOD("get_hpa_graph"), &ShipNavigator::get_hpa_graph);
+	ClassDB::bind_method(D_METHOD("set_path_planner", "planner"), &ShipNavigator::set_path_planner);
+	ClassDB::bind_method(D_METHOD("get_path_planner"), &ShipNavigator::get_path_planner);
+	ClassDB::bind_method(D_METHOD("set_path_refine_budget_us", "budget_us"), &ShipNavigator::set_path_refine_budget_us);
+	ClassDB::bind_method(D_METHOD("get_path_refine_budget_us"), &ShipNavigator::get_path_refine_budget_us);
 	ClassDB::bind_method(D_METHOD("set_ship_params",
 		"turning_circle_radius", "rudder_response_time",
 		"acceleration_time", "deceleration_time",
@@ -179,6 +183,9 @@ ShipNavigator::ShipNavigator() {
 }
 
 ShipNavigator::~ShipNavigator() {
+	if (path_planner_.is_valid()) {
+		path_planner_->cancel(get_instance_id());
+	}
 	if (threat_bin_ && threat_registry_.is_valid()) {
 		threat_registry_->release_bin(threat_bin_);
 	}
@@ -198,6 +205,17 @@ void ShipNavigator::set_hpa_graph(Ref<HpaGraph> graph) {
 	hpa_graph_ = graph;
 }
 
+void ShipNavigator::set_path_planner(Ref<PathPlanner> planner) {
+	if (path_planner_.is_valid() && path_planner_ != planner) {
+		path_planner_->cancel(get_instance_id());
+	}
+	path_planner_ = planner;
+}
+
+void ShipNavigator::set_path_refine_budget_us(float budget_us) {
+	refine_budget_us_ = std::max(0.0f, budget_us);
+}
+
 
 
 void ShipNavigator::set_bot_id(int id) {
@@ -269,15 +287,20 @@ void ShipNavigator::navigate_to(Vector3 p_target, float p_heading, float p_hold_
 	target.heading_weight = clamp_f(p_heading_weight, 0.0f, 1.0f);
 	target.prefer_reverse = p_prefer_reverse;
 
-	// navigate_to() is the synchronous planning trigger.
+	// navigate_to() is the planning trigger (queued instead when a running
+	// PathPlanner is attached).
 	run_plan_sync();
 }
 
 void ShipNavigator::stop() {
+	if (path_planner_.is_valid()) {
+		path_planner_->cancel(get_instance_id());
+	}
 	target.position = state.position;
 	target.heading = state.heading;
 	target.hold_radius = 0.0f;
 	path_valid = false;
+	refine_active_ = false;
 	set_steering_output(0.0f, 0, false);
 }
 
@@ -319,14 +342,14 @@ bool ShipNavigator::is_collision_imminent() const {
 
 void ShipNavigator::register_obstacle(int id, Vector2 position, Vector2 velocity, float radius, float length) {
 	obstacles[id] = DynamicObstacle(id, position, velocity, radius, length);
-	// Forward circular obstacle to HPA* for cluster-level blocking.
+	// Forward circular obstacle to HPA* for cluster-level soft costs.
 	// Use only ship_beam as the padding margin (not full ship clearance) since
 	// HPA* is a high-level planner and fine-grained avoidance is handled by
 	// the arc simulation.  Over-inflating the radius here causes ships to route
 	// excessively far around other ships.
 	if (hpa_graph_.is_valid() && hpa_graph_->is_built()) {
 		float effective_radius = std::max(radius, length * 0.5f) + params.ship_beam;
-		hpa_graph_->add_obstacle(id, position, effective_radius);
+		hpa_graph_->add_obstacle(id, position, effective_radius, velocity);
 	}
 }
 
@@ -341,15 +364,9 @@ void ShipNavigator::update_obstacle(int id, Vector2 position, Vector2 velocity)
 			it->second.heading = std::atan2(velocity.x, velocity.y);
 		}
 	}
-	// Re-register obstacle at new position in HPA*
+	// Same radius, so HPA* only rebuckets when the footprint changes clusters
 	if (hpa_graph_.is_valid() && hpa_graph_->is_built()) {
-		// Find the original radius/length for this obstacle
-		auto oit = obstacles.find(id);
-		if (oit != obstacles.end()) {
-			const DynamicObstacle &obs = oit->second;
-			float effective_radius = std::max(obs.radius, obs.length * 0.5f) + params.ship_beam;
-			hpa_graph_->add_obstacle(id, position, effective_radius);
-		}
+		hpa_graph_->move_obstacle(id, position, velocity);
 	}
 }
 
@@ -403,11 +420,6 @@ void ShipNavigator::clear_threat_source() {
 	threat_bin_ = nullptr;
 	threat_registry_.unref();
 	threat_last_version_ = 0;
-	// Clear the HPA* cluster-level threat layer immediately so paths are
-	// no longer routed around the now-removed detection zones.
-	if (hpa_graph_.is_valid() && hpa_graph_->is_built()) {
-		hpa_graph_->clear_threats();
-	}
 }
 
 // ============================================================================
@@ -639,10 +651,12 @@ Array ShipNavigator::get_debug_torpedo_threat_points() const {
 
 TypedArray<Dictionary> ShipNavigator::get_debug_threat_clusters() const {
 	if (!hpa_graph_.is_valid() || !hpa_graph_->is_built()) return TypedArray<Dictionary>();
-	// Use the pure-query path so we always see THIS navigator's threat bin,
-	// not whatever ship last stamped the shared cluster_threat_blocked_ array.
+	// The same cached set this navigator's queries route around
 	if (!threat_bin_ || threat_bin_->threats.empty()) return TypedArray<Dictionary>();
-	return hpa_graph_->compute_debug_threat_clusters(threat_bin_->threats);
+	std::shared_ptr<const HpaThreatSet> threats = hpa_graph_->get_threat_set(
+			threat_bin_->team_id, threat_bin_->radius_bin, threat_bin_->version, threat_bin_->threats);
+	if (!threats) return TypedArray<Dictionary>();
+	return hpa_graph_->get_debug_threat_set(*threats);
 }
 
 Dictionary ShipNavigator::adjust_destination_for_threats(Vector2 ship_pos, Vector2 dest) const {
@@ -932,6 +946,15 @@ void ShipNavigator::update_normal(float delta) {
 	timing_plan_phase_val = 0;
 	timing_plan_us = 0.0f;
 
+	// The one exception: land patched under the remaining route
+	if (path_valid && map.is_valid() &&
+		static_cast<uint64_t>(map->get_version()) != map_version_seen_) {
+		check_map_changes();
+	}
+
+	// Budgeted planning: pull the next slice of the route
+	if (refine_active_) advance_refinement();
+
 	// --- 2. Advance waypoints ---
 	if (path_valid) advance_waypoint();
 
@@ -1446,42 +1469,134 @@ void ShipNavigator::run_plan_sync() {
 	// Add 100 m buffer on top of the hard hull clearance so waypoints are
 	// placed well away from terrain, giving the arc planner room to manoeuvre.
 	const float plan_min_clearance = get_ship_clearance() + 200.0f;
+	refine_active_ = false;
+
+	if (map.is_valid()) {
+		map_version_seen_ = static_cast<uint64_t>(map->get_version());
+	}
 
 	// -----------------------------------------------------------------------
 	// HPA* path (primary): threat-aware hierarchical A*.
-	// HpaGraph is shared by many ships; apply this navigator's threat layer
-	// immediately before each query so the correct threats are stamped.
+	// HpaGraph is shared by many ships; each query passes this navigator's
+	// threat bin, rasterized once per bin version and cached by the graph.
 	// -----------------------------------------------------------------------
 	if (hpa_graph_.is_valid() && hpa_graph_->is_built() &&
 		map.is_valid() && map->is_built()) {
 
+		// Pick up land patches before reading the clusters
+		hpa_graph_->sync_with_map();
+
+		// Off-thread: keep following the current path until the planner
+		// hands the result back through apply_planned_path().
+		if (path_planner_.is_valid() && path_planner_->is_running() &&
+			path_planner_->get_hpa_graph() == hpa_graph_) {
+			PathPlanner::Request req;
+			req.from = state.position;
+			req.to = target.position;
+			req.clearance = plan_min_clearance;
+			req.speed = params.max_speed;
+			if (threat_bin_) {
+				req.threat_team_id = threat_bin_->team_id;
+				req.threat_radius_bin = threat_bin_->radius_bin;
+				req.threat_version = threat_bin_->version;
+				req.threats = threat_bin_->threats;
+			}
+			path_planner_->submit(get_instance_id(), std::move(req));
+			return;
+		}
+
+		std::shared_ptr<const HpaThreatSet> threats;
 		if (threat_bin_) {
-			hpa_graph_->stamp_threats(threat_bin_->threats);
+			threats = hpa_graph_->get_threat_set(threat_bin_->team_id, threat_bin_->radius_bin,
+												 threat_bin_->version, threat_bin_->threats);
 			threat_last_version_ = threat_bin_->version;
-		} else {
-			hpa_graph_->clear_threats();
 		}
 
-		PathResult pr = hpa_graph_->find_path(state.position, target.position, plan_min_clearance);
-		if (pr.valid && !pr.waypoints.empty()) {
-			// Always end at the exact destination — HPA* snaps to grid nodes
-			// so the final grid node may not be target.position.
-			if (pr.waypoints.back().distance_to(target.position) > 1.0f) {
-				pr.waypoints.push_back(target.position);
-				pr.flags.push_back(WP_NONE);
+		if (refine_budget_us_ > 0.0f) {
+			HpaPathJob job = hpa_graph_->begin_path(state.position, target.position,
+													plan_min_clearance, threats, params.max_speed);
+			hpa_graph_->refine_path(job, refine_budget_us_);
+			if (commit_hpa_result(job.current(), plan_min_clearance) && !job.done) {
+				refine_job_ = std::move(job);
+				refine_active_ = true;
 			}
-			accept_plan_result(pr);
 			return;
 		}
-		// HPA* failed — retain the previous path rather than overwriting it with
-		// a straight-line fallback.  The ship continues following its existing
-		// route while navigate_to() retries on the next call.
-		if (path_valid && !current_path.waypoints.empty()) {
-			return;
+
+		std::shared_ptr<const HpaObstacleSet> obstacles = hpa_graph_->snapshot_obstacles();
+		HpaBlockView view;
+		view.obstacles = obstacles.get();
+		view.threats = threats.get();
+		view.speed = params.max_speed;
+		PathResult pr = hpa_graph_->find_path(state.position, target.position, plan_min_clearance, view);
+		commit_hpa_result(std::move(pr), plan_min_clearance);
+		return;
+	}
+
+	run_plan_fallbacks(plan_min_clearance);
+}
+
+void ShipNavigator::apply_planned_path(const PathResult &result, float plan_min_clearance,
+									   uint64_t threat_version) {
+	refine_active_ = false;
+	if (threat_bin_) threat_last_version_ = threat_version;
+	commit_hpa_result(result, plan_min_clearance);
+}
+
+bool ShipNavigator::commit_hpa_result(PathResult pr, float plan_min_clearance) {
+	if (pr.valid && !pr.waypoints.empty()) {
+		// Always end at the exact destination — HPA* snaps to grid nodes
+		// so the final grid node may not be target.position.
+		if (pr.waypoints.back().distance_to(target.position) > 1.0f) {
+			pr.waypoints.push_back(target.position);
+			pr.flags.push_back(WP_NONE);
 		}
-		// No prior path available — fall through to straight-line fallbacks.
+		return accept_plan_result(pr);
+	}
+	// HPA* failed — retain the previous path rather than overwriting it with
+	// a straight-line fallback.  The ship continues following its existing
+	// route while navigate_to() retries on the next call.
+	if (path_valid && !current_path.waypoints.empty()) {
+		return false;
+	}
+	// No prior path available — fall through to straight-line fallbacks.
+	run_plan_fallbacks(plan_min_clearance);
+	return false;
+}
+
+// The pulled prefix only grows and the unpulled tail only shrinks, so the
+// ship keeps its place by route index across the swap.
+void ShipNavigator::advance_refinement() {
+	auto t0 = std::chrono::steady_clock::now();
+	if (!path_valid || !hpa_graph_.is_valid()) {
+		refine_active_ = false;
+		return;
+	}
+	const int route_index = refine_job_.route_index(current_wp_index);
+	if (!hpa_graph_->refine_path(refine_job_, refine_budget_us_)) {
+		// Clusters rescanned under the job; check_map_changes() replans if
+		// the patch touched the route
+		refine_active_ = false;
+		return;
+	}
+
+	PathResult pr = refine_job_.current();
+	if (pr.waypoints.empty()) {
+		refine_active_ = false;
+		return;
+	}
+	if (pr.waypoints.back().distance_to(target.position) > 1.0f) {
+		pr.waypoints.push_back(target.position);
+		pr.flags.push_back(WP_NONE);
 	}
+	current_path = std::move(pr);
+	current_wp_index = refine_job_.waypoint_at_or_after(route_index);
+	if (refine_job_.done) refine_active_ = false;
+
+	timing_plan_us += std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - t0).count();
+}
 
+void ShipNavigator::run_plan_fallbacks(float plan_min_clearance) {
 	// -----------------------------------------------------------------------
 	// Straight-line fallback (terrain-only, no threats)
 	// -----------------------------------------------------------------------
@@ -2384,7 +2499,7 @@ bool ShipNavigator::is_target_behind_within_reverse_zone(Vector2 target_pos) con
 // Path acceptance (oscillation check + commit)
 // ============================================================================
 
-void ShipNavigator::accept_plan_result(const PathResult &forward_result) {
+bool ShipNavigator::accept_plan_result(const PathResult &forward_result) {
 	if (forward_result.valid && !forward_result.waypoints.empty()) {
 		bool should_accept = true;
 
@@ -2425,6 +2540,7 @@ void ShipNavigator::accept_plan_result(const PathResult &forward_result) {
 				current_wp_index = 1;
 			}
 		}
+		return should_accept;
 	} else {
 		// Path planning came back invalid (no route found or D* Lite not yet
 		// converged to a solution).  Prefer keeping the previous path — the
@@ -2444,6 +2560,58 @@ void ShipNavigator::accept_plan_result(const PathResult &forward_result) {
 		}
 		// else: keep current_path and path_valid unchanged
 	}
+	return false;
+}
+
+// Liang–Barsky clip: does segment a-b touch the rect?
+static inline bool segment_hits_rect(Vector2 a, Vector2 b, const Rect2 &r) {
+	Vector2 d = b - a;
+	const float p[4] = { -d.x, d.x, -d.y, d.y };
+	const float q[4] = {
+		a.x - r.position.x, r.position.x + r.size.x - a.x,
+		a.y - r.position.y, r.position.y + r.size.y - a.y,
+	};
+	float t0 = 0.0f, t1 = 1.0f;
+	for (int i = 0; i < 4; i++) {
+		if (p[i] == 0.0f) {
+			if (q[i] < 0.0f) return false;
+			continue;
+		}
+		float t = q[i] / p[i];
+		if (p[i] < 0.0f) t0 = std::max(t0, t);
+		else t1 = std::min(t1, t);
+		if (t0 > t1) return false;
+	}
+	return true;
+}
+
+void ShipNavigator::check_map_changes() {
+	int x0, z0, x1, z1;
+	bool known = map->get_changed_cells_since(map_version_seen_, x0, z0, x1, z1);
+	map_version_seen_ = static_cast<uint64_t>(map->get_version());
+	if (known && x0 > x1) return;
+
+	// Changed cells padded by the hull clearance plus one cell of SDF blur
+	bool crosses = !known;
+	if (known) {
+		float cs = map->get_cell_size_value();
+		float pad = get_ship_clearance() + cs;
+		Rect2 changed(map->get_min_x() + x0 * cs - pad, map->get_min_z() + z0 * cs - pad,
+					  (x1 - x0) * cs + 2.0f * pad, (z1 - z0) * cs + 2.0f * pad);
+		Vector2 from = state.position;
+		for (int i = current_wp_index; i < (int)current_path.waypoints.size() && !crosses; i++) {
+			crosses = segment_hits_rect(from, current_path.waypoints[i], changed);
+			from = current_path.waypoints[i];
+		}
+	}
+	if (!crosses) return;
+
+	// Drop the old route so accept_plan_result's hysteresis cannot keep it
+	auto t0 = std::chrono::steady_clock::now();
+	path_valid = false;
+	timing_replan_reason = 1;
+	run_plan_sync();
+	timing_plan_us = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - t0).count();
 }
 
 // ============================================================================
@@ -2701,6 +2869,16 @@ float ShipNavigator::check_arc_collision(const std::vector<ArcPoint> &arc,
 	if (map.is_null() || !map->is_built()) return std::numeric_limits<float>::infinity();
 	if (arc.empty()) return std::numeric_limits<float>::infinity();
 
+	// Sample the whole arc in one batch
+	const int n = static_cast<int>(arc.size());
+	arc_sample_points_.resize(n);
+	arc_sample_sdf_.resize(n);
+	for (int i = 0; i < n; i++) {
+		arc_sample_points_[i] = arc[i].position;
+	}
+	map->sample_distances(arc_sample_points_.data(), n, arc_sample_sdf_.data());
+	const std::vector<float> &arc_sdf = arc_sample_sdf_;
+
 	float first_soft_violation = std::numeric_limits<float>::infinity();
 	bool arc_exits_soft_zone = false;
 	bool was_in_soft_zone = false;
@@ -2708,14 +2886,14 @@ float ShipNavigator::check_arc_collision(const std::vector<ArcPoint> &arc,
 
 	for (size_t i = 0; i < arc.size(); i++) {
 		const auto &pt = arc[i];
-		float sdf = map->get_distance(pt.position.x, pt.position.y);
+		float sdf = arc_sdf[i];
 
 		if (sdf < hard_clearance) {
 			if (pt.time == 0.0f) {
 				// Already inside hard clearance — find time to exit and negate it.
 				// More negative = longer to escape = worse.
 				for (size_t j = i + 1; j < arc.size(); j++) {
-					float exit_sdf = map->get_distance(arc[j].position.x, arc[j].position.y);
+					float exit_sdf = arc_sdf[j];
 					if (exit_sdf >= hard_clearance) {
 						return -arc[j].time;
 					}
@@ -2746,7 +2924,7 @@ float ShipNavigator::check_arc_collision(const std::vector<ArcPoint> &arc,
 		// soft zone.  Find exit time and negate it, same as the hard case.
 		if (first_soft_violation == 0.0f) {
 			for (size_t i = 0; i < arc.size(); i++) {
-				float sdf = map->get_distance(arc[i].position.x, arc[i].position.y);
+				float sdf = arc_sdf[i];
 				if (sdf >= soft_clearance) {
 					return -arc[i].time;
 				}
@@ -17,6 +17,7 @@
 #include "nav_types.h"
 #include "navigation_map.h"
 #include "hpa_graph.h"
+#include "path_planner.h"
 #include "threat_registry.h"
 
 namespace godot {
@@ -52,13 +53,24 @@ private:
 	PathResult current_path;          // From NavigationMap::find_path_internal
 	int current_wp_index;             // Index into current_path.waypoints
 	bool path_valid;
+	uint64_t map_version_seen_ = 0;   // map->get_version() the path was checked against
 
 	// --- HPA* (Hierarchical A*) pathfinding ---
 	// When set, strategic path planning uses hierarchical A* for fast
 	// threat-aware routing.  Dynamic obstacles are forwarded to hpa_graph_
-	// for cluster-level blocking, giving O(clusters) updates instead of O(nodes).
+	// for cluster-level soft costs, giving O(clusters) updates instead of O(nodes).
 	Ref<HpaGraph> hpa_graph_;
 
+	// When set and running, HPA* queries go to the planner's workers and the
+	// result comes back through apply_planned_path() on a later frame.
+	Ref<PathPlanner> path_planner_;
+
+	// Budgeted synchronous planning (refine_budget_us_ > 0): the unpulled
+	// portal route is followed at once and string-pulled a slice per frame.
+	float refine_budget_us_ = 0.0f;
+	HpaPathJob refine_job_;
+	bool refine_active_ = false;  // current_path is refine_job_.current()
+
 	enum class DesiredDirection : int {
 		FORWARD = 0,
 		BACKWARD = 1,
@@ -76,7 +88,7 @@ private:
 	float timing_avoidance_us;
 	float timing_plan_us;
 	float timing_steering_us;
-	int timing_replan_reason;  // 0=none (all non-zero codes currently unused)
+	int timing_replan_reason;  // 0=none, 1=land patch crossed the path
 	int timing_plan_phase_val; // always 0; kept for GDScript compatibility
 
 	// --- Runtime performance aggregates (spike-oriented) ---
@@ -241,6 +253,10 @@ private:
 	// --- Debug: torpedo virtual threat points ---
 	Array get_debug_torpedo_threat_points() const;
 
+	// --- Scratch for check_arc_collision (batched SDF samples per arc) ---
+	mutable std::vector<Vector2> arc_sample_points_;
+	mutable std::vector<float> arc_sample_sdf_;
+
 	// --- Internal methods ---
 
 	float get_ship_clearance() const;
@@ -292,7 +308,8 @@ private:
 
 	// --- Path management ---
 
-	void accept_plan_result(const PathResult &forward_result);
+	// Returns true when forward_result became current_path
+	bool accept_plan_result(const PathResult &forward_result);
 
 	// --- Two-state update methods ---
 
@@ -303,6 +320,17 @@ private:
 	// --- Plan management ---
 	void run_plan_sync(); // synchronous HPA* planning, called from navigate_to()
 
+	// Commit an HPA* result (or keep the old path / fall back when it failed).
+	// Returns true when pr became current_path.
+	bool commit_hpa_result(PathResult pr, float plan_min_clearance);
+
+	// Pull the next slice of refine_job_ into current_path
+	void advance_refinement();
+	void run_plan_fallbacks(float plan_min_clearance);
+
+	// Replan when a land patch changed cells near the remaining path
+	void check_map_changes();
+
 	// --- Steering output helpers ---
 
 	void set_steering_output(float rudder, int throttle, bool collision);
@@ -323,6 +351,21 @@ public:
 	void set_hpa_graph(Ref<HpaGraph> graph);
 	Ref<HpaGraph> get_hpa_graph() const { return hpa_graph_; }
 
+	/// Plan on a PathPlanner's worker threads instead of inside navigate_to().
+	/// Pass an invalid Ref<> to plan synchronously again.
+	void set_path_planner(Ref<PathPlanner> planner);
+	Ref<PathPlanner> get_path_planner() const { return path_planner_; }
+
+	/// Called by PathPlanner::dispatch() with the result of this navigator's
+	/// latest request, planned at plan_min_clearance.
+	void apply_planned_path(const PathResult &result, float plan_min_clearance, uint64_t threat_version);
+
+	/// Per-frame budget for synchronous HPA* planning.  0 (default) plans
+	/// whole paths inside navigate_to(); above 0 the route is followed
+	/// unpulled and refined for about this long each frame.
+	void set_path_refine_budget_us(float budget_us);
+	float get_path_refine_budget_us() const { return refine_budget_us_; }
+
 	void set_ship_params(
 		float turning_circle_radius,
 		float rudder_response_time,
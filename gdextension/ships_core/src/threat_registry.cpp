@@ -7,6 +7,14 @@
 
 using namespace godot;
 
+// Bin versions come from one process-wide counter, so a bin recreated under
+// the same (team, radius_bin) never repeats a version a cache already holds
+// (HpaGraph::get_threat_set keys its sets on them).
+static uint64_t next_bin_version() {
+	static uint64_t counter = 0;
+	return ++counter;
+}
+
 void ThreatRegistry::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("update_team", "team_id", "ids", "positions_with_decay"),
 		&ThreatRegistry::update_team);
@@ -144,5 +152,5 @@ void ThreatRegistry::rebuild_bin(ThreatBin* bin) {
 	}
 
 	bin->threats = std::move(new_threats);
-	bin->version += 1;
+	bin->version = next_bin_version();
 }
@@ -33,7 +33,7 @@ struct ThreatBin {
 	int radius_bin;          // ceil(effective_radius / RADIUS_BIN_SIZE)
 	float radius;            // canonical radius for this bin (radius_bin * RADIUS_BIN_SIZE)
 	int refcount = 0;
-	uint64_t version = 0;    // bumped on every rebuild — consumers diff this
+	uint64_t version = 0;    // new unique value on every rebuild — consumers diff this
 	std::vector<ThreatCircle> threats;
 };
 
@@ -367,15 +367,15 @@ float WaypointGraph::compute_edge_min_sdf(Vector2 a, Vector2 b) const {
 	if (step < 1.0f) step = 1.0f;
 	int steps = static_cast<int>(dist / step) + 2;
 
-	float min_val = nav_map_->get_distance(a.x, a.y);
-	for (int i = 1; i <= steps; i++) {
+	// Endpoint a plus every sub-step, sampled in one batch
+	std::vector<Vector2> pts(steps + 1);
+	std::vector<float> sdf(steps + 1);
+	for (int i = 0; i <= steps; i++) {
 		float t = static_cast<float>(i) / static_cast<float>(steps);
-		float px = a.x + (b.x - a.x) * t;
-		float py = a.y + (b.y - a.y) * t;
-		float s = nav_map_->get_distance(px, py);
-		if (s < min_val) min_val = s;
+		pts[i] = Vector2(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t);
 	}
-	return min_val;
+	nav_map_->sample_distances(pts.data(), steps + 1, sdf.data());
+	return *std::min_element(sdf.begin(), sdf.end());
 }
 
 bool WaypointGraph::corridor_clear(Vector2 a, Vector2 b, float clearance) const {
@@ -0,0 +1,59 @@
+extends SceneTree
+
+## Prebake NavigationCache files for every map so the server skips the SDF/HPA build.
+## Run headless from the project root after changing island geometry:
+##   godot --headless --script res://src/Maps/prebake_nav_cache.gd
+## Writes res://assets/nav_cache/<map>.navcache for each scene in MAP_SCENES.
+## Settings must match what server.gd passes to NavigationMapManager.build_map(),
+## otherwise the cache key will not match and the server rebuilds at load.
+
+const NavManager := preload("res://src/autoload/navigation_map_manager.gd")
+
+const MAP_SCENES := [
+	"res://src/Maps/map.tscn",
+	"res://src/Maps/map2.tscn",
+]
+const MAP_BOUNDS := Rect2(-17500, -17500, 35000, 35000)
+const CELL_SIZE := 50.0
+
+func _initialize() -> void:
+	var baked := 0
+	for scene_path in MAP_SCENES:
+		if _bake_scene(scene_path):
+			baked += 1
+	print("[prebake_nav_cache] %d map(s) baked into %s" % [baked, NavManager.PREBAKED_CACHE_DIR])
+	quit()
+
+func _bake_scene(scene_path: String) -> bool:
+	var scene: PackedScene = load(scene_path)
+	if scene == null:
+		return false
+	var map := scene.instantiate()
+	if not (map is Map):
+		push_warning("[prebake_nav_cache] %s: root is not a Map, skipping" % scene_path)
+		map.free()
+		return false
+
+	# Map._ready() collects the islands and global transforms need the tree
+	root.add_child(map)
+
+	var bodies: Array[Node3D] = []
+	for body in map.islands:
+		if is_instance_valid(body):
+			bodies.append(body)
+
+	var ok := false
+	if bodies.is_empty():
+		push_warning("[prebake_nav_cache] %s: no islands, skipping" % scene_path)
+	else:
+		var start_time = Time.get_ticks_msec()
+		var nav_map: NavigationMap = NavManager.bake_map(bodies, MAP_BOUNDS, CELL_SIZE)
+		var hpa: HpaGraph = NavManager.bake_hpa_graph(nav_map)
+		var key := NavigationCache.compute_key(bodies, MAP_BOUNDS, CELL_SIZE, NavManager.DEFAULT_MIN_SHIP_RADIUS)
+		var cache_name := scene_path.get_file().get_basename()
+		ok = NavigationCache.save_cache(NavManager.cache_path(NavManager.PREBAKED_CACHE_DIR, cache_name), key, nav_map, hpa)
+		print("[prebake_nav_cache] %s: %s in %.1f ms" % [scene_path, "baked" if ok else "FAILED", Time.get_ticks_msec() - start_time])
+
+	root.remove_child(map)
+	map.free()
+	return ok
@@ -1,16 +1,40 @@
 extends Node
 class_name GPUProjectileRenderer
 ## GPU-based projectile renderer that reads shell positions from a texture
-## The projectile_manager updates positions every frame via update_shell_position()
+## Shells fired by the projectile_manager upload their launch state once through
+## apply_shell_updates() and the shader evaluates the drag trajectory every frame.
+## Shells driven by update_shell_positions() (replays) use the explicit position instead.
+##
+## Slots are either allocated here (fire_shell/destroy_shell) or owned by the caller
+## (UPDATE_FIRE/UPDATE_DESTROY records); a renderer instance should use only one of the two.
 
 const MAX_SHELLS: int = 16384  # Maximum concurrent shells; must not exceed max texture dimension
 const DATA_WIDTH: int = 2     # 2 pixels per shell for visual data (color, size)
+const LAUNCH_WIDTH: int = 2   # 2 pixels per shell for launch state (start, velocity)
+const MAX_SHELL_PARAMS: int = 1024  # Distinct ShellParams rows (_ProjectileManager::TRAIL_MAX_PARAMS)
+
+# Position texture alpha: how the shader places a shell
+const MODE_INACTIVE: float = 0.0
+const MODE_EXPLICIT: float = 1.0  # position.xyz written by update_shell_position()
+const MODE_ANALYTIC: float = 2.0  # evaluated from launch state + shell_time
+
+# apply_shell_updates() record layout (must match _ProjectileManager TRAIL_RECORD_*)
+const UPDATE_STRIDE: int = 12
+const UPDATE_PARAMS: int = 1  # [kind, param_id, drag, vt, tau, ...]
+const UPDATE_LAUNCH: int = 2  # [kind, slot, start.xyz, start_time, vel.xyz, param_id, ...]
+const UPDATE_FIRE: int = 3    # [kind, slot, color.rgba, size, shell_type, ...]
+const UPDATE_DESTROY: int = 4 # [kind, slot, ...]
 
 var multi_mesh_instance: MultiMeshInstance3D
+var shell_positions: PackedFloat32Array  # Backing store of shell_position_image, 4 floats per shell
 var shell_position_image: Image
 var shell_position_texture: ImageTexture
 var shell_data_image: Image
 var shell_data_texture: ImageTexture
+var shell_launch_image: Image
+var shell_launch_texture: ImageTexture
+var shell_param_image: Image
+var shell_param_texture: ImageTexture
 var shader_material: ShaderMaterial
 var is_ready: bool = false
 
@@ -23,15 +47,21 @@ var active_shell_count: int = 0
 # Batched update tracking - defer texture upload to _process
 var position_texture_dirty: bool = false
 var data_texture_dirty: bool = false
+var launch_texture_dirty: bool = false
+var param_texture_dirty: bool = false
 
 # Reference to camera for potential future use
 var camera: Camera3D = null
 
+# Shell clock for MODE_ANALYTIC shells: flight time = (shell_time - start_time) * time_multiplier
+var time_multiplier: float = 1.0
+
 signal shell_destroyed(id: int)
 
 func _ready():
 	_setup_position_texture()
 	_setup_data_texture()
+	_setup_launch_textures()
 	_setup_mesh_instance()
 
 	# Initialize slot tracking
@@ -41,13 +71,12 @@ func _ready():
 
 func _setup_position_texture():
 	# Create image for shell positions (1 pixel per shell, RGBAF format for precision)
-	# Format: position.xyz, active (0/1)
-	shell_position_image = Image.create(1, MAX_SHELLS, false, Image.FORMAT_RGBAF)
-
-	# Initialize all shells as inactive at origin
-	var inactive_color = Color(0, 0, 0, 0)  # position = 0,0,0, active = 0
-	for y in range(MAX_SHELLS):
-		shell_position_image.set_pixel(0, y, inactive_color)
+	# Format: position.xyz, mode
+	# Writes go straight into shell_positions; the image is rebuilt from it once per frame
+	shell_positions = PackedFloat32Array()
+	shell_positions.resize(MAX_SHELLS * 4)  # All shells inactive at origin
+	shell_position_image = Image.create_from_data(1, MAX_SHELLS, false, Image.FORMAT_RGBAF,
+		shell_positions.to_byte_array())
 
 	# Create texture from image
 	shell_position_texture = ImageTexture.create_from_image(shell_position_image)
@@ -68,6 +97,18 @@ func _setup_data_texture():
 	# Create texture from image
 	shell_data_texture = ImageTexture.create_from_image(shell_data_image)
 
+func _setup_launch_textures():
+	# Launch state (LAUNCH_WIDTH x MAX_SHELLS, RGBAF)
+	# Pixel 0: start_position.xyz, start_time
+	# Pixel 1: launch_velocity.xyz, param_id
+	shell_launch_image = Image.create(LAUNCH_WIDTH, MAX_SHELLS, false, Image.FORMAT_RGBAF)
+	shell_launch_texture = ImageTexture.create_from_image(shell_launch_image)
+
+	# Drag parameters shared by every shell of one ShellParams (1 x MAX_SHELL_PARAMS, RGBAF)
+	# Pixel 0: drag, vt, tau, reserved
+	shell_param_image = Image.create(1, MAX_SHELL_PARAMS, false, Image.FORMAT_RGBAF)
+	shell_param_texture = ImageTexture.create_from_image(shell_param_image)
+
 func _setup_mesh_instance():
 	# Load the GPU shader
 	var shader = load("res://src/artillary/GPUProjectileShader.gdshader")
@@ -80,6 +121,10 @@ func _setup_mesh_instance():
 	shader_material.set_shader_parameter("shell_data_texture", shell_data_texture)
 	shader_material.set_shader_parameter("texture_width", DATA_WIDTH)
 	shader_material.set_shader_parameter("max_shells", MAX_SHELLS)
+	shader_material.set_shader_parameter("shell_launch_texture", shell_launch_texture)
+	shader_material.set_shader_parameter("shell_param_texture", shell_param_texture)
+	shader_material.set_shader_parameter("max_shell_params", MAX_SHELL_PARAMS)
+	shader_material.set_shader_parameter("shell_time_multiplier", time_multiplier)
 	shader_material.set_shader_parameter("albedo", Color(3.29, 3.28, 3.28, 1.0))  # HDR albedo for glow
 
 	# Load particle texture
@@ -122,6 +167,7 @@ func _process(_delta: float):
 
 	# Batch texture updates - only upload once per frame regardless of how many shells changed
 	if position_texture_dirty:
+		shell_position_image.set_data(1, MAX_SHELLS, false, Image.FORMAT_RGBAF, shell_positions.to_byte_array())
 		shell_position_texture.update(shell_position_image)
 		position_texture_dirty = false
 
@@ -129,6 +175,14 @@ func _process(_delta: float):
 		shell_data_texture.update(shell_data_image)
 		data_texture_dirty = false
 
+	if launch_texture_dirty:
+		shell_launch_texture.update(shell_launch_image)
+		launch_texture_dirty = false
+
+	if param_texture_dirty:
+		shell_param_texture.update(shell_param_image)
+		param_texture_dirty = false
+
 ## Fire a new shell and return its ID
 ## Returns -1 if no slots available
 func fire_shell(start_position: Vector3, _launch_velocity: Vector3, _drag: float,
@@ -142,8 +196,8 @@ func fire_shell(start_position: Vector3, _launch_velocity: Vector3, _drag: float
 		push_warning("GPUProjectileRenderer: No available shell slots!")
 		return -1
 
-	# Write initial position to position texture (active = 1.0)
-	shell_position_image.set_pixel(0, slot, Color(start_position.x, start_position.y, start_position.z, 1.0))
+	# Write initial position to position texture
+	_write_position(slot, start_position, MODE_EXPLICIT)
 
 	# Write shell visual data to data texture
 	# Pixel 0: color.rgba
@@ -159,7 +213,8 @@ func fire_shell(start_position: Vector3, _launch_velocity: Vector3, _drag: float
 	active_shell_count += 1
 	return slot
 
-## Update the position of a shell (called every frame by projectile_manager)
+## Update the position of a shell explicitly (replays; projectile_manager shells
+## are evaluated on the GPU from apply_shell_updates() instead)
 func update_shell_position(id: int, position: Vector3):
 	if id < 0 or id >= MAX_SHELLS:
 		return
@@ -167,12 +222,73 @@ func update_shell_position(id: int, position: Vector3):
 	if not shell_slots[id]:
 		return  # Shell not active
 
-	# Update position in position texture (keep active = 1.0)
-	shell_position_image.set_pixel(0, id, Color(position.x, position.y, position.z, 1.0))
+	# Update position in position texture
+	_write_position(id, position, MODE_EXPLICIT)
 
 	# Mark position texture as dirty
 	position_texture_dirty = true
 
+## Update many shell positions explicitly in one call (ids[i] -> positions[i])
+func update_shell_positions(ids: PackedInt32Array, positions: PackedVector3Array):
+	var count := mini(ids.size(), positions.size())
+	for i in range(count):
+		var id := ids[i]
+		if id < 0 or id >= MAX_SHELLS or not shell_slots[id]:
+			continue
+		_write_position(id, positions[i], MODE_EXPLICIT)
+	if count > 0:
+		position_texture_dirty = true
+
+## Advance the shell clock and apply fire/launch/destroy/param records in order
+## (one call per frame from projectile_manager). Records are UPDATE_STRIDE floats
+## each, see UPDATE_*. Slots in UPDATE_FIRE/UPDATE_DESTROY are owned by the caller.
+func apply_shell_updates(time: float, updates: PackedFloat32Array):
+	if not is_ready:
+		return
+
+	shader_material.set_shader_parameter("shell_time", time)
+
+	var record_count := updates.size() / UPDATE_STRIDE
+	for r in range(record_count):
+		var i := r * UPDATE_STRIDE
+		var kind := int(updates[i])
+		var index := int(updates[i + 1])
+		if kind == UPDATE_PARAMS:
+			if index < 0 or index >= MAX_SHELL_PARAMS:
+				continue
+			shell_param_image.set_pixel(0, index, Color(updates[i + 2], updates[i + 3], updates[i + 4], 0.0))
+			param_texture_dirty = true
+		elif kind == UPDATE_LAUNCH:
+			# Skip shells destroyed before their launch record was flushed
+			if index < 0 or index >= MAX_SHELLS or not shell_slots[index]:
+				continue
+			var start := Vector3(updates[i + 2], updates[i + 3], updates[i + 4])
+			shell_launch_image.set_pixel(0, index, Color(start.x, start.y, start.z, updates[i + 5]))
+			shell_launch_image.set_pixel(1, index, Color(updates[i + 6], updates[i + 7], updates[i + 8], updates[i + 9]))
+			_write_position(index, start, MODE_ANALYTIC)
+			launch_texture_dirty = true
+			position_texture_dirty = true
+		elif kind == UPDATE_FIRE:
+			if index < 0 or index >= MAX_SHELLS:
+				continue
+			if not shell_slots[index]:
+				shell_slots[index] = true
+				active_shell_count += 1
+			shell_data_image.set_pixel(0, index, Color(updates[i + 2], updates[i + 3], updates[i + 4], updates[i + 5]))
+			shell_data_image.set_pixel(1, index, Color(updates[i + 6], updates[i + 7], 0.0, 0.0))
+			# Hidden until its launch record or first explicit position arrives
+			_write_position(index, Vector3.ZERO, MODE_INACTIVE)
+			data_texture_dirty = true
+			position_texture_dirty = true
+		elif kind == UPDATE_DESTROY:
+			if index < 0 or index >= MAX_SHELLS or not shell_slots[index]:
+				continue
+			shell_slots[index] = false
+			active_shell_count -= 1
+			_write_position(index, Vector3.ZERO, MODE_INACTIVE)
+			position_texture_dirty = true
+			shell_destroyed.emit(index)
+
 ## Destroy a shell by ID
 func destroy_shell(id: int):
 	if id < 0 or id >= MAX_SHELLS:
@@ -181,8 +297,8 @@ func destroy_shell(id: int):
 	if not shell_slots[id]:
 		return  # Already destroyed
 
-	# Mark as inactive in position texture (set active = 0)
-	shell_position_image.set_pixel(0, id, Color(0.0, 0.0, 0.0, 0.0))
+	# Mark as inactive in position texture
+	_write_position(id, Vector3.ZERO, MODE_INACTIVE)
 
 	# Mark texture as dirty - will be uploaded in _process (batched)
 	position_texture_dirty = true
@@ -201,14 +317,23 @@ func is_shell_active(id: int) -> bool:
 func get_active_count() -> int:
 	return active_shell_count
 
-## Set shell time multiplier (no longer used, kept for API compatibility)
-func set_time_multiplier(_value: float):
-	pass
+## Set shell time multiplier used for MODE_ANALYTIC shells
+func set_time_multiplier(value: float):
+	time_multiplier = value
+	if shader_material:
+		shader_material.set_shader_parameter("shell_time_multiplier", time_multiplier)
 
 ## Set gravity (no longer used, kept for API compatibility)
 func set_gravity(_value: float):
 	pass
 
+func _write_position(slot: int, position: Vector3, mode: float):
+	var i := slot * 4
+	shell_positions[i] = position.x
+	shell_positions[i + 1] = position.y
+	shell_positions[i + 2] = position.z
+	shell_positions[i + 3] = mode
+
 func _allocate_slot() -> int:
 	# Try to reuse a freed slot first
 	if not free_slots.is_empty():
@@ -406,13 +406,15 @@ func fire(mod: TargetMod = null) -> void:
 		if !disabled && reload >= 1.0 and can_fire:
 			var muzzles_pos = get_muzzles_position()
 			var first_shell := true
-			for m in muzzles:
-				# var dispersed_velocity = get_params().calculate_dispersed_launch(_aim_point, muzzles_pos, get_shell(), mod)
-				var grouping = get_params().grouping * (mod.grouping if mod else 1.0)
-				var base_range = get_base_params()._range
-				var dispersed_velocity = dispersion_calculator.calculate_dispersed_launch(_aim_point, muzzles_pos, get_shell(), grouping, grouping, base_range, get_params().dispersion_, get_params().v_dispersion_, get_params().max_h_disp * (mod.h_spread if mod else 1.0), get_params().max_v_disp * (mod.v_spread if mod else 1.0))
+			# var dispersed_velocity = get_params().calculate_dispersed_launch(_aim_point, muzzles_pos, get_shell(), mod)
+			var grouping = get_params().grouping * (mod.grouping if mod else 1.0)
+			var base_range = get_base_params()._range
+			var salvo := dispersion_calculator.sample_salvo(muzzles.size(), _aim_point, muzzles_pos, get_shell(), grouping, base_range, get_params().dispersion_, get_params().v_dispersion_, get_params().max_h_disp * (mod.h_spread if mod else 1.0), get_params().max_v_disp * (mod.v_spread if mod else 1.0))
+			for muzzle_idx in salvo.size():
+				var m = muzzles[muzzle_idx]
+				var dispersed_velocity: Vector3 = salvo[muzzle_idx]
 				# var aim = ProjectilePhysicsWithDrag.calculate_launch_vector(m.global_position, _aim_point, get_shell().speed, get_shell().drag)
-				if dispersed_velocity != null:
+				if dispersed_velocity != Vector3.ZERO:
 					# Guns can't depress below MIN_ELEVATION_ANGLE. If the solution wants a
 					# steeper downward angle (too-close target), pitch the launch vector up
 					# to the limit — keeping speed and azimuth — so the shot goes higher.
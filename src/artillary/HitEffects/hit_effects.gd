@@ -50,6 +50,20 @@ func muzzle_blast_effect(pos: Vector3, basis: Basis, size: float) -> void:
 	offset.y = 0
 	WaveManager.add_muzzle_blast(Vector3(pos.x, 0.0, pos.z) + offset , size)
 
+## Batched variants, called once per frame by the projectile manager with that
+## frame's (already coalesced) hits. Normals may be unnormalized sums.
+func splash_effects(positions: PackedVector3Array, sizes: PackedFloat32Array) -> void:
+	for i in positions.size():
+		splash_effect(positions[i], sizes[i])
+
+func he_explosion_effects(positions: PackedVector3Array, sizes: PackedFloat32Array, dirs: PackedVector3Array) -> void:
+	for i in positions.size():
+		he_explosion_effect(positions[i], sizes[i], dirs[i].normalized())
+
+func sparks_effects(positions: PackedVector3Array, sizes: PackedFloat32Array, normals: PackedVector3Array) -> void:
+	for i in positions.size():
+		sparks_effect(positions[i], sizes[i], normals[i])
+
 func return_to_pool(effect: Node) -> void:
 	pass
 
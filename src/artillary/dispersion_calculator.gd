@@ -86,138 +86,32 @@ class_name DispersionCalculator
 # 	return dispersed * speed
 
 
-const SHELL_COUNT := 3
-const CITADEL_GUARANTEE_NUM := 4
-var citadel_guarantee_counter = 0
+# Salvo sampling (truncated-normal stratified axes, citadel guarantee, RNG)
+# lives in the native DispersionSampler; this wrapper keeps the script API.
+const SHELL_COUNT := DispersionSampler.SHELL_COUNT
+const CITADEL_GUARANTEE_NUM := DispersionSampler.CITADEL_GUARANTEE_NUM
 
-var _shell_index := 0
-var _h_offsets := PackedFloat64Array()
-var _v_offsets := PackedFloat64Array()
-var _sigma := 1.0
+var _sampler := DispersionSampler.new()
 
-# Citadel ellipse for post-processing (in normalised fraction space, set externally)
-var _citadel_h_frac := 0.5
-var _citadel_v_frac := 0.2
-var _citadel_guarantee_enabled := true
+var _citadel_guarantee_enabled := true:
+	set(value):
+		_citadel_guarantee_enabled = value
+		_sampler.set_citadel_guarantee_enabled(value)
 
 func _init(sigma: float = 1.0) -> void:
-	_sigma = maxf(sigma, 1.0)
-	# Force a fresh salvo on the first shot so it uses the gun's real sigma
-	# (passed into calculate_dispersed_launch) instead of a placeholder.
-	_shell_index = SHELL_COUNT
+	_sampler.set_sigma(sigma)
 
 
 func set_sigma(sigma: float) -> void:
-	_sigma = maxf(sigma, 1.0)
+	_sampler.set_sigma(sigma)
 
 
 ## Set citadel ellipse size as fractions of base_spread.
 ## e.g. for a ship that is half the dispersion width and 1/10 the height:
 ##   set_citadel_fractions(0.5, 0.1)
 func set_citadel_fractions(h_frac: float, v_frac: float) -> void:
-	_citadel_h_frac = maxf(h_frac, 0.01)
-	_citadel_v_frac = maxf(v_frac, 0.01)
-
-
-## erf approximation, max |error| < 1.5e-7  (Abramowitz & Stegun 7.1.26).
-static func _erf(x: float) -> float:
-	const P  := 0.3275911
-	const A1 := 0.254829592
-	const A2 := -0.284496736
-	const A3 := 1.421413741
-	const A4 := -1.453152027
-	const A5 := 1.061405429
-	var t := 1.0 / (1.0 + P * absf(x))
-	var poly := t * (A1 + t * (A2 + t * (A3 + t * (A4 + t * A5))))
-	return signf(x) * (1.0 - poly * exp(-x * x))
-
-
-## erfinv approximation, max |error| < 1.2e-4  (Winitzki 2008, eq. 4).
-static func _erfinv(x: float) -> float:
-	const A := 0.147
-	const TWO_OVER_PI_A := 2.0 / (PI * A)
-	var w := log(maxf(1.0 - x * x, 1e-30))
-	var inner := TWO_OVER_PI_A + w * 0.5
-	return signf(x) * sqrt(sqrt(inner * inner - w / A) - inner)
-
-
-## Generate SHELL_COUNT independent samples from N(0, 1/s²) truncated to [-1, 1].
-## Stratified across SHELL_COUNT equal CDF bins then Fisher-Yates shuffled.
-## With SHELL_COUNT = 4, bins [0,.25) [.25,.5) [.5,.75) [.75,1) map to
-## large-negative, small-negative, small-positive, large-positive — guaranteeing
-## exactly 2 negative + 2 positive and 2 inner + 2 outer values per call.
-## erf_bound = erf(s / sqrt(2)), precomputed by the caller.
-func _generate_axis(s: float, erf_bound: float) -> PackedFloat64Array:
-	var arr := PackedFloat64Array()
-	arr.resize(SHELL_COUNT)
-	var inv_s_sqrt2 := sqrt(2.0) / s
-	for i in SHELL_COUNT:
-		var u_low  := float(i)     / SHELL_COUNT
-		var u_high := float(i + 1) / SHELL_COUNT
-		var u := u_low + randf() * (u_high - u_low)
-		# Invert the CDF of the truncated Gaussian on [-1, 1]:
-		#   F(x) = 0.5 + 0.5 * erf(x * s / sqrt(2)) / erf_bound
-		#   x    = sqrt(2)/s * erfinv(erf_bound * (2u - 1))
-		arr[i] = inv_s_sqrt2 * _erfinv(erf_bound * (2.0 * u - 1.0))
-	for i in range(SHELL_COUNT - 1, 0, -1):
-		var j := randi_range(0, i)
-		var tmp := arr[i]
-		arr[i] = arr[j]
-		arr[j] = tmp
-	return arr
-
-
-func _new_salvo(sigma: float) -> void:
-	_shell_index = 0
-	var s := maxf(sigma, 0.01)
-	# erf(s / sqrt(2)) = fraction of the full Gaussian within ±1 std-dev of the
-	# truncation boundary; used as the CDF normalisation constant for each axis.
-	var erf_bound := _erf(s / sqrt(2.0))
-	_h_offsets = _generate_axis(s, erf_bound)
-	_v_offsets = _generate_axis(s, erf_bound)
-	citadel_guarantee_counter += SHELL_COUNT
-
-	if _citadel_guarantee_enabled and citadel_guarantee_counter >= CITADEL_GUARANTEE_NUM:
-		_apply_citadel_guarantee()
-		citadel_guarantee_counter -= CITADEL_GUARANTEE_NUM
-
-
-# Tests whether any shell in the current salvo will land inside the citadel
-# ellipse, and only nudges a shell inward if none do. Offsets are already in
-# normalised [-1, 1] space, matching what calculate_dispersed_launch() uses.
-func _apply_citadel_guarantee() -> void:
-	var ea := _citadel_h_frac
-	var eb := _citadel_v_frac
-	if ea <= 0.0 or eb <= 0.0:
-		return
-
-	var any_inside := false
-	var closest_idx := 0
-	var closest_d := INF
-
-	for i in SHELL_COUNT:
-		var h_frac := _h_offsets[i]
-		var v_frac := _v_offsets[i]
-		var d := (h_frac * h_frac) / (ea * ea) + (v_frac * v_frac) / (eb * eb)
-		if d <= 1.0:
-			any_inside = true
-			break
-		if d < closest_d:
-			closest_d = d
-			closest_idx = i
-
-	if not any_inside:
-		var h_frac := _h_offsets[closest_idx]
-		var new_h: float
-		if absf(h_frac) > ea:
-			new_h = signf(h_frac) * ea * pow(randf(), 1.0)
-		else:
-			new_h = h_frac
-		var v_max := eb * sqrt(1.0 - (new_h / ea) * (new_h / ea))
-		var v_sign := 1.0 if randf() < 0.5 else -1.0
-		var new_v := v_sign * pow(randf(), 1.6) * v_max
-		_h_offsets[closest_idx] = new_h
-		_v_offsets[closest_idx] = new_v
+	_sampler.set_citadel_fractions(h_frac, v_frac)
+
 
 ## Perturbs a launch vector by applying dispersion as world-space offsets to the aim point.
 ## h = lateral (perpendicular to aim in horizontal plane)
@@ -228,13 +122,6 @@ func _apply_citadel_guarantee() -> void:
 ## _sigma_v = reserved for future per-axis sigma asymmetry; unused for now.
 ## h_dispersion_curve / max_h_disp = curve + scale for horizontal dispersion vs. range.
 ## v_dispersion_curve / max_v_disp = curve + scale for vertical dispersion vs. range.
-func _sample_dispersion(curve: Curve, t: float, max_disp: float) -> float:
-	if t <= 1.0:
-		return curve.sample(t) * max_disp
-	var slope := curve.get_point_left_tangent(curve.point_count - 1)
-	return (curve.sample(1.0) + slope * (t - 1.0)) * max_disp
-
-
 func calculate_dispersed_launch(
 		aim_point: Vector3,
 		gun_position: Vector3,
@@ -245,37 +132,27 @@ func calculate_dispersed_launch(
 		h_dispersion_curve: Curve,
 		v_dispersion_curve: Curve,
 		max_h_disp: float,
-		max_v_disp: float) -> Vector3:
-
-	var dist_to_target := (aim_point - gun_position).length()
-	var t := maxf(dist_to_target / max_range, 0.0)
-	var dispersion_h_m := _sample_dispersion(h_dispersion_curve, t, max_h_disp)
-	var dispersion_v_m := _sample_dispersion(v_dispersion_curve, t, max_v_disp)
-
-	if _shell_index >= SHELL_COUNT:
-		_new_salvo(sigma_h)
-
-	var h_offset := _h_offsets[_shell_index]
-	var v_offset := _v_offsets[_shell_index]
-	_shell_index += 1
-
-	var h_world := h_offset * dispersion_h_m * 0.5
-	var v_world := v_offset * dispersion_v_m * 0.5
-
-	var forward := (aim_point - gun_position).normalized()
-	# Fires straight up/down have no horizontal aim direction to build a
-	# lateral axis from - fall back to an arbitrary axis perpendicular to
-	# forward instead of normalizing a zero vector (which left right/up as
-	# zero and silently collapsed all shells onto the same point).
-	var right := forward.cross(Vector3.UP)
-	if right.length_squared() < 0.0001:
-		right = forward.cross(Vector3.RIGHT)
-	right = right.normalized()
-	var up := right.cross(forward).normalized()
-	var dispersed_aim := aim_point + right * h_world + up * v_world
-	var a = ProjectilePhysicsWithDragV2.calculate_launch_vector(gun_position, dispersed_aim, shell_params)
-	return a[0]
+		max_v_disp: float) -> Variant:
+	return _sampler.calculate_dispersed_launch(aim_point, gun_position, shell_params,
+			sigma_h, _sigma_v, max_range, h_dispersion_curve, v_dispersion_curve, max_h_disp, max_v_disp)
+
+
+## Batch version of calculate_dispersed_launch for n shells at the same aim point.
+## Entries without a firing solution are Vector3.ZERO.
+func sample_salvo(
+		n: int,
+		aim_point: Vector3,
+		gun_position: Vector3,
+		shell_params: ShellParams,
+		sigma_h: float,
+		max_range: float,
+		h_dispersion_curve: Curve,
+		v_dispersion_curve: Curve,
+		max_h_disp: float,
+		max_v_disp: float) -> PackedVector3Array:
+	return _sampler.sample_salvo(n, sigma_h, aim_point, gun_position, shell_params,
+			max_range, h_dispersion_curve, v_dispersion_curve, max_h_disp, max_v_disp)
 
 
 func get_inner_shell_count() -> int:
-	return _shell_index
+	return _sampler.get_inner_shell_count()
@@ -8,39 +8,64 @@ extends Node
 ## Usage:
 ##   NavigationMapManager.build_map(island_bodies, map_bounds)  — call once after map loads
 ##   NavigationMapManager.get_map()                              — returns the shared NavigationMap
+##
+## Passing a cache_name to build_map() loads the SDF and HPA clusters from a NavigationCache
+## file instead of rebuilding them: first the prebaked res://assets/nav_cache/<name>.navcache
+## (see src/Maps/prebake_nav_cache.gd), then user://nav_cache/<name>.navcache, which is
+## written after every cold build.  A cache whose key no longer matches the island geometry
+## or build settings is ignored.
 
 var _map: NavigationMap = null
 var _waypoint_graph: WaypointGraph = null
 var _hpa_graph: HpaGraph = null
+var _path_planner: PathPlanner = null
 var _build_time_ms: float = 0.0
 var _is_built: bool = false
 
 ## Default minimum ship radius for waypoint graph generation (smallest ship beam / 2).
 const DEFAULT_MIN_SHIP_RADIUS := 25.0
 
+## Prebaked caches shipped with the game.
+const PREBAKED_CACHE_DIR := "res://assets/nav_cache"
+## Caches written at runtime after a cold build.
+const USER_CACHE_DIR := "user://nav_cache"
+
 ## Build the navigation map from island collision shapes.
 ## island_bodies: Array of StaticBody3D nodes representing islands (with CollisionShape3D children)
 ## map_bounds: Rect2 defining the playable area in XZ space (position = min corner, size = extent)
 ## cell_size: SDF grid cell size in meters (default 50.0, matching existing nav mesh cell size)
-func build_map(island_bodies: Array[StaticBody3D], map_bounds: Rect2, cell_size: float = 50.0) -> void:
+## cache_name: if set, load/save the built map via NavigationCache under this name
+func build_map(island_bodies: Array[StaticBody3D], map_bounds: Rect2, cell_size: float = 50.0,
+			   cache_name: String = "") -> void:
 	var start_time = Time.get_ticks_msec()
 
-	_map = NavigationMap.new()
-	_map.set_bounds(
-		map_bounds.position.x,
-		map_bounds.position.y,
-		map_bounds.end.x,
-		map_bounds.end.y
-	)
-	_map.set_cell_size(cell_size)
-
 	# Convert typed array to the untyped Array<Node3D> expected by the C++ method
 	var bodies_array: Array[Node3D] = []
 	for body in island_bodies:
 		if is_instance_valid(body):
 			bodies_array.append(body)
 
-	_map.build_from_collision_shapes(bodies_array)
+	var cache_key := 0
+	if cache_name != "":
+		cache_key = NavigationCache.compute_key(bodies_array, map_bounds, cell_size, DEFAULT_MIN_SHIP_RADIUS)
+		var cached := _load_cache(cache_name, cache_key)
+		if not cached.is_empty():
+			_map = cached["map"]
+			_hpa_graph = cached["hpa"]
+			_build_time_ms = Time.get_ticks_msec() - start_time
+			_is_built = true
+			print("[NavigationMapManager] Map loaded from cache '%s' in %.1f ms — %d islands, grid %dx%d (cell_size=%.0fm)" % [
+				cache_name,
+				_build_time_ms,
+				_map.get_island_count(),
+				_map.get_grid_width(),
+				_map.get_grid_height(),
+				_map.get_cell_size_value()
+			])
+			_build_waypoint_graph(false)
+			return
+
+	_map = bake_map(bodies_array, map_bounds, cell_size)
 
 	_build_time_ms = Time.get_ticks_msec() - start_time
 	_is_built = true
@@ -55,6 +80,45 @@ func build_map(island_bodies: Array[StaticBody3D], map_bounds: Rect2, cell_size:
 
 	_build_waypoint_graph()
 
+	if cache_name != "":
+		NavigationCache.save_cache(cache_path(USER_CACHE_DIR, cache_name), cache_key, _map, _hpa_graph)
+
+
+## Build a NavigationMap from island collision shapes without touching the shared state.
+## Used by build_map() and the offline cache prebake.
+static func bake_map(bodies: Array[Node3D], map_bounds: Rect2, cell_size: float) -> NavigationMap:
+	var map := NavigationMap.new()
+	map.set_bounds(
+		map_bounds.position.x,
+		map_bounds.position.y,
+		map_bounds.end.x,
+		map_bounds.end.y
+	)
+	map.set_cell_size(cell_size)
+	map.build_from_collision_shapes(bodies)
+	return map
+
+
+## Build the HpaGraph the manager would build for map (same clearance and cluster size).
+static func bake_hpa_graph(map: NavigationMap) -> HpaGraph:
+	var hpa := HpaGraph.new()
+	hpa.build(map, DEFAULT_MIN_SHIP_RADIUS)
+	return hpa
+
+
+## Path of the cache file for cache_name in dir.
+static func cache_path(dir: String, cache_name: String) -> String:
+	return "%s/%s.navcache" % [dir, cache_name]
+
+
+## Try the prebaked cache, then the user cache.  Returns { map, hpa } or {} on a miss.
+func _load_cache(cache_name: String, cache_key: int) -> Dictionary:
+	for dir in [PREBAKED_CACHE_DIR, USER_CACHE_DIR]:
+		var cached: Dictionary = NavigationCache.load_cache(cache_path(dir, cache_name), cache_key)
+		if not cached.is_empty():
+			return cached
+	return {}
+
 
 ## Build the navigation map using downward raycasts through the physics engine.
 ## Simpler than collision-shape parsing: casts a vertical ray per grid cell from just
@@ -103,7 +167,8 @@ func build_map_raycast(island_bodies: Array[StaticBody3D], map_bounds: Rect2,
 	_build_waypoint_graph()
 
 ## Build the shared WaypointGraph and HpaGraph from the NavigationMap (called internally after map build).
-func _build_waypoint_graph() -> void:
+## build_hpa: false when the HpaGraph was already restored from a NavigationCache.
+func _build_waypoint_graph(build_hpa: bool = true) -> void:
 	if _map == null or not _map.is_built():
 		return
 
@@ -118,16 +183,33 @@ func _build_waypoint_graph() -> void:
 		_waypoint_graph.get_edge_count()
 	])
 
-	start_time = Time.get_ticks_msec()
-	_hpa_graph = HpaGraph.new()
-	_hpa_graph.build(_map, DEFAULT_MIN_SHIP_RADIUS)
-	elapsed = Time.get_ticks_msec() - start_time
+	if build_hpa:
+		start_time = Time.get_ticks_msec()
+		_hpa_graph = bake_hpa_graph(_map)
+		elapsed = Time.get_ticks_msec() - start_time
 
-	print("[NavigationMapManager] HpaGraph built in %.1f ms — %d nodes across %d clusters" % [
-		elapsed,
-		_hpa_graph.get_node_count(),
-		_hpa_graph.get_cluster_count()
-	])
+		print("[NavigationMapManager] HpaGraph built in %.1f ms — %d nodes across %d clusters" % [
+			elapsed,
+			_hpa_graph.get_node_count(),
+			_hpa_graph.get_cluster_count()
+		])
+
+	_start_path_planner()
+
+## (Re)start the shared PathPlanner on the current HpaGraph.
+func _start_path_planner() -> void:
+	if _hpa_graph == null:
+		return
+	if _path_planner == null:
+		_path_planner = PathPlanner.new()
+	_path_planner.set_hpa_graph(_hpa_graph)
+	_path_planner.start()
+
+## Apply the path requests the planner workers finished for this frame.
+## Autoloads run before the scene, so results land before the bots update.
+func _physics_process(_delta: float) -> void:
+	if _path_planner != null:
+		_path_planner.dispatch()
 
 ## Returns the shared NavigationMap instance, or null if not yet built.
 func get_map() -> NavigationMap:
@@ -141,6 +223,10 @@ func get_waypoint_graph() -> WaypointGraph:
 func get_hpa_graph() -> HpaGraph:
 	return _hpa_graph
 
+## Returns the shared PathPlanner (off-main-thread HPA* queries), or null if not yet built.
+func get_path_planner() -> PathPlanner:
+	return _path_planner
+
 ## Returns true if the map has been built and is ready for use.
 func is_map_ready() -> bool:
 	return _is_built and _map != null and _map.is_built()
@@ -202,6 +288,21 @@ func find_path(from: Vector3, to: Vector3, clearance: float) -> PackedVector2Arr
 		return PackedVector2Array([Vector2(from.x, from.z), Vector2(to.x, to.z)])
 	return _map.find_path(Vector2(from.x, from.z), Vector2(to.x, to.z), clearance)
 
+## Estimate travel distance from a world position to each candidate point in one search.
+## Use this to rank cover / capture / flanking candidates instead of a find_path per candidate.
+## targets: candidate positions in XZ space
+## Returns a PackedFloat32Array parallel to targets; -1.0 marks an unreachable candidate.
+## Without an HpaGraph, falls back to straight-line distances.
+func estimate_path_costs(from: Vector3, targets: PackedVector2Array, clearance: float) -> PackedFloat32Array:
+	var from_xz := Vector2(from.x, from.z)
+	if _hpa_graph == null:
+		var costs := PackedFloat32Array()
+		costs.resize(targets.size())
+		for i in targets.size():
+			costs[i] = from_xz.distance_to(targets[i])
+		return costs
+	return _hpa_graph.estimate_path_costs(from_xz, targets, clearance)
+
 
 ## Return a safe navigation point given a candidate destination.
 ## If the candidate is inside land or dangerously close to a coastline, the point
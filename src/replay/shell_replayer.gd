@@ -194,6 +194,8 @@ func on_shell_hit(ev: Dictionary) -> void:
 ## the SHELL_HIT event stream.  No fallback effects are emitted here.
 ## Called every frame by ReplayPlayback._process().
 func update_shells(current_time: float) -> void:
+	var slot_ids := PackedInt32Array()
+	var slot_positions := PackedVector3Array()
 	for shell_id in _active_shells:
 		var shell_entry: Dictionary = _active_shells[shell_id]
 		var event:  Dictionary = shell_entry.event
@@ -215,8 +217,9 @@ func update_shells(current_time: float) -> void:
 		var t_real: float = current_time - fire_ts
 		var pos: Vector3  = ReplayBallistics.position_at(muzzle, vel, params, t_real)
 
-		if slot_id >= 0 and _gpu_renderer != null:
-			_gpu_renderer.update_shell_position(slot_id, pos)
+		if slot_id >= 0:
+			slot_ids.append(slot_id)
+			slot_positions.append(pos)
 
 		# ---------- trail emitter ----------
 		if not is_seeking and is_instance_valid(UnifiedParticleSystem) and _trail_template_id >= 0:
@@ -235,6 +238,9 @@ func update_shells(current_time: float) -> void:
 			if emitter_id >= 0:
 				UnifiedParticleSystem.update_emitter_position(emitter_id, pos)
 
+	if _gpu_renderer != null and not slot_ids.is_empty():
+		_gpu_renderer.update_shell_positions(slot_ids, slot_positions)
+
 
 ## Immediately destroy every active shell visual and trail emitter.
 ## Called by ReplayPlayback on seek or scene teardown.
@@ -104,7 +104,8 @@ func _ready():
 	game_world = preload("res://src/Maps/game_world.tscn").instantiate()
 	add_child(game_world)
 	spawn_point = game_world.get_child(1)
-	map = load("res://src/Maps/map.tscn").instantiate()
+	var map_scene_path := "res://src/Maps/map.tscn"
+	map = load(map_scene_path).instantiate()
 	game_world.get_node("Env").add_child(map)
 	print("Game server started and world loaded")
 
@@ -112,7 +113,9 @@ func _ready():
 	if map.islands.size() > 0:
 		NavigationMapManager.build_map(
 			map.islands,
-			Rect2(-17500, -17500, 35000, 35000)
+			Rect2(-17500, -17500, 35000, 35000),
+			50.0,
+			map_scene_path.get_file().get_basename()
 		)
 	else:
 		push_warning("Server: No islands found on map — NavigationMap not built")
@@ -201,6 +201,7 @@ func _ready() -> void:
 	var hpa_graph = NavigationMapManager.get_hpa_graph()
 	if hpa_graph != null:
 		navigator.set_hpa_graph(hpa_graph)
+		navigator.set_path_planner(NavigationMapManager.get_path_planner())
 	else:
 		push_warning("[BotControllerV4] HpaGraph not yet built — navigator will fall back to straight-line paths")
 
@@ -235,6 +236,7 @@ func _deferred_init() -> void:
 		var hpa_graph = NavigationMapManager.get_hpa_graph()
 		if hpa_graph != null:
 			navigator.set_hpa_graph(hpa_graph)
+			navigator.set_path_planner(NavigationMapManager.get_path_planner())
 
 	# Pass bot_id to navigator for staggered periodic replanning
 	if navigator != null:
@@ -20,6 +20,10 @@ func set_hpa_graph(hpa_graph: Variant) -> void:
 	_impl.set_hpa_graph(hpa_graph)
 
 
+func set_path_planner(planner: Variant) -> void:
+	_impl.set_path_planner(planner)
+
+
 func set_ship_params(
 	turning_circle_radius: float,
 	rudder_response_time: float,
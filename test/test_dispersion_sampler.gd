@@ -0,0 +1,130 @@
+extends Node
+
+## Statistical test for the native DispersionSampler (ships_core).
+## Histograms a large sample_offsets() draw against the truncated-normal CDF
+## and checks that the citadel guarantee fires on schedule.
+
+const SAMPLES := 300000
+const BINS := 20
+const SIGMAS := [1.0, 1.8, 2.5]
+
+func _ready():
+	var ok := true
+	ok = test_offset_histogram() and ok
+	ok = test_citadel_guarantee() and ok
+	if ok:
+		print("\n✅ All DispersionSampler tests passed")
+	else:
+		print("\n❌ DispersionSampler tests FAILED")
+
+# CDF of N(0, 1/sigma²) truncated to [-1, 1], as sampled by generate_axis
+func truncated_cdf(x: float, sigma: float) -> float:
+	var erf_bound = DispersionSampler.erf(sigma / sqrt(2.0))
+	return 0.5 + 0.5 * DispersionSampler.erf(x * sigma / sqrt(2.0)) / erf_bound
+
+func test_offset_histogram() -> bool:
+	print("=== DispersionSampler Offset Histogram ===")
+	var ok := true
+	for sigma in SIGMAS:
+		var sampler = DispersionSampler.new()
+		sampler.set_seed(12345)
+		# The guarantee pulls shells inward; test the raw distribution
+		sampler.set_citadel_guarantee_enabled(false)
+		var offsets: PackedVector2Array = sampler.sample_offsets(SAMPLES, sigma)
+
+		var h_bins := PackedInt32Array()
+		var v_bins := PackedInt32Array()
+		h_bins.resize(BINS)
+		v_bins.resize(BINS)
+		var out_of_range := 0
+		for o in offsets:
+			if absf(o.x) > 1.0 or absf(o.y) > 1.0:
+				out_of_range += 1
+				continue
+			h_bins[mini(int((o.x + 1.0) * 0.5 * BINS), BINS - 1)] += 1
+			v_bins[mini(int((o.y + 1.0) * 0.5 * BINS), BINS - 1)] += 1
+
+		# Largest bin error, in binomial standard deviations, and the
+		# largest CDF gap at the bin edges (Kolmogorov-Smirnov style)
+		var worst_z := 0.0
+		var worst_cdf := 0.0
+		for axis in [h_bins, v_bins]:
+			var cumulative := 0.0
+			for b in range(BINS):
+				var x0 = -1.0 + 2.0 * b / BINS
+				var x1 = -1.0 + 2.0 * (b + 1) / BINS
+				var p = truncated_cdf(x1, sigma) - truncated_cdf(x0, sigma)
+				var observed = float(axis[b]) / SAMPLES
+				worst_z = maxf(worst_z, absf(observed - p) / sqrt(p * (1.0 - p) / SAMPLES))
+				cumulative += observed
+				worst_cdf = maxf(worst_cdf, absf(cumulative - truncated_cdf(x1, sigma)))
+
+		# Stratified draws sit closer to the CDF than independent ones, so
+		# these bounds are loose for a correct sampler
+		var passed = out_of_range == 0 and worst_z < 5.0 and worst_cdf < 0.005
+		if passed:
+			print("✓ sigma %.1f: worst bin %.2f sd, worst CDF gap %.5f" % [sigma, worst_z, worst_cdf])
+		else:
+			print("✗ sigma %.1f: worst bin %.2f sd, worst CDF gap %.5f, %d out of range" % [
+				sigma, worst_z, worst_cdf, out_of_range])
+			ok = false
+	return ok
+
+func test_citadel_guarantee() -> bool:
+	print("\n=== DispersionSampler Citadel Guarantee ===")
+	var h_frac := 0.5
+	var v_frac := 0.1
+	var shells := DispersionSampler.SHELL_COUNT
+	var salvos := 20000
+
+	var guaranteed_hits := 0
+	var guaranteed_salvos := 0
+	var missed := 0
+	var free_hits := 0
+	for enabled in [true, false]:
+		var sampler = DispersionSampler.new()
+		sampler.set_seed(777)
+		sampler.set_citadel_fractions(h_frac, v_frac)
+		sampler.set_citadel_guarantee_enabled(enabled)
+		var offsets: PackedVector2Array = sampler.sample_offsets(salvos * shells, 1.8)
+
+		# Mirror new_salvo's counter: every CITADEL_GUARANTEE_NUM shells
+		# one salvo must put a shell inside the citadel ellipse
+		var counter := 0
+		for s in range(salvos):
+			var inside := false
+			for i in range(shells):
+				var o = offsets[s * shells + i]
+				if (o.x * o.x) / (h_frac * h_frac) + (o.y * o.y) / (v_frac * v_frac) <= 1.0:
+					inside = true
+			counter += shells
+			var due = counter >= DispersionSampler.CITADEL_GUARANTEE_NUM
+			if due:
+				counter -= DispersionSampler.CITADEL_GUARANTEE_NUM
+			if enabled:
+				if due:
+					guaranteed_salvos += 1
+					if inside:
+						guaranteed_hits += 1
+					else:
+						missed += 1
+			elif inside:
+				free_hits += 1
+
+	var expected_due := floori(float(salvos * shells) / DispersionSampler.CITADEL_GUARANTEE_NUM)
+	var ok := true
+	if missed == 0 and absi(guaranteed_salvos - expected_due) <= 1:
+		print("✓ %d/%d due salvos put a shell in the citadel" % [guaranteed_hits, guaranteed_salvos])
+	else:
+		print("✗ %d of %d due salvos missed the citadel (expected %d due)" % [
+			missed, guaranteed_salvos, expected_due])
+		ok = false
+
+	# Without the guarantee a noticeable share of salvos must miss, or the
+	# check above proves nothing
+	if free_hits < salvos:
+		print("✓ without the guarantee %d/%d salvos hit the citadel" % [free_hits, salvos])
+	else:
+		print("✗ every salvo hit the citadel without the guarantee")
+		ok = false
+	return ok